@@ -1,9 +1,11 @@
 #pragma once
 
 #include "strikeengine/atmosphere/AtmosphereModel.hpp"
+#include "strikeengine/atmosphere/CompactAtmosphereTable.hpp"
 #include "strikeengine/components/sensors/InfraredSeekerComponent.hpp"
+#include "strikeengine/core/MappedFile.hpp"
+#include <span>
 #include <string>
-#include <vector>
 
 namespace StrikeEngine {
     /**
@@ -12,6 +14,14 @@ namespace StrikeEngine {
      * This class loads a pre-calculated binary table of atmospheric properties
      * and provides an efficient, interpolating lookup function to retrieve
      * data for any given altitude.
+     *
+     * The table file (see AtmosphereTable.hpp) is mapped read-only and its rows are read in
+     * place, so simulation processes on one host share a single copy in the page cache.
+     * When the table rows are evenly spaced in altitude (GenerateAtmosphereTable writes one
+     * row per metre), lookups index the row directly instead of searching for it.
+     *
+     * Loading also builds a CompactAtmosphereTable from the full table for hot per-entity
+     * lookups that can trade a few parts per million of accuracy for staying in cache.
      */
     class AtmosphereManager {
     public:
@@ -20,7 +30,8 @@ namespace StrikeEngine {
         /**
          * @brief Loads the atmospheric data from a binary file.
          * @param filepath The path to the 'atmosphere_table.bin' file.
-         * @return True if loading was successful, false otherwise.
+         * @return True if loading was successful, false if the file could not be opened.
+         * @throws std::runtime_error If the file is not a valid table for this build.
          */
         bool loadTable(const std::string& filepath);
 
@@ -31,6 +42,14 @@ namespace StrikeEngine {
          */
         [[nodiscard]] AtmosphereProperties getProperties(double altitude) const;
 
+        /**
+         * @brief Batched getProperties: out[i] receives the properties at altitudes[i].
+         * On an evenly spaced table the interpolation runs several altitudes per SIMD instruction.
+         * @param altitudes The altitudes in meters.
+         * @param out The results; must be at least as long as altitudes.
+         */
+        void getProperties(std::span<const double> altitudes, std::span<AtmosphereProperties> out) const;
+
         /**
          * @brief Gets the atmospheric transmissivity for a given path.
          * @param range_m The length of the path through the atmosphere.
@@ -46,8 +65,25 @@ namespace StrikeEngine {
          */
         [[nodiscard]] bool isLoaded() const;
 
+        /**
+         * @brief The float32 copy of the loaded table, for cache-friendly lookups.
+         */
+        [[nodiscard]] const CompactAtmosphereTable& compactTable() const { return _compact; }
+
+        /**
+         * @brief Whether the loaded table is evenly spaced, so lookups index it directly.
+         */
+        [[nodiscard]] bool isUniform() const { return _uniform; }
+
     private:
-        std::vector<AtmosphereProperties> _table;
+        MappedFile _file;
+        std::span<const AtmosphereProperties> _table; // The rows, inside _file
+
+        CompactAtmosphereTable _compact;
+
+        // Evenly spaced tables: row i is at _table.front().altitude + i / _inverse_spacing.
+        bool _uniform = false;
+        double _inverse_spacing = 0.0;
         // Future: Add data structures to hold transmissivity lookup tables.
     };
 } // namespace StrikeEngine
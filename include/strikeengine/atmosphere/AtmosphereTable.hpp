@@ -0,0 +1,75 @@
+#pragma once
+
+#include "strikeengine/atmosphere/AtmosphereModel.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace StrikeEngine {
+
+    /** @brief The first eight bytes of every atmosphere table file. */
+    inline constexpr char ATMOSPHERE_TABLE_MAGIC[8] = {'S', 'E', 'A', 'T', 'M', 'T', 'B', 'L'};
+
+    /** @brief The format version this build reads and writes. */
+    inline constexpr uint32_t ATMOSPHERE_TABLE_VERSION = 1;
+
+    /**
+     * @brief The names and types of the AtmosphereProperties fields, in declaration order.
+     * Any change to AtmosphereProperties must change this string, so older tables are rejected
+     * instead of being read with the wrong layout.
+     */
+    inline constexpr char ATMOSPHERE_TABLE_FIELDS[] =
+        "altitude:f64,temperature:f64,pressure:f64,density:f64,speedOfSound:f64";
+
+    /**
+     * @brief The header at the start of an atmosphere table file.
+     *
+     * The header is followed directly by row_count AtmosphereProperties rows in ascending
+     * altitude, so a mapped file can be read in place. All fields are in host byte order; a
+     * file from a host of the other byte order fails the version check.
+     */
+    struct AtmosphereTableHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t header_size;    // Offset of the first row
+        uint32_t row_size;       // sizeof(AtmosphereProperties)
+        uint32_t field_count;
+        uint64_t row_count;
+        double base_altitude_m;  // Altitude of the first row
+        double spacing_m;        // Altitude step between rows; 0 when they are not evenly spaced
+        char fields[128];        // ATMOSPHERE_TABLE_FIELDS, zero padded
+        uint64_t checksum;       // atmosphereTableChecksum of the rows
+    };
+
+    static_assert(sizeof(AtmosphereTableHeader) % alignof(AtmosphereProperties) == 0,
+                  "Rows must stay aligned when the table is read in place");
+    static_assert(sizeof(ATMOSPHERE_TABLE_FIELDS) <= sizeof(AtmosphereTableHeader::fields));
+
+    /**
+     * @brief The 64-bit FNV-1a hash of the rows, taken over their 8-byte words.
+     */
+    uint64_t atmosphereTableChecksum(std::span<const AtmosphereProperties> rows);
+
+    /**
+     * @brief Builds the header for a table, detecting whether its rows are evenly spaced.
+     * @throws std::runtime_error If the table is empty or its altitudes do not strictly ascend.
+     */
+    AtmosphereTableHeader makeAtmosphereTableHeader(std::span<const AtmosphereProperties> rows);
+
+    /**
+     * @brief Writes a table file: the header followed by the rows.
+     * @throws std::runtime_error If the rows are not a valid table or the file cannot be written.
+     */
+    void writeAtmosphereTable(const std::string& filepath, std::span<const AtmosphereProperties> rows);
+
+    /**
+     * @brief Validates the contents of a table file and returns its rows, in place.
+     * @param bytes The whole file, aligned for AtmosphereProperties (as a mapping is).
+     * @param header Receives the header.
+     * @throws std::runtime_error If the magic, version, field layout, size or checksum is wrong.
+     */
+    std::span<const AtmosphereProperties> readAtmosphereTable(std::span<const std::byte> bytes,
+                                                              AtmosphereTableHeader& header);
+
+} // namespace StrikeEngine
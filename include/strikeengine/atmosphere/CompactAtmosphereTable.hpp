@@ -0,0 +1,96 @@
+#pragma once
+
+#include "strikeengine/atmosphere/AtmosphereModel.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace StrikeEngine {
+
+    /**
+     * @brief One altitude band of a CompactAtmosphereTable: rows every spacing_m metres up to top_altitude_m.
+     */
+    struct AtmosphereBand {
+        double top_altitude_m;
+        double spacing_m;
+    };
+
+    /**
+     * @brief The default bands: 10 m rows through the troposphere and lower stratosphere, where
+     * vehicles spend most of their time and properties change fastest, and 50 m rows above 20 km.
+     */
+    inline constexpr AtmosphereBand DEFAULT_ATMOSPHERE_BANDS[] = {
+        {20000.0, 10.0},
+        {1.0e9, 50.0}
+    };
+
+    /**
+     * @brief A compact, lower-precision copy of the atmosphere table for hot per-entity lookups.
+     *
+     * The full table holds five doubles per metre (3.4 MB), so lookups at scattered altitudes
+     * miss the cache on nearly every call. This copy stores the four properties as float32,
+     * keeps altitude implicit in the row index, and samples each band only as finely as the
+     * band asks for. With the default bands it is about 53 KB and stays in L2.
+     *
+     * Lookups interpolate linearly between rows in double precision. With the default bands the
+     * relative error against calculateAtmosphere is below 1e-6 under 20 km and about 1e-5 above;
+     * callers that need the full table use AtmosphereManager::getProperties.
+     */
+    class CompactAtmosphereTable {
+    public:
+        CompactAtmosphereTable() = default;
+
+        /**
+         * @brief Samples a source at the band rows.
+         * @param source Returns the properties at an altitude, e.g. AtmosphereManager::getProperties.
+         * @param baseAltitude The altitude of the first row (m).
+         * @param topAltitude The altitude of the last row (m); bands above it are dropped and the
+         * last band is cut to end here.
+         * @param bands The bands in ascending altitude. Each band's spacing is shrunk slightly, if
+         * needed, so a whole number of rows spans it.
+         * @throws std::runtime_error If the range is empty or a band spacing is not positive.
+         */
+        CompactAtmosphereTable(const std::function<AtmosphereProperties(double)>& source, double baseAltitude,
+                               double topAltitude, std::span<const AtmosphereBand> bands = DEFAULT_ATMOSPHERE_BANDS);
+
+        /**
+         * @brief Retrieves interpolated properties, clamped to the table's altitude range.
+         * A NaN altitude reads the base of the range.
+         */
+        [[nodiscard]] AtmosphereProperties getProperties(double altitude) const;
+
+        /**
+         * @brief Batched getProperties: out[i] receives the properties at altitudes[i].
+         * @param out The results; must be at least as long as altitudes.
+         */
+        void getProperties(std::span<const double> altitudes, std::span<AtmosphereProperties> out) const;
+
+        [[nodiscard]] bool empty() const { return _rows.empty(); }
+
+        /** @brief The bytes of row data, the part lookups touch. */
+        [[nodiscard]] size_t sizeBytes() const { return _rows.size() * sizeof(Row); }
+
+    private:
+        struct Row {
+            float temperature;
+            float pressure;
+            float density;
+            float speedOfSound;
+        };
+        static_assert(sizeof(Row) == 16);
+
+        struct Band {
+            double base_altitude_m;
+            double top_altitude_m;
+            double inverse_spacing;
+            uint32_t first_row;
+            uint32_t row_count; // Both ends included, so at least two
+        };
+
+        std::vector<Row> _rows;
+        std::vector<Band> _bands;
+    };
+
+} // namespace StrikeEngine
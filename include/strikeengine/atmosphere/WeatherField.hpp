@@ -0,0 +1,203 @@
+#pragma once
+
+#include "strikeengine/core/MappedFile.hpp"
+#include <glm/glm.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <unordered_map>
+
+namespace StrikeEngine {
+
+    /** @brief The first eight bytes of every weather field file. */
+    inline constexpr char WEATHER_FIELD_MAGIC[8] = {'S', 'E', 'W', 'X', 'F', 'L', 'D', '\0'};
+
+    /** @brief The format version this build reads and writes. */
+    inline constexpr uint32_t WEATHER_FIELD_VERSION = 1;
+
+    /** @brief The names and types of the WeatherPoint fields, in declaration order. */
+    inline constexpr char WEATHER_FIELD_FIELDS[] =
+        "wind_east:f32,wind_north:f32,wind_up:f32,temperature:f32,density:f32";
+
+    /** @brief Tiles start on multiples of this many bytes, so each can be paged on its own. */
+    inline constexpr uint64_t WEATHER_TILE_ALIGNMENT = 4096;
+
+    /**
+     * @brief The weather at one grid point, as stored in the file.
+     */
+    struct WeatherPoint {
+        float wind_east_mps;
+        float wind_north_mps;
+        float wind_up_mps;
+        float temperature_K;
+        float density_kgpm3;
+    };
+
+    /**
+     * @brief One axis of the weather grid: points at origin + i * spacing, i < points.
+     *
+     * The grid is cut into tiles of tile_points points along the axis. Neighbouring tiles share
+     * their boundary point, so every grid cell lies wholly inside one tile.
+     */
+    struct WeatherAxis {
+        double origin;
+        double spacing;
+        uint32_t points;      // At least 2
+        uint32_t tile_points; // At least 2
+    };
+
+    /**
+     * @brief The 4-D grid of a weather field.
+     *
+     * Latitude and longitude are geocentric, in degrees, on a sphere of earth_radius_m in the
+     * simulation frame: Y is the polar axis (as in GravityModel) and longitude 0 lies on +X,
+     * increasing eastwards towards -Z. Altitude is in metres above that sphere and time in
+     * seconds from the start of the simulation. A global grid repeats its first longitude
+     * 360 degrees on, so the cells close around the globe.
+     */
+    struct WeatherGrid {
+        static constexpr size_t LATITUDE = 0;
+        static constexpr size_t LONGITUDE = 1;
+        static constexpr size_t ALTITUDE = 2;
+        static constexpr size_t TIME = 3;
+        static constexpr size_t AXES = 4;
+
+        WeatherAxis axes[AXES];
+        double earth_radius_m = 6378137.0;
+    };
+
+    /**
+     * @brief The header at the start of a weather field file.
+     *
+     * The tiles follow from data_offset, each tile_size bytes, ordered by time, altitude,
+     * latitude and longitude tile index (longitude fastest). Inside a tile the points are
+     * ordered the same way. There is no checksum: verifying one would read every tile of a
+     * multi-gigabyte file, which is what the tiling avoids.
+     */
+    struct WeatherFieldHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t header_size;
+        uint32_t point_size;  // sizeof(WeatherPoint)
+        uint32_t field_count;
+        WeatherGrid grid;
+        uint32_t tiles[WeatherGrid::AXES]; // Tile count along each axis
+        uint64_t tile_size;   // Bytes per tile, padded to WEATHER_TILE_ALIGNMENT
+        uint64_t data_offset; // Offset of the first tile
+        char fields[128];     // WEATHER_FIELD_FIELDS, zero padded
+    };
+
+    /**
+     * @brief The weather at a position: the wind in the simulation frame and the air state.
+     */
+    struct WeatherSample {
+        glm::dvec3 wind_mps;
+        double temperature_K;
+        double density_kgpm3;
+
+        /** @brief The speed of sound at temperature_K, with the constants calculateAtmosphere uses. */
+        [[nodiscard]] double speedOfSound() const { return std::sqrt(1.4 * 287.05 * temperature_K); }
+    };
+
+    /**
+     * @brief Returns the weather at a grid point: latitude (deg), longitude (deg), altitude (m), time (s).
+     */
+    using WeatherSource = std::function<WeatherPoint(double, double, double, double)>;
+
+    /**
+     * @brief Writes a weather field file one tile at a time, so grids larger than memory can be written.
+     * @throws std::runtime_error If the grid is invalid or the file cannot be written.
+     */
+    void writeWeatherField(const std::string& filepath, const WeatherGrid& grid, const WeatherSource& source);
+
+    /**
+     * @brief A gridded 4-D wind, temperature and density field, read from a tiled file in place.
+     *
+     * The file is mapped read-only, so a multi-gigabyte grid costs address space only: the OS
+     * reads a tile in when it is first touched, and processes on one host share the pages.
+     * prefetch() asks for the tiles under the entities ahead of a frame's lookups and hands back
+     * tiles no entity has needed for longest once more than the resident budget are held.
+     *
+     * A lookup is O(1): the cell is found by index arithmetic, and the 16 corner points of its
+     * space-time cell all lie in one tile. Values are interpolated trilinearly in space and
+     * linearly in time. Positions and times outside the grid take the value at its edge.
+     *
+     * Lookups are const and may run concurrently; prefetch() may not run alongside them.
+     */
+    class WeatherField {
+    public:
+        WeatherField() = default;
+
+        /**
+         * @brief Maps a weather field file.
+         * @param filepath The file written by writeWeatherField.
+         * @param maxResidentTiles The number of tiles prefetch() keeps paged in.
+         * @return True if the field was mapped, false if the file could not be opened.
+         * @throws std::runtime_error If the file is not a valid weather field for this build.
+         */
+        bool open(const std::string& filepath, size_t maxResidentTiles = 256);
+
+        [[nodiscard]] bool isLoaded() const { return _tiles != nullptr; }
+
+        /**
+         * @brief Pages in the tiles under the given positions at time_s and evicts the least
+         * recently needed tiles beyond the resident budget. Tiles needed by this call are never
+         * evicted by it, so the resident set is bounded by the larger of the budget and this
+         * call's working set.
+         */
+        void prefetch(std::span<const glm::dvec3> positions, double time_s);
+
+        /**
+         * @brief The weather at a position (simulation frame, m) and time (s).
+         */
+        [[nodiscard]] WeatherSample sample(const glm::dvec3& position, double time_s) const;
+
+        /**
+         * @brief Batched sample: out[i] receives the weather at positions[i], all at time_s.
+         * @param out The results; must be at least as long as positions.
+         */
+        void sample(std::span<const glm::dvec3> positions, double time_s, std::span<WeatherSample> out) const;
+
+        [[nodiscard]] const WeatherGrid& grid() const { return _header.grid; }
+
+        /** @brief The number of tiles in the file. */
+        [[nodiscard]] size_t tileCount() const { return _tile_count; }
+
+        /** @brief The number of tiles prefetch() currently holds paged in. */
+        [[nodiscard]] size_t residentTiles() const { return _resident.size(); }
+
+    private:
+        // Where a coordinate falls along one axis: the tile, the cell inside it and the fraction.
+        struct AxisCell {
+            uint32_t tile;
+            uint32_t local;
+            double fraction;
+        };
+
+        struct Location {
+            AxisCell cells[WeatherGrid::AXES];
+            glm::dvec3 east;
+            glm::dvec3 north;
+            glm::dvec3 up;
+        };
+
+        [[nodiscard]] AxisCell locate(size_t axis, double value) const;
+        [[nodiscard]] Location locate(const glm::dvec3& position, const AxisCell& time) const;
+        [[nodiscard]] size_t tileIndex(const Location& location) const;
+        [[nodiscard]] WeatherSample interpolate(const Location& location) const;
+
+        MappedFile _file;
+        WeatherFieldHeader _header{};
+        const std::byte* _tiles = nullptr;
+        size_t _tile_count = 0;
+
+        // prefetch(): resident tile -> the prefetch call that last needed it.
+        size_t _max_resident_tiles = 0;
+        uint64_t _prefetch_count = 0;
+        std::unordered_map<size_t, uint64_t> _resident;
+    };
+
+} // namespace StrikeEngine
@@ -1,13 +1,11 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
-
 namespace StrikeEngine {
 
     /**
      * @brief Stores the physical hardware parameters of a radar antenna and receiver.
      */
-    struct AntennaComponent final : public Component {
+    struct AntennaComponent final {
         /**
          * @brief The power of the radar's transmitter, in Watts.
          */
@@ -1,6 +1,5 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
 #include <glm/glm.hpp>
 
 namespace StrikeEngine {
@@ -13,7 +12,7 @@ namespace StrikeEngine {
      * acceleration vector into this component, and the ControlSystem reads it
      * to determine how to deflect the control surfaces.
      */
-    struct AutopilotCommandComponent final : public Component {
+    struct AutopilotCommandComponent final {
         /**
          * @brief The commanded acceleration vector in the world frame, measured in G's.
          * For example, a value of (0, 20, 0) would command a 20g pull "up".
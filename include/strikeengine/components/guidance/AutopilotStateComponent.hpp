@@ -1,6 +1,5 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
 #include <vector>
 
 namespace StrikeEngine {
@@ -21,7 +20,7 @@ namespace StrikeEngine {
     /**
      * @brief Stores the internal state and gains for the autopilot's PID controllers.
      */
-    struct AutopilotStateComponent final : public Component {
+    struct AutopilotStateComponent final {
         // --- PID Controller Gain Schedules (Tuning Parameters) ---
         GainSchedule kp_schedule;
         GainSchedule ki_schedule;
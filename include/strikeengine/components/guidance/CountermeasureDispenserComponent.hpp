@@ -1,13 +1,11 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
-
 namespace StrikeEngine {
 
     /**
      * @brief Manages the inventory of deployable countermeasures.
      */
-    struct CountermeasureDispenserComponent final : public Component {
+    struct CountermeasureDispenserComponent final {
         /**
          * @brief The number of available chaff canisters.
          * Each canister creates a single radar-decoying chaff cloud when deployed.
@@ -1,6 +1,5 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
 #include <string>
 
 namespace StrikeEngine {
@@ -8,7 +7,7 @@ namespace StrikeEngine {
     /**
      * @brief Defines the trigger logic for a warhead.
      */
-    struct FuzeComponent final : public Component {
+    struct FuzeComponent final {
         /**
          * @brief A string identifier for the fuze type.
          * Examples: "proximity_radar", "proximity_laser", "impact"
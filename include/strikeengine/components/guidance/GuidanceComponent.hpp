@@ -1,6 +1,5 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
 #include "strikeengine/ecs/Entity.hpp"
 namespace StrikeEngine {
     enum class GuidanceLaw {
@@ -16,7 +15,7 @@ namespace StrikeEngine {
      * the necessary parameters, such as its current target and the specific
      * guidance law to be used.
      */
-    struct GuidanceComponent final : public Component {
+    struct GuidanceComponent final {
         /** @brief The unique ID of the entity this component is trying to intercept. */
         Entity targetEntity = NULL_ENTITY;
 
@@ -1,13 +1,11 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
-
 namespace StrikeEngine {
 
     /**
      * @brief Models an electronic noise jammer.
      */
-    struct JammerComponent final : public Component {
+    struct JammerComponent final {
         /**
          * @brief The effective radiated power (ERP) of the jammer, in Watts.
          * This combines the transmitter power and the antenna gain of the jammer.
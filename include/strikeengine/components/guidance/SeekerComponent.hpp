@@ -1,6 +1,5 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
 #include "strikeengine/ecs/Entity.hpp"
 #include <string>
 
@@ -23,7 +22,7 @@ namespace StrikeEngine {
 	/**
 	 * @brief Defines the properties and state of an onboard seeker/sensor.
 	 */
-	struct SeekerComponent final : public Component {
+	struct SeekerComponent final {
 		// --- Properties (Loaded from profile) ---
 		std::string type ; // e.g., "RF" (Radio Frequency), "IR" (Infrared)
 		double field_of_view_deg = 10.0;
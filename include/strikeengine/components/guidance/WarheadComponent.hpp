@@ -1,6 +1,5 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
 #include <string>
 
 namespace StrikeEngine {
@@ -8,7 +7,7 @@ namespace StrikeEngine {
     /**
      * @brief Models the lethal payload of a missile.
      */
-    struct WarheadComponent final : public Component {
+    struct WarheadComponent final {
         /**
          * @brief A string identifier for the warhead type.
          * Examples: "blast_fragmentation", "continuous_rod", "shaped_charge"
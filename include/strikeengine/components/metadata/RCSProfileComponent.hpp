@@ -1,19 +1,39 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
 #include <string>
 
 namespace StrikeEngine {
 
+    class RCSDatabase;
+
     /**
      * @brief Links an entity to its high-fidelity, aspect-dependent RCS database.
      */
-    struct RCSProfileComponent final : public Component {
+    struct RCSProfileComponent final {
         /**
          * @brief The file path to the JSON or binary file containing the RCS data.
          * Example: "data/rcs/f22_raptor.json"
          */
         std::string profile_path;
+
+        /**
+         * @brief The loaded database of profile_path, resolved through the ProfileRegistry when the
+         * component is added to a Registry (see onAdd); null if it has not been resolved or
+         * failed to load.
+         */
+        const RCSDatabase* database = nullptr;
+
+        /**
+         * @brief Whether database has been resolved. A resolved null database is a profile that
+         * failed to load; systems skip it without asking the ProfileRegistry again.
+         */
+        bool resolved = false;
     };
 
+    /**
+     * @brief Resolves the database of an RCSProfileComponent as it is added to a Registry,
+     * unless it is already resolved or names no profile. Set profile_path before adding it.
+     */
+    void onAdd(RCSProfileComponent& component);
+
 } // namespace StrikeEngine
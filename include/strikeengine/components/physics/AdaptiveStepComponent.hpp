@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+
+namespace StrikeEngine {
+
+    /**
+     * @brief Opts a rigid body into adaptive-step integration and records its step-size history.
+     *
+     * The IntegrationSystem advances bodies with this component using adaptive Dormand-Prince
+     * 5(4) instead of a single fixed RK4 step per frame. Each body sub-steps inside the frame
+     * only as finely as its own error estimate demands: a cruising missile covers a whole frame
+     * in one step, while one in the endgame may take many.
+     */
+    struct AdaptiveStepComponent final {
+        /** @brief The step size the next frame starts with (s); 0 starts with the whole frame. */
+        double step_s = 0.0;
+
+        /** @brief Sub-steps accepted in the last frame. */
+        uint32_t accepted_steps = 0;
+
+        /** @brief Sub-steps rejected by the error control and retried in the last frame. */
+        uint32_t rejected_steps = 0;
+    };
+
+} // namespace StrikeEngine
@@ -1,14 +1,15 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
 #include <string>
 
 namespace StrikeEngine {
 
+    class AerodynamicsDatabase;
+
     /**
      * @brief Defines the aerodynamic properties and current state of an entity.
      */
-    struct AerodynamicProfileComponent final : public Component {
+    struct AerodynamicProfileComponent final {
         // --- Static Properties (Loaded from Profile) ---
 
         /**
@@ -17,6 +18,19 @@ namespace StrikeEngine {
          */
         std::string profileID;
 
+        /**
+         * @brief The loaded database of profileID, resolved through the ProfileRegistry when the
+         * component is added to a Registry (see onAdd); null if it has not been resolved or
+         * failed to load.
+         */
+        const AerodynamicsDatabase* database = nullptr;
+
+        /**
+         * @brief Whether database has been resolved. A resolved null database is a profile that
+         * failed to load; systems skip it without asking the ProfileRegistry again.
+         */
+        bool resolved = false;
+
         /**
          * @brief The reference area (in m^2) used in aerodynamic force calculations.
          */
@@ -27,16 +41,21 @@ namespace StrikeEngine {
          */
         double wingspan_m = 1.0;
 
+        /**
+         * @brief The reference length (in meters) used in aerodynamic moment calculations.
+         */
+        double reference_length_m = 1.0;
+
 
         // --- State Variables (Updated by Systems each tick) ---
 
         /**
-         * @brief The current angle of attack (AoA) in radians.
+         * @brief The current angle of attack (AoA) in radians, positive with the nose above the airflow.
          */
         double current_angle_of_attack_rad = 0.0;
 
         /**
-         * @brief The current sideslip angle (Beta) in radians.
+         * @brief The current sideslip angle (Beta) in radians, positive with the airflow from the body's +X side.
          */
         double current_sideslip_angle_rad = 0.0;
 
@@ -46,4 +65,10 @@ namespace StrikeEngine {
         double current_mach_number = 0.0;
     };
 
+    /**
+     * @brief Resolves the database of an AerodynamicProfileComponent as it is added to a Registry,
+     * unless it is already resolved or names no profile. Set profileID before adding it.
+     */
+    void onAdd(AerodynamicProfileComponent& component);
+
 } // namespace StrikeEngine
@@ -1,13 +1,11 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
-
 namespace StrikeEngine {
 
     /**
      * @brief Holds the state and physical properties of an entity's control surfaces.
      */
-    struct ControlSurfaceComponent final : public Component {
+    struct ControlSurfaceComponent final {
         /**
          * @brief The maximum physical deflection angle of the control surfaces, in radians.
          * This value is typically loaded from a vehicle's JSON profile.
@@ -1,6 +1,6 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
+#include "strikeengine/ecs/SoA.hpp"
 #include <glm/glm.hpp>
 
 namespace StrikeEngine {
@@ -11,7 +11,7 @@ namespace StrikeEngine {
      * forces and torques to this component. The IntegrationSystem then reads the
      * final sum to calculate the accelerations for the frame.
      */
-    struct ForceAccumulatorComponent final : public Component {
+    struct ForceAccumulatorComponent final {
     private:
         /** @brief The vector sum of all linear forces acting on the entity's center of mass. */
         glm::dvec3 totalForce{0.0};
@@ -107,4 +107,58 @@ namespace StrikeEngine {
             totalTorque = glm::dvec3(0.0);
         }
     };
+
+    /**
+     * @brief Accumulators are stored structure-of-arrays, as six lanes: force x/y/z, then torque x/y/z.
+     */
+    template<>
+    struct SoALayout<ForceAccumulatorComponent> {
+        static constexpr size_t FORCE = 0;
+        static constexpr size_t TORQUE = 3;
+        static constexpr size_t LANES = 6;
+
+        /**
+         * @brief The ForceAccumulatorComponent accessors over one entity's lanes.
+         */
+        template<bool Const>
+        class Ref : public SoASlot<Const> {
+        public:
+            using SoASlot<Const>::SoASlot;
+
+            [[nodiscard]] glm::dvec3 getTotalForce() const noexcept { return loadVec3(FORCE); }
+            void setTotalForce(const glm::dvec3& force) const noexcept requires (!Const) { storeVec3(FORCE, force); }
+            void addForce(const glm::dvec3& force) const noexcept requires (!Const) {
+                storeVec3(FORCE, loadVec3(FORCE) + force);
+            }
+
+            [[nodiscard]] glm::dvec3 getTotalTorque() const noexcept { return loadVec3(TORQUE); }
+            void setTotalTorque(const glm::dvec3& torque) const noexcept requires (!Const) { storeVec3(TORQUE, torque); }
+            void addTorque(const glm::dvec3& torque) const noexcept requires (!Const) {
+                storeVec3(TORQUE, loadVec3(TORQUE) + torque);
+            }
+
+            void clear() const noexcept requires (!Const) {
+                storeVec3(FORCE, glm::dvec3(0.0));
+                storeVec3(TORQUE, glm::dvec3(0.0));
+            }
+
+            operator ForceAccumulatorComponent() const { return {getTotalForce(), getTotalTorque()}; }
+
+        private:
+            [[nodiscard]] glm::dvec3 loadVec3(size_t first) const noexcept {
+                return {this->lane(first), this->lane(first + 1), this->lane(first + 2)};
+            }
+
+            void storeVec3(size_t first, const glm::dvec3& value) const noexcept requires (!Const) {
+                this->lane(first) = value.x;
+                this->lane(first + 1) = value.y;
+                this->lane(first + 2) = value.z;
+            }
+        };
+
+        static void store(const Ref<false>& slot, const ForceAccumulatorComponent& accumulator) {
+            slot.setTotalForce(accumulator.getTotalForce());
+            slot.setTotalTorque(accumulator.getTotalTorque());
+        }
+    };
 } // namespace StrikeEngine
@@ -1,7 +1,5 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
-
 namespace StrikeEngine {
 
     /**
@@ -10,7 +8,7 @@ namespace StrikeEngine {
      * These parameters model the imperfections of real-world gyroscopes and
      * accelerometers, which are the primary source of navigational drift.
      */
-    struct IMUComponent final : public Component {
+    struct IMUComponent final {
         // Gyroscope Error Parameters
         double gyro_bias_drift_rate_deg_per_hr = 0.1;
         double gyro_noise_density_deg_per_sqrt_hr = 0.01;
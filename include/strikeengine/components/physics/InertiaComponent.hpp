@@ -1,6 +1,5 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
 #include <glm/glm.hpp>
 
 namespace StrikeEngine {
@@ -15,7 +14,7 @@ namespace StrikeEngine {
      * The tensor is defined in the entity's local body space. For many symmetrical
      * objects like missiles, the off-diagonal elements will be zero.
      */
-    struct InertiaComponent final : public Component {
+    struct InertiaComponent final {
     private:
         /**
          * @brief The 3x3 moment of inertia tensor in body space (kg·m²).
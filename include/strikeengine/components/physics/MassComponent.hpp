@@ -1,7 +1,5 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
-
 namespace StrikeEngine {
 
     /**
@@ -11,7 +9,7 @@ namespace StrikeEngine {
      * It tracks the initial (wet) mass, the final (dry) mass, and the current mass,
      * which allows systems like the ThrustSystem to model fuel usage realistically.
      */
-    struct MassComponent final : public Component {
+    struct MassComponent final {
         /** @brief The initial mass of the entity at launch, including all fuel (in kg). */
         double initialMass_kg{1.0};
 
@@ -1,6 +1,5 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
 #include <glm/glm.hpp>
 #include <vector>
 #include <string>
@@ -33,7 +32,7 @@ namespace StrikeEngine {
     /**
      * @brief Manages the state of a multi-stage propulsion system for an entity.
      */
-    struct PropulsionComponent final : public Component {
+    struct PropulsionComponent final {
         std::vector<PropulsionStage> stages;
         int currentStageIndex = -1;
         double timeInCurrentStage_seconds = 0.0;
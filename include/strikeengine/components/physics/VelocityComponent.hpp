@@ -1,6 +1,6 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
+#include "strikeengine/ecs/SoA.hpp"
 #include <glm/glm.hpp>
 
 namespace StrikeEngine {
@@ -10,7 +10,7 @@ namespace StrikeEngine {
      * This component is updated by the IntegrationSystem each tick based on the
      * total forces and torques applied to the entity.
      */
-    struct VelocityComponent final : public Component {
+    struct VelocityComponent final {
     private:
         /**
          * @brief Linear velocity in meters per second (m/s).
@@ -98,4 +98,57 @@ namespace StrikeEngine {
          */
         void addAngular(const glm::dvec3& angularVelocity) noexcept { angular += angularVelocity; }
     };
+
+    /**
+     * @brief Velocities are stored structure-of-arrays, as six lanes: linear x/y/z, then angular x/y/z.
+     */
+    template<>
+    struct SoALayout<VelocityComponent> {
+        static constexpr size_t LINEAR = 0;
+        static constexpr size_t ANGULAR = 3;
+        static constexpr size_t LANES = 6;
+
+        /**
+         * @brief The VelocityComponent accessors over one entity's lanes.
+         */
+        template<bool Const>
+        class Ref : public SoASlot<Const> {
+        public:
+            using SoASlot<Const>::SoASlot;
+
+            [[nodiscard]] glm::dvec3 getLinear() const noexcept { return loadVec3(LINEAR); }
+            void setLinear(const glm::dvec3& linearVelocity) const noexcept requires (!Const) {
+                storeVec3(LINEAR, linearVelocity);
+            }
+            void addLinear(const glm::dvec3& linearVelocity) const noexcept requires (!Const) {
+                storeVec3(LINEAR, loadVec3(LINEAR) + linearVelocity);
+            }
+
+            [[nodiscard]] glm::dvec3 getAngular() const noexcept { return loadVec3(ANGULAR); }
+            void setAngular(const glm::dvec3& angularVelocity) const noexcept requires (!Const) {
+                storeVec3(ANGULAR, angularVelocity);
+            }
+            void addAngular(const glm::dvec3& angularVelocity) const noexcept requires (!Const) {
+                storeVec3(ANGULAR, loadVec3(ANGULAR) + angularVelocity);
+            }
+
+            operator VelocityComponent() const { return {getLinear(), getAngular()}; }
+
+        private:
+            [[nodiscard]] glm::dvec3 loadVec3(size_t first) const noexcept {
+                return {this->lane(first), this->lane(first + 1), this->lane(first + 2)};
+            }
+
+            void storeVec3(size_t first, const glm::dvec3& value) const noexcept requires (!Const) {
+                this->lane(first) = value.x;
+                this->lane(first + 1) = value.y;
+                this->lane(first + 2) = value.z;
+            }
+        };
+
+        static void store(const Ref<false>& slot, const VelocityComponent& velocity) {
+            slot.setLinear(velocity.getLinear());
+            slot.setAngular(velocity.getAngular());
+        }
+    };
 } // namespace StrikeEngine
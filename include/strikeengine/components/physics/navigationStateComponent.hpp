@@ -1,6 +1,5 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 
@@ -13,7 +12,7 @@ namespace StrikeEngine {
      * readings. It will slowly drift away from the "ground truth" state
      * represented by the TransformComponent and VelocityComponent.
      */
-    struct NavigationStateComponent final : public Component {
+    struct NavigationStateComponent final {
         glm::dvec3 estimated_position{0.0};
         glm::dvec3 estimated_velocity{0.0};
         glm::dvec3 estimated_acceleration{0.0};
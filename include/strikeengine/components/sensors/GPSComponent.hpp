@@ -1,13 +1,11 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
-
 namespace StrikeEngine {
 
     /**
      * @brief Models a GPS receiver for sensor fusion.
      */
-    struct GPSComponent final : public Component {
+    struct GPSComponent final {
         /**
          * @brief The rate at which the GPS provides a new position fix, in Hertz.
          * A value of 1.0 means one update per second.
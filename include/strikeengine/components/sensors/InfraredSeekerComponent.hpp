@@ -1,7 +1,5 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
-
 namespace StrikeEngine {
     /**
      * @brief Defines the common infrared wavelength bands for sensors.
@@ -14,7 +12,7 @@ namespace StrikeEngine {
     /**
      * @brief Stores the physical hardware parameters of an IR seeker.
      */
-    struct InfraredSeekerComponent final : public Component {
+    struct InfraredSeekerComponent final {
         /**
          * @brief The sensitivity of the detector, measured as the minimum amount
          * of thermal energy required for a lock, in Watts.
@@ -1,7 +1,5 @@
 #pragma once
 
-#include "strikeengine/ecs/Component.hpp"
-
 #include <glm/glm.hpp>
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/transform.hpp>
@@ -9,7 +7,7 @@
 
 namespace StrikeEngine {
 
-    struct TransformComponent final : public Component {
+    struct TransformComponent final {
         glm::dvec3 position{0,0,0};
         glm::dquat orientation{1.0, 0.0, 0.0, 0.0};
         glm::dvec3 scale{1.0};
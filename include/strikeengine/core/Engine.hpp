@@ -3,12 +3,14 @@
 #include "strikeengine/ecs/Registry.hpp"
 #include "strikeengine/core/JobSystem.hpp"
 #include "strikeengine/core/SystemGraph.hpp"
+#include "strikeengine/core/TaskGraph.hpp"
 #include "strikeengine/simulation/EntityFactory.hpp"
 
 #include <memory>
 #include <vector>
 
 #include "strikeengine/atmosphere/AtmosphereManager.hpp"
+#include "strikeengine/atmosphere/WeatherField.hpp"
 
 namespace StrikeEngine {
 
@@ -50,11 +52,14 @@ namespace StrikeEngine {
         Registry _registry;
         EntityFactory _entity_factory;
         AtmosphereManager _atmosphere_manager;
+        WeatherField _weather_field;
 
         JobSystem _job_system;
         SystemGraph _system_graph;
 
-        std::vector<std::vector<System*>> _execution_order;
+        TaskGraph _frame_graph;
+        // The time step of the frame being run; read by the system tasks in _frame_graph.
+        double _frame_dt = 0.0;
     };
 
 } // namespace StrikeEngine
@@ -1,15 +1,33 @@
 #pragma once
 
+#include "strikeengine/core/WorkStealingDeque.hpp"
+
 #include <vector>
-#include <functional>
+#include <algorithm>
+#include <cstddef>
+#include <new>
 #include <thread>
-#include <queue>
 #include <mutex>
-#include <condition_variable>
 #include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <span>
+#include <cstdint>
+#include <limits>
 
 namespace StrikeEngine {
 
+    struct SystemAccess;
+
+    /**
+     * @class JobSystem
+     * @brief A work-stealing thread pool.
+     *
+     * Each worker owns a lock-free deque. Jobs submitted from a worker go to that worker's own
+     * deque; jobs submitted from any other thread go to a shared injection queue. Idle workers
+     * steal from a random victim, then drain the injection queue, and only then go to sleep.
+     */
     class JobSystem {
     public:
         /**
@@ -25,28 +43,218 @@ namespace StrikeEngine {
         ~JobSystem();
 
         /**
-         * @brief Submits a new job to the queue.
-         * @param job A function object (e.g., a lambda) to be executed.
+         * @brief Bytes of inline storage in a job. Callables larger than this do not compile.
+         */
+        static constexpr size_t JOB_STORAGE_SIZE = 96;
+
+        /**
+         * @brief Submits a new job.
+         *
+         * The callable is moved into a recycled job object, so submission does not allocate
+         * once the job caches are warm. From a worker thread the job goes to that worker's
+         * deque, or runs inline if the deque is full. From any other thread it goes to the
+         * injection queue.
+         * @param func A function object (e.g., a lambda) to be executed.
+         */
+        template<typename Func>
+        void submit(Func&& func) {
+            Job* job = makeJob(std::forward<Func>(func));
+            _pending_jobs.fetch_add(1, std::memory_order_relaxed);
+            enqueue(std::span<Job* const>(&job, 1));
+        }
+
+        /**
+         * @brief Submits @p count jobs; job i calls func(i).
+         *
+         * Each job holds its own copy of @p func, and the jobs are queued in batches, so an
+         * external caller takes the injection lock once per batch rather than once per job.
+         * @param count The number of jobs.
+         * @param func Called as func(index). Must be copyable.
          */
-        void submit(std::function<void()> job);
+        template<typename Func>
+        void submitN(size_t count, const Func& func) {
+            Job* batch[SUBMIT_BATCH_SIZE];
+            for (size_t first = 0; first < count; first += SUBMIT_BATCH_SIZE) {
+                const size_t batch_size = std::min(SUBMIT_BATCH_SIZE, count - first);
+                for (size_t i = 0; i < batch_size; ++i) {
+                    batch[i] = makeJob([func, index = first + i]() { func(index); });
+                }
+                _pending_jobs.fetch_add(batch_size, std::memory_order_relaxed);
+                enqueue(std::span<Job* const>(batch, batch_size));
+            }
+        }
 
         /**
          * @brief Blocks the calling thread until all submitted jobs are complete.
          */
         void wait();
 
+        /**
+         * @brief Finds and executes one queued job on the calling thread.
+         *
+         * Lets a thread that is waiting on its own condition help out instead of idling.
+         * @return False if no job was available.
+         */
+        bool runPendingJob();
+
+        /**
+         * @brief Splits the range [0, count) into chunks and runs them on the worker threads.
+         *
+         * The calling thread runs the first chunk itself and then helps execute queued jobs
+         * until every chunk has finished, so it is safe to call from inside a job.
+         * @param count The number of items in the range.
+         * @param grain_size The maximum number of items per chunk.
+         * @param body Called as body(begin, end) for each chunk.
+         */
+        template<typename Body>
+        void parallelFor(size_t count, size_t grain_size, const Body& body) {
+            if (count == 0) {
+                return;
+            }
+            grain_size = std::max<size_t>(grain_size, 1);
+            const size_t chunk_count = (count + grain_size - 1) / grain_size;
+
+            // Chunks signal completion through a counter on this stack frame. Nothing touches
+            // it after the final decrement, so returning as soon as it reads zero is safe.
+            std::atomic<size_t> remaining_chunks(chunk_count - 1);
+            submitN(chunk_count - 1, [&body, &remaining_chunks, count, grain_size](size_t chunk) {
+                const size_t begin = (chunk + 1) * grain_size;
+                body(begin, std::min(begin + grain_size, count));
+                remaining_chunks.fetch_sub(1, std::memory_order_acq_rel);
+            });
+
+            body(0, std::min(grain_size, count));
+            helpUntilZero(remaining_chunks);
+        }
+
     private:
+        struct JobCache;
+
+        /**
+         * @brief A type-erased callable with inline storage, recycled through a JobCache.
+         */
+        struct alignas(64) Job {
+            // Invokes the stored callable, then destroys it.
+            void (*run)(Job& job) = nullptr;
+            // Link for the free lists and the injection queue; a job is on at most one.
+            Job* next = nullptr;
+            // The cache this job returns to once it has run.
+            JobCache* home = nullptr;
+            // The system that submitted the job; the job's component accesses are checked against it.
+            const SystemAccess* access = nullptr;
+            alignas(std::max_align_t) std::byte storage[JOB_STORAGE_SIZE];
+        };
+
+        /**
+         * @brief Recycled jobs owned by one thread (or, for the external cache, one mutex).
+         *
+         * The owner pops from free_list without synchronization. Any other thread that finishes
+         * one of these jobs pushes it onto the lock-free returned stack, and the owner takes that
+         * whole stack once free_list runs dry.
+         */
+        struct JobCache {
+            Job* free_list = nullptr;
+            std::atomic<Job*> returned = nullptr;
+            std::vector<std::unique_ptr<Job[]>> blocks;
+        };
+
+        static constexpr size_t WORKER_QUEUE_CAPACITY = 4096;
+        static constexpr size_t SUBMIT_BATCH_SIZE = 64;
+        static constexpr size_t JOB_BLOCK_SIZE = 64;
+        static constexpr size_t NO_WORKER = std::numeric_limits<size_t>::max();
+
+        struct Worker {
+            WorkStealingDeque<Job*> deque{WORKER_QUEUE_CAPACITY};
+            uint32_t rng_state = 0;
+            JobCache cache;
+        };
+
+        /**
+         * @brief Moves a callable into a recycled job.
+         */
+        template<typename Func>
+        Job* makeJob(Func&& func) {
+            using Callable = std::decay_t<Func>;
+            static_assert(sizeof(Callable) <= JOB_STORAGE_SIZE,
+                          "Job callable exceeds JOB_STORAGE_SIZE; capture large state by reference.");
+            static_assert(alignof(Callable) <= alignof(std::max_align_t), "Job callable is over-aligned.");
+
+            Job* job = allocateJob();
+            ::new (static_cast<void*>(job->storage)) Callable(std::forward<Func>(func));
+            job->run = [](Job& self) {
+                auto& callable = *std::launder(reinterpret_cast<Callable*>(self.storage));
+                callable();
+                callable.~Callable();
+            };
+            return job;
+        }
+
+        /**
+         * @brief Takes a job from the calling thread's cache, growing it by a block if empty, and
+         * tags it with the system running on the calling thread.
+         */
+        Job* allocateJob();
+
+        /**
+         * @brief Returns a finished job to the cache it came from.
+         */
+        void releaseJob(Job* job);
+
         /**
          * @brief The main loop for each worker thread.
          */
-        void workerLoop();
+        void workerLoop(size_t worker_index);
+
+        /**
+         * @brief Takes one job from the local deque, a random victim, or the injection queue.
+         * @param worker_index The calling worker, or NO_WORKER for a thread outside the pool.
+         */
+        Job* findJob(size_t worker_index);
+
+        /**
+         * @brief Queues already-counted jobs and wakes as many sleepers as there are jobs.
+         */
+        void enqueue(std::span<Job* const> jobs);
+
+        /**
+         * @brief Runs and recycles a job, then counts it as finished.
+         */
+        void execute(Job* job);
+
+        /**
+         * @brief Runs queued jobs on the calling thread until @p counter reaches zero.
+         */
+        void helpUntilZero(const std::atomic<size_t>& counter);
+
+        /**
+         * @brief Wakes up to @p count sleeping workers.
+         */
+        void wakeWorkers(size_t count);
+
+        /**
+         * @brief Index of the calling thread in _workers, or NO_WORKER if it is not one of ours.
+         */
+        size_t currentWorkerIndex() const;
 
+        std::vector<std::unique_ptr<Worker>> _workers;
         std::vector<std::jthread> _worker_threads;
-        std::queue<std::function<void()>> _job_queue;
-        std::mutex _queue_mutex;
-        std::condition_variable _condition;
-        std::atomic<size_t> _pending_jobs;
-        bool _stop_processing = false;
+
+        // Jobs allocated by threads outside the pool.
+        JobCache _external_cache;
+        std::mutex _external_cache_mutex;
+
+        // Intrusive FIFO of jobs submitted from outside the pool, linked through Job::next.
+        Job* _injection_head = nullptr;
+        Job* _injection_tail = nullptr;
+        std::mutex _injection_mutex;
+        std::atomic<size_t> _injection_size = 0;
+
+        // Jobs submitted but not yet finished; wait() blocks on this.
+        alignas(64) std::atomic<size_t> _pending_jobs = 0;
+        // Bumped to wake sleepers; workers wait on the value they saw before re-checking for work.
+        alignas(64) std::atomic<uint32_t> _wake_epoch = 0;
+        std::atomic<uint32_t> _sleeping_workers = 0;
+        std::atomic<bool> _stop_processing = false;
     };
 
 } // namespace StrikeEngine
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace StrikeEngine {
+
+    /**
+     * @brief A whole file mapped read-only into memory.
+     *
+     * The mapping is shared: processes on one host that map the same file read the same
+     * page-cache pages instead of each holding its own copy. On platforms without mmap the
+     * file is read into a private buffer instead.
+     */
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Maps a file, replacing any current mapping.
+         * @param filepath The file to map.
+         * @return True if the file was mapped, false if it could not be opened or mapped.
+         */
+        bool open(const std::string& filepath);
+
+        /**
+         * @brief Unmaps the file.
+         */
+        void close();
+
+        /**
+         * @brief Asks the OS to start reading a byte range in ahead of use. A hint only.
+         */
+        void prefetch(size_t offset, size_t length) const;
+
+        /**
+         * @brief Drops this process's pages of a byte range; they are read back in on next use.
+         * Pages shared with other processes stay in the page cache. A hint only.
+         */
+        void release(size_t offset, size_t length) const;
+
+        [[nodiscard]] bool isOpen() const { return _open; }
+        [[nodiscard]] std::span<const std::byte> bytes() const { return {_data, _size}; }
+        [[nodiscard]] size_t size() const { return _size; }
+
+    private:
+        const std::byte* _data = nullptr;
+        size_t _size = 0;
+        bool _open = false;
+        std::unique_ptr<std::byte[]> _buffer; // Holds the file where mmap is unavailable
+    };
+
+} // namespace StrikeEngine
@@ -0,0 +1,26 @@
+#pragma once
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+/** @brief 1 when x86 SIMD kernels can be compiled with per-function target attributes. */
+#define STRIKEENGINE_SIMD_X86 1
+#else
+#define STRIKEENGINE_SIMD_X86 0
+#endif
+
+namespace StrikeEngine {
+
+    /**
+     * @brief The instruction set a batched kernel runs with.
+     */
+    enum class SimdLevel {
+        Scalar,
+        AVX2,
+        AVX512
+    };
+
+    /**
+     * @brief The widest SIMD level both the build and the running CPU support. Detected once.
+     */
+    SimdLevel detectSimdLevel();
+
+} // namespace StrikeEngine
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "strikeengine/ecs/System.hpp"
+#include "strikeengine/core/TaskGraph.hpp"
+#include <concepts>
+#include <functional>
 #include <vector>
 #include <unordered_map>
 #include <memory>
@@ -11,25 +14,77 @@ namespace StrikeEngine {
     public:
         /**
          * @brief Adds a system to the graph.
+         *
+         * The system's declared Reads/Writes are compared with every system added before it; for
+         * each conflict the new system is made to run after the earlier one. Systems that do not
+         * conflict are left free to run in parallel, so registration order only matters between
+         * systems that touch the same components.
          * @param system A unique pointer to the system to be added.
+         * @return A non-owning pointer to the system.
          */
-        System* addSystem(std::unique_ptr<System> system);
+        template<typename T>
+            requires std::derived_from<T, System>
+        T* addSystem(std::unique_ptr<T> system) {
+            T* system_ptr = system.get();
+            registerSystem(std::move(system), SystemAccess::of<T>());
+            return system_ptr;
+        }
 
         /**
-         * @brief Defines a dependency between two systems.
+         * @brief Defines an explicit dependency between two systems, for ordering that is not
+         * expressed through component access.
          * @param dependent The system that must run AFTER the prerequisite.
          * @param prerequisite The system that must run BEFORE the dependent.
          */
         void addDependency(System* dependent, System* prerequisite);
 
+        /**
+         * @brief Runs a system at a lower rate than the simulation tick.
+         *
+         * The system is skipped on ticks where less than @p period_s has elapsed since it last
+         * ran, and when it does run it receives the full elapsed time as its dt. Skipped systems
+         * still release their dependents, so the rest of the frame is unaffected.
+         * @param system A system already added to the graph.
+         * @param period_s The minimum time between runs in seconds; 0 runs it every tick.
+         */
+        void setPeriod(System* system, double period_s);
+
+        /**
+         * @brief The period set for a system, or 0 if it runs every tick.
+         */
+        [[nodiscard]] double getPeriod(System* system) const;
+
         /**
          * @brief Calculates and returns a valid parallel execution order.
          * @return A vector of vectors, where each inner vector is a "stage" of
          * systems that can all be run in parallel.
          */
-        std::vector<std::vector<System*>> getExecutionOrder();
+        std::vector<std::vector<System*>> getExecutionOrder() const;
+
+        /**
+         * @brief Builds a task graph with one node per system and the same dependencies.
+         *
+         * Each node tracks the time elapsed since its system last ran and applies the system's
+         * period, so one run of the graph is one simulation tick.
+         * @param tickDt The tick length, read by every node on every run. Must outlive the graph.
+         * @param runSystem Called as runSystem(system, dt) when a system is due, with dt the time
+         * elapsed since it last ran.
+         * @return The task graph, ready to run every tick.
+         */
+        TaskGraph buildTaskGraph(const double& tickDt, const std::function<void(System*, double)>& runSystem) const;
 
     private:
+        /**
+         * @brief Takes ownership of a system and derives its edges from the declared access.
+         */
+        void registerSystem(std::unique_ptr<System> system, SystemAccess access);
+
+        // The declared component access of each system.
+        std::unordered_map<System*, SystemAccess> _access;
+
+        // Minimum time between runs for systems that do not run every tick.
+        std::unordered_map<System*, double> _periods;
+
         // A map to store the graph structure, mapping a system to the list of systems that depend on it.
         std::unordered_map<System*, std::vector<System*>> _adjacency_list;
 
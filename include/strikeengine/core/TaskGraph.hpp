@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace StrikeEngine {
+
+    class JobSystem;
+
+    /**
+     * @class TaskGraph
+     * @brief A persistent DAG of tasks, run on the JobSystem without per-stage barriers.
+     *
+     * The graph is built once. Each run resets every node's atomic predecessor counter, then
+     * launches the nodes that have none. A finishing node decrements its successors and launches
+     * any that reach zero, running one of them itself as a continuation. The caller waits on a
+     * single completion latch, so the frame costs only as long as the real critical path.
+     */
+    class TaskGraph {
+    public:
+        TaskGraph() = default;
+        TaskGraph(TaskGraph&&) = default;
+        TaskGraph& operator=(TaskGraph&&) = default;
+
+        /**
+         * @brief Adds a task to the graph.
+         * @param work The function run once per execution of the graph.
+         * @return The index of the new node, used to declare dependencies.
+         */
+        size_t addTask(std::function<void()> work);
+
+        /**
+         * @brief Declares that @p dependent may only start after @p prerequisite has finished.
+         */
+        void addDependency(size_t dependent, size_t prerequisite);
+
+        /**
+         * @brief Runs every task once, respecting dependencies, and blocks until all have finished.
+         *
+         * The calling thread helps execute jobs while it waits. Not reentrant: a graph may only
+         * be run by one thread at a time. Throws std::runtime_error if the dependencies contain
+         * a cycle.
+         * @param job_system The job system that executes the tasks.
+         */
+        void run(JobSystem& job_system);
+
+        /**
+         * @brief The number of tasks in the graph.
+         */
+        [[nodiscard]] size_t size() const { return _nodes.size(); }
+
+    private:
+        struct Node {
+            std::function<void()> work;
+            std::vector<size_t> successors;
+            size_t predecessor_count = 0;
+            std::atomic<size_t> remaining_predecessors = 0;
+        };
+
+        /**
+         * @brief Throws if the dependencies contain a cycle, which would otherwise hang run().
+         */
+        void validate();
+
+        /**
+         * @brief Runs a node, then follows the chain of successors it made ready.
+         */
+        void runNode(JobSystem& job_system, size_t index);
+
+        std::vector<std::unique_ptr<Node>> _nodes;
+        std::vector<size_t> _roots;
+        bool _validated = false;
+
+        // Completion latch: tasks not yet finished in the current run.
+        std::unique_ptr<std::atomic<size_t>> _remaining_tasks = std::make_unique<std::atomic<size_t>>(0);
+    };
+
+} // namespace StrikeEngine
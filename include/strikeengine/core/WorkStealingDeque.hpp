@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
+namespace StrikeEngine {
+
+    /**
+     * @class WorkStealingDeque
+     * @brief A fixed-capacity, lock-free Chase-Lev deque.
+     *
+     * The owning thread pushes and pops at the bottom (LIFO, cache-warm); any other thread may
+     * steal from the top (FIFO). The memory orderings follow Le et al., "Correct and Efficient
+     * Work-Stealing for Weak Memory Models" (PPoPP 2013). The buffer does not grow: push()
+     * reports a full deque and leaves it to the caller to run the item some other way.
+     */
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    class WorkStealingDeque {
+    public:
+        /**
+         * @param capacity Maximum number of queued items. Rounded up to a power of two.
+         */
+        explicit WorkStealingDeque(size_t capacity = 4096)
+            : _capacity(std::bit_ceil(capacity)),
+              _mask(static_cast<int64_t>(_capacity) - 1),
+              _buffer(std::make_unique<std::atomic<T>[]>(_capacity)) {
+        }
+
+        WorkStealingDeque(const WorkStealingDeque&) = delete;
+        WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+        /**
+         * @brief Pushes an item at the bottom. Owner thread only.
+         * @return False if the deque is full.
+         */
+        bool push(T item) {
+            const int64_t bottom = _bottom.load(std::memory_order_relaxed);
+            const int64_t top = _top.load(std::memory_order_acquire);
+            if (bottom - top >= static_cast<int64_t>(_capacity)) {
+                return false;
+            }
+            _buffer[bottom & _mask].store(item, std::memory_order_relaxed);
+            // A release store rather than the paper's release fence: same guarantee, and visible to TSan.
+            _bottom.store(bottom + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Pops the most recently pushed item. Owner thread only.
+         */
+        std::optional<T> pop() {
+            const int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+            _bottom.store(bottom, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = _top.load(std::memory_order_relaxed);
+
+            if (top > bottom) {
+                // Already empty.
+                _bottom.store(bottom + 1, std::memory_order_relaxed);
+                return std::nullopt;
+            }
+
+            T item = _buffer[bottom & _mask].load(std::memory_order_relaxed);
+            if (top == bottom) {
+                // Last item: race the thieves for it.
+                const bool won = _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                                              std::memory_order_relaxed);
+                _bottom.store(bottom + 1, std::memory_order_relaxed);
+                if (!won) {
+                    return std::nullopt;
+                }
+            }
+            return item;
+        }
+
+        /**
+         * @brief Takes the oldest item. Safe to call from any thread.
+         * @return The item, or nullopt if the deque was empty or another thread won the race.
+         */
+        std::optional<T> steal() {
+            int64_t top = _top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t bottom = _bottom.load(std::memory_order_acquire);
+            if (top >= bottom) {
+                return std::nullopt;
+            }
+
+            T item = _buffer[top & _mask].load(std::memory_order_relaxed);
+            if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return std::nullopt;
+            }
+            return item;
+        }
+
+        /**
+         * @brief A racy snapshot of whether the deque holds anything.
+         */
+        [[nodiscard]] bool empty() const {
+            return _top.load(std::memory_order_relaxed) >= _bottom.load(std::memory_order_relaxed);
+        }
+
+    private:
+        // Thieves hammer _top and the owner hammers _bottom; keep them on separate cache lines.
+        alignas(64) std::atomic<int64_t> _top{0};
+        alignas(64) std::atomic<int64_t> _bottom{0};
+        size_t _capacity;
+        int64_t _mask;
+        std::unique_ptr<std::atomic<T>[]> _buffer;
+    };
+
+} // namespace StrikeEngine
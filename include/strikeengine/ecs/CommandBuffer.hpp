@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Entity.hpp"
+#include "Component.hpp"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace StrikeEngine {
+
+    class Registry;
+
+    /**
+     * @brief Records structural changes (create, destroy, add, remove) for later application.
+     *
+     * Systems running in the frame graph must not change entity structure directly: another
+     * system may be iterating the same pools on a different thread. They record the change
+     * here instead and the Registry applies every buffer at the end-of-frame sync point, see
+     * Registry::commands() and Registry::flushCommands().
+     *
+     * A buffer belongs to one thread and is not synchronised. Commands are applied in the order
+     * they were recorded; the order between buffers of different threads is unspecified.
+     * Component payloads live in a block arena that is reused from frame to frame, so steady-state
+     * recording does not allocate.
+     */
+    class CommandBuffer {
+    public:
+        explicit CommandBuffer(Registry& registry) : _registry(&registry), _owner(std::this_thread::get_id()) {}
+        ~CommandBuffer() { clear(); }
+
+        CommandBuffer(const CommandBuffer&) = delete;
+        CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+        /**
+         * @brief Reserves a new entity. The handle can be used in further commands right away;
+         * the entity and its recorded components appear in the registry when the buffer is applied.
+         * Until then isAlive() is false for it, whether its index is new or reused.
+         */
+        Entity create();
+
+        /**
+         * @brief Destroys the entity when the buffer is applied. Stale handles are ignored.
+         */
+        void destroy(Entity entity) {
+            _commands.push_back({&applyDestroy, nullptr, entity, nullptr});
+        }
+
+        /**
+         * @brief Adds (or replaces) a component when the buffer is applied.
+         * The component is constructed now as T{args...}. Skipped if the entity has died by then.
+         */
+        template<Component T, typename... Args>
+        void add(Entity entity, Args&&... args) {
+            static_assert(sizeof(T) <= BLOCK_SIZE, "Component is too large for a command buffer block.");
+            static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Component is over-aligned.");
+            void* payload = new (allocate(sizeof(T), alignof(T))) T{std::forward<Args>(args)...};
+            void (*destroyPayload)(void*) = nullptr;
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                destroyPayload = [](void* p) { static_cast<T*>(p)->~T(); };
+            }
+            _commands.push_back({&applyAdd<T>, destroyPayload, entity, payload});
+        }
+
+        /**
+         * @brief Removes a component when the buffer is applied, if the entity still has it.
+         */
+        template<Component T>
+        void remove(Entity entity) {
+            _commands.push_back({&applyRemove<T>, nullptr, entity, nullptr});
+        }
+
+        /**
+         * @brief Applies every recorded command to the registry in order, then clears the buffer.
+         */
+        void apply() {
+            for (const Command& command : _commands) {
+                command.apply(*_registry, command.entity, command.payload);
+            }
+            clear();
+        }
+
+        [[nodiscard]] bool empty() const { return _commands.empty(); }
+        [[nodiscard]] size_t size() const { return _commands.size(); }
+
+        /** @brief The thread the buffer was created for. */
+        [[nodiscard]] std::thread::id owner() const { return _owner; }
+
+    private:
+        static constexpr size_t BLOCK_SIZE = 16 * 1024;
+
+        struct Command {
+            void (*apply)(Registry&, Entity, void*);
+            void (*destroyPayload)(void*); // nullptr for trivially destructible payloads
+            Entity entity;
+            void* payload;
+        };
+
+        // Defined in Registry.hpp, where Registry is complete.
+        static void applyDestroy(Registry& registry, Entity entity, void* payload);
+        template<typename T>
+        static void applyAdd(Registry& registry, Entity entity, void* payload);
+        template<typename T>
+        static void applyRemove(Registry& registry, Entity entity, void* payload);
+
+        // Bump-allocates from the block arena. Blocks are kept when the buffer is cleared and
+        // never move, so payloads need not be trivially relocatable.
+        void* allocate(size_t size, size_t alignment) {
+            size_t offset = (_offset + alignment - 1) & ~(alignment - 1);
+            if (_block == _blocks.size() || offset + size > BLOCK_SIZE) {
+                if (_block < _blocks.size()) {
+                    ++_block;
+                }
+                if (_block == _blocks.size()) {
+                    _blocks.push_back(std::make_unique_for_overwrite<std::byte[]>(BLOCK_SIZE));
+                }
+                offset = 0;
+            }
+            _offset = offset + size;
+            return _blocks[_block].get() + offset;
+        }
+
+        void clear() {
+            for (const Command& command : _commands) {
+                if (command.destroyPayload) {
+                    command.destroyPayload(command.payload);
+                }
+            }
+            _commands.clear();
+            _block = 0;
+            _offset = 0;
+        }
+
+        Registry* _registry;
+        std::thread::id _owner;
+        std::vector<Command> _commands;
+        std::vector<std::unique_ptr<std::byte[]>> _blocks;
+        size_t _block = 0;
+        size_t _offset = 0;
+    };
+
+} // namespace StrikeEngine
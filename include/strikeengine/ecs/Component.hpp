@@ -1,13 +1,28 @@
 #pragma once
 
+#include <type_traits>
+
 namespace StrikeEngine {
 
     /**
-     * @brief Base struct for all components in the ECS.
-     * All components must be inherited from this struct to be managed by the Registry.
+     * @brief The requirements on a type the Registry can store as a component.
+     *
+     * Components are plain structs with no base class and no virtual functions, so the dense
+     * arrays hold only the data itself. The pools move components around when they swap-remove
+     * or sort them; for trivially copyable components those moves are plain memcpy.
+     */
+    template<typename T>
+    concept Component = std::is_object_v<T> && !std::is_const_v<T> && !std::is_polymorphic_v<T> &&
+        std::is_move_constructible_v<T> && std::is_move_assignable_v<T> && std::is_destructible_v<T>;
+
+    /**
+     * @brief A component with an onAdd(T&) overload, found by argument-dependent lookup.
+     *
+     * Registry::add calls it on the new component before storing it, including for adds
+     * replayed from a CommandBuffer. Components use it to resolve what they refer to once, when
+     * they are attached, rather than in a per-frame pass over every instance.
      */
-    struct Component {
-        virtual ~Component() = default;
-    };
+    template<typename T>
+    concept ComponentWithAddHook = Component<T> && requires(T& component) { onAdd(component); };
 
 } // namespace StrikeEngine
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace StrikeEngine {
+
+    /**
+     * @brief Hands out a dense, process-wide index for every component type.
+     *
+     * The index is assigned once, the first time a type is used, and is then a
+     * constant for the lifetime of the process. The Registry uses it to keep its
+     * pools in a flat vector instead of a map keyed by type name.
+     */
+    class ComponentFamily {
+    public:
+        template<typename T>
+        static size_t id() {
+            return typeIndex<std::remove_cvref_t<T>>();
+        }
+
+    private:
+        template<typename T>
+        static size_t typeIndex() {
+            static const size_t index = _nextIndex.fetch_add(1, std::memory_order_relaxed);
+            return index;
+        }
+
+        static inline std::atomic<size_t> _nextIndex{0};
+    };
+
+} // namespace StrikeEngine
@@ -1,114 +1,445 @@
 #pragma once
 
 #include "Entity.hpp"
+#include "Component.hpp"
+#include "SoA.hpp"
+#include "ComponentFamily.hpp"
+#include "SystemAccess.hpp"
+#include "CommandBuffer.hpp"
+#include "strikeengine/core/JobSystem.hpp"
 #include <utility>
 #include <vector>
-#include <unordered_map>
 #include <memory>
-#include <typeinfo>
+#include <atomic>
+#include <type_traits>
 #include <stdexcept>
 #include <iostream>
 #include <deque>
 #include <ranges>
+#include <tuple>
+#include <algorithm>
+#include <limits>
+#include <new>
+#include <mutex>
+#include <thread>
 
 namespace StrikeEngine {
 
+    class IGroupHandler;
+
     // --- Component Pool (Interface) ---
     class IComponentPool {
     public:
         virtual ~IComponentPool() = default;
         virtual void onEntityDestroyed(Entity entity) = 0;
+
+        /**
+         * @brief The owning group that keeps this pool sorted, or nullptr if the pool is free.
+         */
+        [[nodiscard]] IGroupHandler* getOwningGroup() const { return _owningGroup; }
+        void setOwningGroup(IGroupHandler* group) { _owningGroup = group; }
+
+    private:
+        IGroupHandler* _owningGroup = nullptr;
+    };
+
+    // --- Group Handler (Interface) ---
+    /**
+     * @brief Keeps the owned pools of a group sorted as entities gain or lose components.
+     */
+    class IGroupHandler {
+    public:
+        virtual ~IGroupHandler() = default;
+        virtual void onComponentAdded(Entity entity) = 0;
+
+        /** @brief Called before an owned component of the entity is removed, or before it is destroyed. */
+        virtual void onComponentRemoved(Entity entity) = 0;
+
+        /** @brief The number of entities packed at the front of every owned pool. */
+        [[nodiscard]] virtual size_t size() const = 0;
+
+        /** @brief The number of component pools this group owns. */
+        [[nodiscard]] virtual size_t ownedCount() const = 0;
+    };
+
+    /**
+     * @brief Tag type listing the non-owned components a group additionally requires.
+     * Used as registry.group<Owned...>(Get<Extra...>{}).
+     */
+    template<typename... Components>
+    struct Get {};
+
+    // --- Sparse Set ---
+    /**
+     * @brief The entity bookkeeping shared by every component pool: a paged sparse set.
+     *
+     * The sparse array is indexed by Entity::index() and holds the position of the
+     * entity's component in the dense arrays, so get/has/add are plain array reads.
+     * Sparse pages are only allocated when an entity in that index range gets a
+     * component. The dense arrays stay packed: removal swaps the last element into
+     * the freed slot. Derived pools store the component data at the same dense indices.
+     */
+    class SparseSet : public IComponentPool {
+    public:
+        [[nodiscard]] bool has(Entity entity) const {
+            const uint32_t index = entity.index();
+            const size_t page = index / SPARSE_PAGE_SIZE;
+            if (page >= _sparse.size() || !_sparse[page]) {
+                return false;
+            }
+            const uint32_t denseIndex = _sparse[page][index % SPARSE_PAGE_SIZE];
+            // The dense entity comparison also rejects stale handles whose version no longer matches.
+            return denseIndex != NULL_INDEX && _entities[denseIndex] == entity;
+        }
+
+        /**
+         * @brief Returns the dense index of an entity known to be in the pool.
+         */
+        [[nodiscard]] size_t index(Entity entity) const {
+            return sparseSlot(entity.index());
+        }
+
+        [[nodiscard]] const std::vector<Entity>& getEntities() const {
+            return _entities;
+        }
+
+        [[nodiscard]] size_t size() const {
+            return _entities.size();
+        }
+
+    protected:
+        // Appends an entity that is not yet in the set and returns its dense index.
+        size_t insertEntity(Entity entity) {
+            assure(entity.index()) = static_cast<uint32_t>(_entities.size());
+            _entities.push_back(entity);
+            return _entities.size() - 1;
+        }
+
+        // Removes an entity known to be in the set by moving the last entity into its slot.
+        // Returns that slot; the caller moves the data at index size() (the old last) into it.
+        size_t eraseEntity(Entity entity) {
+            const uint32_t indexOfRemoved = sparseSlot(entity.index());
+            const Entity entityOfLast = _entities.back();
+
+            _entities[indexOfRemoved] = entityOfLast;
+            sparseSlot(entityOfLast.index()) = indexOfRemoved;
+            sparseSlot(entity.index()) = NULL_INDEX;
+            _entities.pop_back();
+            return indexOfRemoved;
+        }
+
+        void swapEntities(size_t lhs, size_t rhs) {
+            std::swap(_entities[lhs], _entities[rhs]);
+            sparseSlot(_entities[lhs].index()) = static_cast<uint32_t>(lhs);
+            sparseSlot(_entities[rhs].index()) = static_cast<uint32_t>(rhs);
+        }
+
+    private:
+        static constexpr size_t SPARSE_PAGE_SIZE = 4096;
+        static constexpr uint32_t NULL_INDEX = std::numeric_limits<uint32_t>::max();
+
+        uint32_t& sparseSlot(uint32_t index) {
+            return _sparse[index / SPARSE_PAGE_SIZE][index % SPARSE_PAGE_SIZE];
+        }
+
+        [[nodiscard]] uint32_t sparseSlot(uint32_t index) const {
+            return _sparse[index / SPARSE_PAGE_SIZE][index % SPARSE_PAGE_SIZE];
+        }
+
+        // Returns the sparse slot for an entity index, allocating its page on first use.
+        uint32_t& assure(uint32_t index) {
+            const size_t page = index / SPARSE_PAGE_SIZE;
+            if (page >= _sparse.size()) {
+                _sparse.resize(page + 1);
+            }
+            if (!_sparse[page]) {
+                _sparse[page] = std::make_unique<uint32_t[]>(SPARSE_PAGE_SIZE);
+                std::fill_n(_sparse[page].get(), SPARSE_PAGE_SIZE, NULL_INDEX);
+            }
+            return _sparse[page][index % SPARSE_PAGE_SIZE];
+        }
+
+        std::vector<std::unique_ptr<uint32_t[]>> _sparse;
+        std::vector<Entity> _entities;
     };
 
     // --- Component Pool (Implementation) ---
-    template<typename T>
-    class ComponentPool final : public IComponentPool {
+    /**
+     * @brief Stores the components of a single type as a packed array of structs.
+     */
+    template<Component T>
+    class ComponentPool final : public SparseSet {
     public:
         T& add(Entity entity, T component) {
-            if (_entityToIndexMap.contains(entity)) {
-                _components[_entityToIndexMap[entity]] = component;
-                return _components[_entityToIndexMap[entity]];
-            }
-            size_t newIndex = _components.size();
-            _entityToIndexMap[entity] = newIndex;
-            _indexToEntityMap[newIndex] = entity;
-            _components.push_back(component);
+            if (has(entity)) {
+                T& existing = _components[index(entity)];
+                existing = std::move(component);
+                return existing;
+            }
+            insertEntity(entity);
+            _components.push_back(std::move(component));
             return _components.back();
         }
 
         T& get(Entity entity) {
-            if (!_entityToIndexMap.contains(entity)) {
+            if (!has(entity)) {
                 throw std::runtime_error("Component not found for entity.");
             }
-            return _components[_entityToIndexMap[entity]];
+            return _components[index(entity)];
         }
 
-        [[nodiscard]] bool has(Entity entity) const {
-            return _entityToIndexMap.contains(entity);
+        void onEntityDestroyed(Entity entity) override {
+            remove(entity);
         }
 
-        void onEntityDestroyed(Entity entity) override {
-            if (!_entityToIndexMap.contains(entity)) {
+        void remove(Entity entity) {
+            if (!has(entity)) {
                 return;
             }
             // Efficiently remove a component by swapping with the last element
-            size_t indexOfRemoved = _entityToIndexMap[entity];
-            size_t indexOfLast = _components.size() - 1;
-            Entity entityOfLast = _indexToEntityMap[indexOfLast];
-
-            _components[indexOfRemoved] = _components[indexOfLast];
-            _entityToIndexMap[entityOfLast] = indexOfRemoved;
-            _indexToEntityMap[indexOfRemoved] = entityOfLast;
-
-            _entityToIndexMap.erase(entity);
-            _indexToEntityMap.erase(indexOfLast);
+            const size_t slot = eraseEntity(entity);
+            if (slot != size()) {
+                _components[slot] = std::move(_components.back());
+            }
             _components.pop_back();
         }
 
-        [[nodiscard]] std::vector<Entity> getEntities() const {
-            std::vector<Entity> entities;
-            entities.reserve(_entityToIndexMap.size());
-            for(const auto& entity : _entityToIndexMap | std::views::keys) {
-                entities.push_back(entity);
+        /**
+         * @brief Returns the component of an entity known to be in the pool.
+         * Skips the membership check; callers must have checked has() first.
+         */
+        T& getUnchecked(Entity entity) {
+            return _components[index(entity)];
+        }
+
+        /**
+         * @brief Swaps two dense slots, keeping the sparse index consistent. Used by owning groups.
+         */
+        void swapDense(size_t lhs, size_t rhs) {
+            if (lhs == rhs) {
+                return;
             }
-            return entities;
+            std::swap(_components[lhs], _components[rhs]);
+            swapEntities(lhs, rhs);
+        }
+
+        [[nodiscard]] T* data() {
+            return _components.data();
         }
 
     private:
         std::vector<T> _components;
-        std::unordered_map<Entity, size_t> _entityToIndexMap;
-        std::unordered_map<size_t, Entity> _indexToEntityMap;
+    };
+
+    /**
+     * @brief Stores the components of an SoALayout type as one aligned array per scalar lane.
+     *
+     * All lanes share a single allocation with a common capacity, so lane k of the entity at
+     * dense index i is _lanes[k * capacity + i]. The capacity is kept a multiple of eight
+     * doubles, which keeps every lane 64-byte aligned. Components are handed out as
+     * SoALayout<T>::Ref proxies; like T& for other pools, they are invalidated by structural
+     * changes to the pool.
+     */
+    template<SoAComponent T>
+    class ComponentPool<T> final : public SparseSet {
+        using Layout = SoALayout<T>;
+        static constexpr size_t LANES = Layout::LANES;
+        static constexpr size_t LANE_ALIGNMENT = 64;
+        static constexpr size_t MIN_CAPACITY = 64;
+
+    public:
+        using Ref = typename Layout::template Ref<false>;
+
+        ComponentPool() = default;
+        ComponentPool(const ComponentPool&) = delete;
+        ComponentPool& operator=(const ComponentPool&) = delete;
+        ~ComponentPool() override { deallocate(_lanes); }
+
+        Ref add(Entity entity, const T& component) {
+            if (has(entity)) {
+                const Ref existing = at(index(entity));
+                Layout::store(existing, component);
+                return existing;
+            }
+            if (size() == _capacity) {
+                grow();
+            }
+            const Ref slot = at(insertEntity(entity));
+            Layout::store(slot, component);
+            return slot;
+        }
+
+        Ref get(Entity entity) {
+            if (!has(entity)) {
+                throw std::runtime_error("Component not found for entity.");
+            }
+            return at(index(entity));
+        }
+
+        void onEntityDestroyed(Entity entity) override {
+            remove(entity);
+        }
+
+        void remove(Entity entity) {
+            if (!has(entity)) {
+                return;
+            }
+            const size_t slot = eraseEntity(entity);
+            const size_t last = size();
+            if (slot != last) {
+                for (size_t k = 0; k < LANES; ++k) {
+                    _lanes[k * _capacity + slot] = _lanes[k * _capacity + last];
+                }
+            }
+        }
+
+        /**
+         * @brief Returns the component of an entity known to be in the pool.
+         */
+        Ref getUnchecked(Entity entity) {
+            return at(index(entity));
+        }
+
+        void swapDense(size_t lhs, size_t rhs) {
+            if (lhs == rhs) {
+                return;
+            }
+            for (size_t k = 0; k < LANES; ++k) {
+                std::swap(_lanes[k * _capacity + lhs], _lanes[k * _capacity + rhs]);
+            }
+            swapEntities(lhs, rhs);
+        }
+
+        /**
+         * @brief The lanes, indexed by dense index. Use lane(k) for the raw arrays.
+         */
+        [[nodiscard]] SoAArray<T> data() {
+            return SoAArray<T>(_lanes, _capacity);
+        }
+
+    private:
+        Ref at(size_t denseIndex) {
+            return Ref(_lanes + denseIndex, _capacity);
+        }
+
+        void grow() {
+            const size_t capacity = std::max(MIN_CAPACITY, _capacity * 2);
+            double* lanes = static_cast<double*>(
+                ::operator new(LANES * capacity * sizeof(double), std::align_val_t{LANE_ALIGNMENT}));
+            for (size_t k = 0; k < LANES; ++k) {
+                std::copy_n(_lanes + k * _capacity, size(), lanes + k * capacity);
+            }
+            deallocate(_lanes);
+            _lanes = lanes;
+            _capacity = capacity;
+        }
+
+        static void deallocate(double* lanes) {
+            if (lanes) {
+                ::operator delete(lanes, std::align_val_t{LANE_ALIGNMENT});
+            }
+        }
+
+        double* _lanes = nullptr;
+        size_t _capacity = 0;
+    };
+
+
+    // --- Group Handler (Implementation) ---
+    /**
+     * @brief Maintains the invariant of an owning group over the pools of Owned.
+     *
+     * Every entity that has all owned components sits in the first size() slots of
+     * each owned pool, at the same dense index in all of them. Entities are swapped
+     * into that prefix when they gain the last missing component and out of it
+     * before they lose one or are destroyed.
+     */
+    template<Component... Owned>
+    class GroupHandler final : public IGroupHandler {
+    public:
+        explicit GroupHandler(ComponentPool<Owned>&... pools) : _pools{&pools...} {
+            // Adopt the entities that already have every owned component.
+            const auto& candidates = std::get<0>(_pools)->getEntities();
+            for (size_t position = 0; position < candidates.size(); ++position) {
+                onComponentAdded(candidates[position]);
+            }
+        }
+
+        void onComponentAdded(Entity entity) override {
+            if (!(std::get<ComponentPool<Owned>*>(_pools)->has(entity) && ...)) {
+                return;
+            }
+            if (std::get<0>(_pools)->index(entity) < _size) {
+                return; // Already a member
+            }
+            (std::get<ComponentPool<Owned>*>(_pools)->swapDense(
+                std::get<ComponentPool<Owned>*>(_pools)->index(entity), _size), ...);
+            ++_size;
+        }
+
+        void onComponentRemoved(Entity entity) override {
+            auto* lead = std::get<0>(_pools);
+            if (!lead->has(entity) || lead->index(entity) >= _size) {
+                return;
+            }
+            --_size;
+            (std::get<ComponentPool<Owned>*>(_pools)->swapDense(
+                std::get<ComponentPool<Owned>*>(_pools)->index(entity), _size), ...);
+        }
+
+        [[nodiscard]] size_t size() const override { return _size; }
+        [[nodiscard]] size_t ownedCount() const override { return sizeof...(Owned); }
+
+    private:
+        std::tuple<ComponentPool<Owned>*...> _pools;
+        size_t _size = 0;
     };
 
 
     // --- Registry ---
     class Registry {
     public:
+        Registry() = default;
+        Registry(const Registry&) = delete;
+        Registry& operator=(const Registry&) = delete;
+
         Entity create() {
-            uint32_t index;
-            if (!_freeList.empty()) {
-                index = _freeList.front();
-                _freeList.pop_front();
-            } else {
-                index = _nextEntityIndex++;
-                if (index >= _entityVersions.size()) {
-                    _entityVersions.resize(index + 1, 1);
-                }
+#ifdef STRIKEENGINE_CHECK_SYSTEM_ACCESS
+            SystemAccess::checkStructural();
+#endif
+            const Entity entity = reserve();
+            if (entity.index() >= _entityVersions.size()) {
+                // Indices reserved by command buffers in between stay dead (version 0) until the flush.
+                _entityVersions.resize(entity.index() + 1, 0);
             }
-            return {index, _entityVersions[index]};
+            _entityVersions[entity.index()] = entity.version();
+            return entity;
         }
 
         void destroy(Entity entity) {
+#ifdef STRIKEENGINE_CHECK_SYSTEM_ACCESS
+            SystemAccess::checkStructural();
+#endif
             uint32_t index = entity.index();
             if (index >= _entityVersions.size() || _entityVersions[index] != entity.version()) {
                 return; // Entity is already invalid
             }
             _entityVersions[index]++; // Invalidate all existing handles
-            _freeList.push_back(index);
+            {
+                std::lock_guard lock(_entityMutex);
+                _freeList.push_back(index);
+            }
+
+            // Move the entity out of every owning group first so the pools can swap-remove it
+            for (const auto& group : _groups) {
+                group->onComponentRemoved(entity);
+            }
 
             // Notify all component pools to remove their data for this entity
-            for (const auto& pool : _componentPools | std::views::values) {
-                pool->onEntityDestroyed(entity);
+            for (const auto& pool : _componentPools) {
+                if (pool) {
+                    pool->onEntityDestroyed(entity);
+                }
             }
         }
 
@@ -117,94 +448,489 @@ namespace StrikeEngine {
             return index < _entityVersions.size() && _entityVersions[index] == entity.version();
         }
 
-        template<typename T, typename... Args>
-        T& add(Entity entity, Args&&... args) {
+        template<Component T, typename... Args>
+        ComponentRef<T> add(Entity entity, Args&&... args) {
+#ifdef STRIKEENGINE_CHECK_SYSTEM_ACCESS
+            SystemAccess::checkStructural();
+#endif
             if (!isAlive(entity)) {
                 throw std::runtime_error("Cannot add component to a dead entity.");
             }
-            return getComponentPool<T>()->add(entity, T{std::forward<Args>(args)...});
+            auto& pool = getComponentPool<T>();
+            if constexpr (ComponentWithAddHook<T>) {
+                T component{std::forward<Args>(args)...};
+                onAdd(component);
+                pool.add(entity, std::move(component));
+            } else {
+                pool.add(entity, T{std::forward<Args>(args)...});
+            }
+            if (IGroupHandler* group = pool.getOwningGroup()) {
+                group->onComponentAdded(entity);
+            }
+            return pool.getUnchecked(entity); // The group may have moved the component
         }
 
+        /**
+         * @brief Removes the component T from an entity, if it has one.
+         */
+        template<Component T>
+        void remove(Entity entity) {
+#ifdef STRIKEENGINE_CHECK_SYSTEM_ACCESS
+            SystemAccess::checkStructural();
+#endif
+            if (!isAlive(entity)) {
+                return;
+            }
+            ComponentPool<T>* pool = findComponentPool<T>();
+            if (!pool || !pool->has(entity)) {
+                return;
+            }
+            // Leave the owning group first so the pool can swap-remove the component
+            if (IGroupHandler* group = pool->getOwningGroup()) {
+                group->onComponentRemoved(entity);
+            }
+            pool->remove(entity);
+        }
+
+        /**
+         * @brief The T of an entity. A const T gives read-only access and, inside a system,
+         * needs only read access to T.
+         */
         template<typename T>
-        T& get(Entity entity) {
+            requires Component<std::remove_const_t<T>>
+        ComponentRef<T> get(Entity entity) {
+#ifdef STRIKEENGINE_CHECK_SYSTEM_ACCESS
+            SystemAccess::check<T>();
+#endif
             if (!isAlive(entity)) {
                 throw std::runtime_error("Cannot get component from a dead entity.");
             }
-            return getComponentPool<T>()->get(entity);
+            return getComponentPool<std::remove_const_t<T>>().get(entity);
         }
 
+        /**
+         * @brief Whether an entity has a T. Inside a system, this needs read access to T.
+         */
         template<typename T>
+            requires Component<std::remove_const_t<T>>
         bool has(Entity entity) {
+#ifdef STRIKEENGINE_CHECK_SYSTEM_ACCESS
+            SystemAccess::check<const T>();
+#endif
             if (!isAlive(entity)) {
                 return false;
             }
-            const char* typeName = typeid(T).name();
-            if (!_componentPools.contains(typeName)) {
-                return false;
-            }
-            return getComponentPool<T>()->has(entity);
+            const ComponentPool<std::remove_const_t<T>>* pool = findComponentPool<std::remove_const_t<T>>();
+            return pool && pool->has(entity);
         }
 
+        /**
+         * @brief A non-owning, allocation-free view over every entity that has all of Components.
+         *
+         * The view walks the dense entity array of the smallest participating pool in place
+         * and probes the other pools through their sparse arrays. Iteration runs from the
+         * back of the dense array to the front, so destroying the current entity (or any
+         * entity already visited) during iteration is safe. Components may be const-qualified
+         * to request read-only access.
+         */
         template<typename... Components>
+            requires (Component<std::remove_const_t<Components>> && ...)
         class View {
+            template<typename C>
+            using PoolFor = ComponentPool<std::remove_const_t<C>>;
+
         public:
-            explicit View(Registry& registry) : _registry(registry) {
-                _entities = findEntitiesWithComponents();
+            explicit View(Registry& registry)
+                : _pools{registry.findComponentPool<std::remove_const_t<Components>>()...} {
+                if constexpr (sizeof...(Components) > 0) {
+                    if ((std::get<PoolFor<Components>*>(_pools) && ...)) {
+                        _candidates = &std::get<0>(_pools)->getEntities();
+                        ((_candidates = std::get<PoolFor<Components>*>(_pools)->size() < _candidates->size()
+                              ? &std::get<PoolFor<Components>*>(_pools)->getEntities()
+                              : _candidates), ...);
+                    }
+                }
             }
 
             struct Iterator {
-                Iterator(Registry& registry, std::vector<Entity>::const_iterator it)
-                    : _registry(registry), _it(std::move(it)) {}
-                Entity operator*() const { return *_it; }
-                Iterator& operator++() { ++_it; return *this; }
-                bool operator!=(const Iterator& other) const { return _it != other._it; }
+                Iterator(const View* view, size_t position) : _view(view), _position(position) { skipRejected(); }
+                Entity operator*() const { return (*_view->_candidates)[_position - 1]; }
+                Iterator& operator++() { --_position; skipRejected(); return *this; }
+                bool operator!=(const Iterator& other) const { return _position != other._position; }
             private:
-                Registry& _registry;
-                std::vector<Entity>::const_iterator _it;
+                // Steps past entities that lack one of the components, or slots removed mid-iteration.
+                void skipRejected() {
+                    while (_position > 0) {
+                        if (_position <= _view->_candidates->size() && _view->contains(**this)) {
+                            break;
+                        }
+                        _position = std::min(_position - 1, _view->_candidates->size());
+                    }
+                }
+
+                const View* _view;
+                size_t _position;
             };
 
-            Iterator begin() { return Iterator(_registry, _entities.begin()); }
-            Iterator end() { return Iterator(_registry, _entities.end()); }
+            Iterator begin() const { return Iterator(this, _candidates ? _candidates->size() : 0); }
+            Iterator end() const { return Iterator(this, 0); }
 
             template<typename T>
-            T& get(Entity entity) { return _registry.get<T>(entity); }
-        private:
-            Registry& _registry;
-            std::vector<Entity> _entities;
+            ComponentRef<T> get(Entity entity) { return std::get<PoolFor<T>*>(_pools)->get(entity); }
 
-            auto findEntitiesWithComponents() {
-                std::vector<Entity> result;
-                if constexpr (sizeof...(Components) > 0) {
-                    auto pool = _registry.getComponentPool<std::tuple_element_t<0, std::tuple<Components...>>>();
-                    auto initialEntities = pool->getEntities();
-                    for (Entity entity : initialEntities) {
-                        if ((_registry.has<Components>(entity) && ...)) {
-                            result.push_back(entity);
-                        }
+            /** @brief Whether entity has every component of the view. */
+            [[nodiscard]] bool contains(Entity entity) const {
+                return ((std::get<PoolFor<Components>*>(_pools) && std::get<PoolFor<Components>*>(_pools)->has(entity)) && ...);
+            }
+
+            /**
+             * @brief Invokes func for every matching entity with direct component references.
+             * @param func Callable as func(Entity, ComponentRef<Components>...) or func(ComponentRef<Components>...).
+             */
+            template<typename Func>
+            void each(Func func) const {
+                if (!_candidates) {
+                    return;
+                }
+                for (size_t position = _candidates->size(); position-- > 0;) {
+                    if (position < _candidates->size()) {
+                        visit(position, func);
                     }
                 }
-                return result;
             }
+
+            /**
+             * @brief Runs func for every matching entity, in chunks spread over the job system.
+             *
+             * The candidate range is split into chunks of grain_size entities. func runs
+             * concurrently on different entities, so it must only write to the components it
+             * is handed. Structural changes are not allowed while it runs; record them in
+             * commands() instead.
+             * @param job_system The job system whose workers execute the chunks.
+             * @param grain_size The number of candidate entities per chunk.
+             * @param func Callable as func(Entity, ComponentRef<Components>...) or func(ComponentRef<Components>...).
+             */
+            template<typename Func>
+            void parallelEach(JobSystem& job_system, size_t grain_size, Func func) const {
+                if (!_candidates) {
+                    return;
+                }
+                job_system.parallelFor(_candidates->size(), grain_size, [this, &func](size_t begin, size_t end) {
+                    for (size_t position = begin; position < end; ++position) {
+                        visit(position, func);
+                    }
+                });
+            }
+
+            /**
+             * @brief An upper bound on the number of entities the view will visit.
+             */
+            [[nodiscard]] size_t sizeHint() const { return _candidates ? _candidates->size() : 0; }
+
+        private:
+            template<typename Func>
+            void visit(size_t position, Func& func) const {
+                const Entity entity = (*_candidates)[position];
+                if (!contains(entity)) {
+                    return;
+                }
+                if constexpr (std::is_invocable_v<Func, Entity, ComponentRef<Components>...>) {
+                    func(entity, std::get<PoolFor<Components>*>(_pools)->getUnchecked(entity)...);
+                } else {
+                    func(std::get<PoolFor<Components>*>(_pools)->getUnchecked(entity)...);
+                }
+            }
+
+            std::tuple<PoolFor<Components>*...> _pools;
+            const std::vector<Entity>* _candidates = nullptr;
         };
 
         template<typename... Components>
+            requires (Component<std::remove_const_t<Components>> && ...)
         View<Components...> view() {
+#ifdef STRIKEENGINE_CHECK_SYSTEM_ACCESS
+            (SystemAccess::check<Components>(), ...);
+#endif
             return View<Components...>(*this);
         }
 
+        /**
+         * @brief A lightweight handle over an owning group.
+         *
+         * The owned pools are kept sorted so that the i-th member entity sits at dense
+         * index i in every one of them; iteration is a linear sweep over parallel arrays.
+         * Extra (non-owned) components are looked up through their sparse arrays and
+         * filter the sweep. Structural changes to owned components during iteration are
+         * not allowed.
+         */
+        template<typename GetList, typename... Owned>
+        class Group;
+
+        template<typename... Extra, typename... Owned>
+        class Group<Get<Extra...>, Owned...> {
+            template<typename C>
+            using PoolFor = ComponentPool<std::remove_const_t<C>>;
+
+        public:
+            Group(IGroupHandler& handler, ComponentPool<Owned>&... owned, PoolFor<Extra>*... extra)
+                : _handler(&handler), _owned{&owned...}, _extra{extra...} {}
+
+            /**
+             * @brief Invokes func for every member with direct component references.
+             * @param func Callable as func(Entity, ComponentRef<Owned>..., ComponentRef<Extra>...) or
+             * func(ComponentRef<Owned>..., ComponentRef<Extra>...).
+             */
+            template<typename Func>
+            void each(Func func) const {
+                checkOwnedAccess();
+                if (!(std::get<PoolFor<Extra>*>(_extra) && ...)) {
+                    return;
+                }
+                sweep(0, _handler->size(), func);
+            }
+
+            /**
+             * @brief Runs func for every member, in chunks of grain_size spread over the job system.
+             *
+             * func runs concurrently on different members, so it must only write to the
+             * components it is handed. Structural changes are not allowed while it runs.
+             */
+            template<typename Func>
+            void parallelEach(JobSystem& job_system, size_t grain_size, Func func) const {
+                checkOwnedAccess();
+                if (!(std::get<PoolFor<Extra>*>(_extra) && ...)) {
+                    return;
+                }
+                job_system.parallelFor(_handler->size(), grain_size, [this, &func](size_t begin, size_t end) {
+                    sweep(begin, end, func);
+                });
+            }
+
+            /**
+             * @brief Invokes func, as for each(), for the members at dense indices [begin, end).
+             * For callers that split the group themselves, e.g. to gather members into batches.
+             */
+            template<typename Func>
+            void eachInRange(size_t begin, size_t end, Func func) const {
+                checkOwnedAccess();
+                if (!(std::get<PoolFor<Extra>*>(_extra) && ...)) {
+                    return;
+                }
+                sweep(begin, end, func);
+            }
+
+            /** @brief The number of entities that have every owned component. */
+            [[nodiscard]] size_t size() const { return _handler->size(); }
+
+            /** @brief Member entities; index i matches index i of every owned array. */
+            [[nodiscard]] const Entity* entities() const { return std::get<0>(_owned)->getEntities().data(); }
+
+            /**
+             * @brief The packed array of an owned component, valid for indices [0, size()).
+             * A T* for ordinary components, an SoAArray<T> of lanes for SoA components.
+             * Inside a system this needs read access to T; writing through it needs T in Writes.
+             */
+            template<typename T>
+            [[nodiscard]] auto data() const {
+#ifdef STRIKEENGINE_CHECK_SYSTEM_ACCESS
+                SystemAccess::check<const T>();
+#endif
+                return std::get<ComponentPool<T>*>(_owned)->data();
+            }
+
+        private:
+            // The callbacks are handed every owned component, so the system must read them all.
+            static void checkOwnedAccess() {
+#ifdef STRIKEENGINE_CHECK_SYSTEM_ACCESS
+                (SystemAccess::check<const Owned>(), ...);
+#endif
+            }
+
+            template<typename T>
+            using DenseArray = decltype(std::declval<ComponentPool<T>&>().data());
+
+            template<typename Func>
+            void sweep(size_t begin, size_t end, Func& func) const {
+                const Entity* entities = std::get<0>(_owned)->getEntities().data();
+                std::tuple<DenseArray<Owned>...> arrays{std::get<ComponentPool<Owned>*>(_owned)->data()...};
+                for (size_t i = begin; i < end; ++i) {
+                    const Entity entity = entities[i];
+                    if (!(std::get<PoolFor<Extra>*>(_extra)->has(entity) && ...)) {
+                        continue;
+                    }
+                    if constexpr (std::is_invocable_v<Func, Entity, ComponentRef<Owned>..., ComponentRef<Extra>...>) {
+                        func(entity, std::get<DenseArray<Owned>>(arrays)[i]...,
+                             std::get<PoolFor<Extra>*>(_extra)->getUnchecked(entity)...);
+                    } else {
+                        func(std::get<DenseArray<Owned>>(arrays)[i]...,
+                             std::get<PoolFor<Extra>*>(_extra)->getUnchecked(entity)...);
+                    }
+                }
+            }
+
+            IGroupHandler* _handler;
+            std::tuple<ComponentPool<Owned>*...> _owned;
+            std::tuple<PoolFor<Extra>*...> _extra;
+        };
+
+        /**
+         * @brief Returns the owning group over Owned, creating it on first use.
+         *
+         * A pool can be owned by at most one group. Requesting a group whose owned set
+         * overlaps an existing group with a different owned set throws.
+         */
+        template<Component... Owned, typename... Extra>
+            requires (Component<std::remove_const_t<Extra>> && ...)
+        Group<Get<Extra...>, Owned...> group(Get<Extra...> = {}) {
+            static_assert(sizeof...(Owned) > 0, "An owning group needs at least one owned component.");
+#ifdef STRIKEENGINE_CHECK_SYSTEM_ACCESS
+            // Owned components are checked where they are used: each() hands out all of them,
+            // data<T>() only T. Membership itself only changes at structural changes.
+            (SystemAccess::check<Extra>(), ...);
+#endif
+            IGroupHandler* handler = std::get<0>(std::tie(getComponentPool<Owned>()...)).getOwningGroup();
+            const bool reusable = handler && handler->ownedCount() == sizeof...(Owned) &&
+                ((getComponentPool<Owned>().getOwningGroup() == handler) && ...);
+            if (!reusable) {
+                if ((getComponentPool<Owned>().getOwningGroup() || ...)) {
+                    throw std::runtime_error("Registry: component pool is already owned by another group.");
+                }
+                auto created = std::make_unique<GroupHandler<Owned...>>(getComponentPool<Owned>()...);
+                handler = created.get();
+                (getComponentPool<Owned>().setOwningGroup(handler), ...);
+                _groups.push_back(std::move(created));
+            }
+            return Group<Get<Extra...>, Owned...>(*handler, getComponentPool<Owned>()...,
+                                                  findComponentPool<std::remove_const_t<Extra>>()...);
+        }
+
+        /**
+         * @brief The calling thread's command buffer for deferred structural changes.
+         *
+         * Systems running in the frame graph record create/destroy/add/remove here instead of
+         * calling the Registry directly. Safe to call from any thread; each thread gets its own
+         * buffer, so recording needs no locking.
+         */
+        CommandBuffer& commands() {
+            thread_local uint64_t t_registryId = 0;
+            thread_local CommandBuffer* t_buffer = nullptr;
+            if (t_registryId != _id) {
+                std::lock_guard lock(_commandBuffersMutex);
+                const auto found = std::ranges::find(_commandBuffers, std::this_thread::get_id(), &CommandBuffer::owner);
+                if (found != _commandBuffers.end()) {
+                    t_buffer = found->get();
+                } else {
+                    t_buffer = _commandBuffers.emplace_back(std::make_unique<CommandBuffer>(*this)).get();
+                }
+                t_registryId = _id;
+            }
+            return *t_buffer;
+        }
+
+        /**
+         * @brief Applies every thread's recorded commands. This is the end-of-frame sync point:
+         * no system may be running or recording while it executes.
+         */
+        void flushCommands() {
+            // Entities reserved by CommandBuffer::create() come alive now.
+            for (const Entity entity : _reserved) {
+                if (entity.index() >= _entityVersions.size()) {
+                    _entityVersions.resize(entity.index() + 1, 0);
+                }
+                _entityVersions[entity.index()] = entity.version();
+            }
+            _reserved.clear();
+            for (const auto& buffer : _commandBuffers) {
+                buffer->apply();
+            }
+        }
+
     private:
+        friend class CommandBuffer;
+
+        // Hands out an entity handle for create(), which makes it alive.
+        Entity reserve() {
+            std::lock_guard lock(_entityMutex);
+            if (!_freeList.empty()) {
+                const uint32_t index = _freeList.front();
+                _freeList.pop_front();
+                return {index, _entityVersions[index]};
+            }
+            return {_nextEntityIndex++, 1};
+        }
+
+        // Hands out an entity handle that stays dead until the next flushCommands(), whether its
+        // index is fresh or recycled. Thread-safe, so command buffers can reserve entities while
+        // systems run; a recycled index skips the version destroy() left it at.
+        Entity reserveDeferred() {
+            std::lock_guard lock(_entityMutex);
+            Entity entity;
+            if (!_freeList.empty()) {
+                const uint32_t index = _freeList.front();
+                _freeList.pop_front();
+                entity = {index, _entityVersions[index] + 1};
+            } else {
+                entity = {_nextEntityIndex++, 1};
+            }
+            _reserved.push_back(entity);
+            return entity;
+        }
+
+        // Returns the pool for T, creating it on first use.
         template<typename T>
-        std::shared_ptr<ComponentPool<T>> getComponentPool() {
-            const char* typeName = typeid(T).name();
-            if (!_componentPools.contains(typeName)) {
-                _componentPools[typeName] = std::make_shared<ComponentPool<T>>();
+        ComponentPool<T>& getComponentPool() {
+            const size_t id = ComponentFamily::id<T>();
+            if (id >= _componentPools.size()) {
+                _componentPools.resize(id + 1);
+            }
+            if (!_componentPools[id]) {
+                _componentPools[id] = std::make_unique<ComponentPool<T>>();
             }
-            return std::static_pointer_cast<ComponentPool<T>>(_componentPools[typeName]);
+            return static_cast<ComponentPool<T>&>(*_componentPools[id]);
         }
 
+        // Returns the pool for T, or nullptr if no component of that type was ever added.
+        template<typename T>
+        ComponentPool<T>* findComponentPool() const {
+            const size_t id = ComponentFamily::id<T>();
+            if (id >= _componentPools.size()) {
+                return nullptr;
+            }
+            return static_cast<ComponentPool<T>*>(_componentPools[id].get());
+        }
+
+        static inline std::atomic<uint64_t> _nextRegistryId{1};
+
+        const uint64_t _id = _nextRegistryId.fetch_add(1, std::memory_order_relaxed);
+        std::mutex _entityMutex; // Guards _freeList, _nextEntityIndex and _reserved
         uint32_t _nextEntityIndex = 0;
         std::deque<uint32_t> _freeList;
+        std::vector<Entity> _reserved; // Handed out by reserveDeferred(), alive from the next flush
         std::vector<uint32_t> _entityVersions;
-        std::unordered_map<const char*, std::shared_ptr<IComponentPool>> _componentPools;
+        std::vector<std::unique_ptr<IComponentPool>> _componentPools;
+        std::vector<std::unique_ptr<IGroupHandler>> _groups;
+        std::mutex _commandBuffersMutex;
+        std::vector<std::unique_ptr<CommandBuffer>> _commandBuffers;
     };
+
+    // --- CommandBuffer (Registry-dependent definitions) ---
+    inline Entity CommandBuffer::create() {
+        return _registry->reserveDeferred();
+    }
+
+    inline void CommandBuffer::applyDestroy(Registry& registry, Entity entity, void*) {
+        registry.destroy(entity);
+    }
+
+    template<typename T>
+    void CommandBuffer::applyAdd(Registry& registry, Entity entity, void* payload) {
+        if (registry.isAlive(entity)) {
+            registry.add<T>(entity, std::move(*static_cast<T*>(payload)));
+        }
+    }
+
+    template<typename T>
+    void CommandBuffer::applyRemove(Registry& registry, Entity entity, void*) {
+        registry.remove<T>(entity);
+    }
 }
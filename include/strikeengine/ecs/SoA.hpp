@@ -0,0 +1,96 @@
+#pragma once
+
+#include "Component.hpp"
+#include <cstddef>
+#include <type_traits>
+
+namespace StrikeEngine {
+
+    /**
+     * @brief Opt-in structure-of-arrays layout for a numeric component.
+     *
+     * By default a component is stored as an array of structs. Specialising SoALayout for a
+     * component makes its pool store each scalar as a separate, 64-byte aligned array of
+     * doubles ("lanes"), so SIMD kernels can load several entities per instruction. The
+     * specialisation provides:
+     *  - `static constexpr size_t LANES`: the number of double lanes;
+     *  - `template<bool Const> class Ref`: a proxy deriving from SoASlot<Const> that exposes the
+     *    component's accessors over one entity's lanes, and converts to the component by value;
+     *  - `static void store(const Ref<false>& slot, const T& component)`.
+     *
+     * Views, groups and Registry::get hand out ComponentRef<T>, which is T& for ordinary
+     * components and the Ref proxy for SoA components.
+     */
+    template<typename T>
+    struct SoALayout;
+
+    template<typename T>
+    concept SoAComponent = Component<T> && requires { SoALayout<T>::LANES; };
+
+    /**
+     * @brief One entity's slot in a set of SoA lanes: lane k lives at slot[k * stride].
+     */
+    template<bool Const>
+    class SoASlot {
+    public:
+        using Pointer = std::conditional_t<Const, const double*, double*>;
+        using Reference = std::conditional_t<Const, const double&, double&>;
+
+        SoASlot(Pointer slot, size_t stride) : _slot(slot), _stride(stride) {}
+
+        // Read-only slots are made from writable ones.
+        template<bool OtherConst>
+            requires (Const && !OtherConst)
+        SoASlot(const SoASlot<OtherConst>& other) : _slot(other.data()), _stride(other.stride()) {}
+
+        /** @brief The value of lane k for this entity. */
+        [[nodiscard]] Reference lane(size_t k) const { return _slot[k * _stride]; }
+
+        [[nodiscard]] Pointer data() const { return _slot; }
+        [[nodiscard]] size_t stride() const { return _stride; }
+
+    private:
+        Pointer _slot;
+        size_t _stride;
+    };
+
+    /**
+     * @brief The dense lanes of an SoA pool, as returned by its data(). Index i is the entity
+     * at dense index i, exactly as for an array-of-structs pool.
+     */
+    template<typename T>
+    class SoAArray {
+    public:
+        using Ref = typename SoALayout<T>::template Ref<false>;
+
+        SoAArray(double* base, size_t stride) : _base(base), _stride(stride) {}
+
+        /** @brief The contiguous array of lane k, 64-byte aligned. */
+        [[nodiscard]] double* lane(size_t k) const { return _base + k * _stride; }
+
+        Ref operator[](size_t index) const { return Ref(_base + index, _stride); }
+
+    private:
+        double* _base;
+        size_t _stride;
+    };
+
+    template<typename C>
+    struct ComponentRefFor {
+        using type = C&;
+    };
+
+    template<typename C>
+        requires SoAComponent<std::remove_const_t<C>>
+    struct ComponentRefFor<C> {
+        using type = typename SoALayout<std::remove_const_t<C>>::template Ref<std::is_const_v<C>>;
+    };
+
+    /**
+     * @brief How a component is handed to callers: C& normally, or a proxy for SoA components.
+     * A const C gives read-only access.
+     */
+    template<typename C>
+    using ComponentRef = typename ComponentRefFor<C>::type;
+
+} // namespace StrikeEngine
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "strikeengine/ecs/SystemAccess.hpp"
+
 namespace StrikeEngine {
 	class Registry;
 }
@@ -7,9 +9,19 @@ namespace StrikeEngine {
 namespace StrikeEngine {
 	/**
 	 * @brief The base class for all systems in the engine.
+	 *
+	 * Derived systems shadow Reads, Writes and StructuralChanges to declare the components they
+	 * touch; SystemGraph schedules from those declarations (see SystemAccess).
 	 */
 	class System {
 	public:
+		/// Components the system only reads.
+		using Reads = ComponentList<>;
+		/// Components the system writes (and may read).
+		using Writes = ComponentList<>;
+		/// True if the system creates or destroys entities, or adds or removes components.
+		static constexpr bool StructuralChanges = false;
+
 		virtual ~System() = default;
 
 		/**
@@ -17,6 +29,6 @@ namespace StrikeEngine {
 		 * @param registry A reference to the ECS registry.
 		 * @param dt The time elapsed since the last frame (delta time).
 		 */
-		virtual void update(Registry& registry, double dt);
+		virtual void update(Registry& registry, double dt) = 0;
 	};
 } // namespace StrikeEngine
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "ComponentFamily.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace StrikeEngine {
+
+    /**
+     * @brief A compile-time list of component types. Systems use it to declare their access.
+     */
+    template<typename... Components>
+    struct ComponentList {};
+
+    /**
+     * @brief The component access a system declares, resolved to component family ids.
+     *
+     * A system lists the components it reads in `Reads` and the ones it writes in `Writes`
+     * (writing implies reading). Structural changes (creating or destroying entities, adding or
+     * removing components) normally go through Registry::commands() and need no declaration. A
+     * system that makes them directly sets `StructuralChanges`: it touches every pool and so
+     * conflicts with all other systems. SystemGraph orders any two conflicting systems by
+     * registration order and leaves everything else free to run in parallel.
+     *
+     * With STRIKEENGINE_CHECK_SYSTEM_ACCESS defined (Debug builds), the Registry checks views,
+     * groups, get/has lookups and structural changes made on a thread that is running a system
+     * against that system's declaration, and throws on an undeclared access. A non-const get
+     * needs write access. A job is checked against the system that submitted it, whichever thread
+     * runs it, so a parallelFor chunk stolen by another waiting system still answers to its own.
+     */
+    struct SystemAccess {
+        const char* system_name = "";
+        std::vector<size_t> reads;
+        std::vector<size_t> writes;
+        bool structural = false;
+
+        /**
+         * @brief Collects the declaration of system type T.
+         */
+        template<typename T>
+        static SystemAccess of() {
+            SystemAccess access;
+            access.system_name = typeid(T).name();
+            access.reads = familyIds(typename T::Reads{});
+            access.writes = familyIds(typename T::Writes{});
+            access.structural = T::StructuralChanges;
+            return access;
+        }
+
+        [[nodiscard]] bool canRead(size_t id) const {
+            return structural || std::ranges::binary_search(reads, id) || std::ranges::binary_search(writes, id);
+        }
+
+        [[nodiscard]] bool canWrite(size_t id) const {
+            return structural || std::ranges::binary_search(writes, id);
+        }
+
+        /**
+         * @brief True if running the two systems at the same time could race.
+         */
+        [[nodiscard]] bool conflictsWith(const SystemAccess& other) const {
+            if (structural || other.structural) {
+                return true;
+            }
+            return std::ranges::any_of(writes, [&](size_t id) { return other.canRead(id); }) ||
+                std::ranges::any_of(other.writes, [&](size_t id) { return canRead(id); });
+        }
+
+        /**
+         * @brief Marks the calling thread as running a system for the lifetime of the scope.
+         */
+        class Scope {
+        public:
+            explicit Scope(const SystemAccess& access) : Scope(&access) {}
+            // A null access suspends checking, as for a job submitted outside any system.
+            explicit Scope(const SystemAccess* access) : _previous(_current) { _current = access; }
+            ~Scope() { _current = _previous; }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            const SystemAccess* _previous;
+        };
+
+        /**
+         * @brief The system running on the calling thread, or null outside any system.
+         */
+        static const SystemAccess* current() { return _current; }
+
+        /**
+         * @brief Throws if the running system did not declare access to T. A const T needs read
+         * access, a non-const T needs write access.
+         */
+        template<typename T>
+        static void check() {
+            const SystemAccess* access = _current;
+            if (!access) {
+                return;
+            }
+            const size_t id = ComponentFamily::id<T>();
+            const bool allowed = std::is_const_v<T> ? access->canRead(id) : access->canWrite(id);
+            if (!allowed) {
+                throw std::runtime_error(std::string("SystemAccess: ") + access->system_name +
+                                         (std::is_const_v<T> ? " reads " : " writes ") +
+                                         "undeclared component " + typeid(T).name() + ".");
+            }
+        }
+
+        /**
+         * @brief Throws if the running system did not declare StructuralChanges.
+         */
+        static void checkStructural() {
+            const SystemAccess* access = _current;
+            if (access && !access->structural) {
+                throw std::runtime_error(std::string("SystemAccess: ") + access->system_name +
+                                         " changes entity structure without declaring StructuralChanges.");
+            }
+        }
+
+    private:
+        template<typename... Components>
+        static std::vector<size_t> familyIds(ComponentList<Components...>) {
+            std::vector<size_t> ids{ComponentFamily::id<Components>()...};
+            std::ranges::sort(ids);
+            return ids;
+        }
+
+        static inline thread_local const SystemAccess* _current = nullptr;
+    };
+
+} // namespace StrikeEngine
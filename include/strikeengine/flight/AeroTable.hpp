@@ -0,0 +1,293 @@
+#pragma once
+
+#include "strikeengine/flight/UniformAxis.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace StrikeEngine {
+
+    /** @brief The most axes an aerodynamic table may have: one per AeroParameter. */
+    inline constexpr size_t AERO_MAX_AXES = 6;
+
+    /** @brief The number of coefficients stored at every table point. */
+    inline constexpr size_t AERO_COEFFICIENT_COUNT = 6;
+
+    /**
+     * @brief A flight parameter an aerodynamic table axis can be indexed by.
+     * The values match the order of the AeroFlightCondition fields.
+     */
+    enum class AeroParameter : uint32_t {
+        Mach = 0,
+        Alpha = 1,
+        Beta = 2,
+        PitchDeflection = 3,
+        YawDeflection = 4,
+        Altitude = 5
+    };
+
+    /**
+     * @brief The flight state an aerodynamic table is looked up at.
+     *
+     * Angles are in the body frame (+Z forward, +Y up): alpha is positive with the nose above
+     * the air-relative velocity and beta is positive with the air arriving from the body's +X
+     * side. Deflections are the ControlSurfaceComponent fin angles. Altitude is in metres.
+     */
+    struct AeroFlightCondition {
+        double mach = 0.0;
+        double alpha_rad = 0.0;
+        double beta_rad = 0.0;
+        double pitch_deflection_rad = 0.0;
+        double yaw_deflection_rad = 0.0;
+        double altitude_m = 0.0;
+
+    private:
+        template<typename Self>
+        static auto& field(Self& self, AeroParameter parameter) {
+            switch (parameter) {
+                case AeroParameter::Mach: return self.mach;
+                case AeroParameter::Alpha: return self.alpha_rad;
+                case AeroParameter::Beta: return self.beta_rad;
+                case AeroParameter::PitchDeflection: return self.pitch_deflection_rad;
+                case AeroParameter::YawDeflection: return self.yaw_deflection_rad;
+                case AeroParameter::Altitude: return self.altitude_m;
+            }
+            std::unreachable();
+        }
+
+    public:
+        /** @brief The value of one parameter. */
+        [[nodiscard]] double value(AeroParameter parameter) const { return field(*this, parameter); }
+
+        /** @brief The field holding one parameter. */
+        [[nodiscard]] double& value(AeroParameter parameter) { return field(*this, parameter); }
+    };
+    // The batched lookup gathers parameters straight from arrays of conditions.
+    static_assert(sizeof(AeroFlightCondition) == AERO_MAX_AXES * sizeof(double));
+    static_assert(offsetof(AeroFlightCondition, altitude_m) ==
+                  static_cast<size_t>(AeroParameter::Altitude) * sizeof(double));
+
+    /**
+     * @brief A set of aerodynamic coefficients.
+     *
+     * Forces are in wind axes: lift and side force perpendicular to the air-relative velocity,
+     * drag along it. Moments are about the body axes, right-handed: roll about +Z (forward),
+     * pitch about +X and yaw about +Y (up).
+     */
+    struct AeroCoefficients {
+        double Cl = 0.0; // Lift coefficient
+        double Cd = 0.0; // Drag coefficient
+        double Cy = 0.0; // Side force coefficient, towards body +X
+        double Cr = 0.0; // Rolling moment coefficient
+        double Cm = 0.0; // Pitching moment coefficient
+        double Cn = 0.0; // Yawing moment coefficient
+
+    private:
+        template<typename Self>
+        static auto& field(Self& self, size_t k) {
+            switch (k) {
+                case 0: return self.Cl;
+                case 1: return self.Cd;
+                case 2: return self.Cy;
+                case 3: return self.Cr;
+                case 4: return self.Cm;
+                case 5: return self.Cn;
+            }
+            std::unreachable();
+        }
+
+    public:
+        /** @brief Coefficient k, in the order above. */
+        [[nodiscard]] double coefficient(size_t k) const { return field(*this, k); }
+
+        /** @brief The member holding coefficient k, in the order above. */
+        [[nodiscard]] double& coefficient(size_t k) { return field(*this, k); }
+    };
+    static_assert(sizeof(AeroCoefficients) == AERO_COEFFICIENT_COUNT * sizeof(double));
+
+    /**
+     * @brief How aerodynamic tables are compiled from breakpoint data.
+     */
+    struct AeroTableOptions {
+        /** @brief How far a breakpoint may sit from a grid point, as a fraction of the grid spacing. */
+        double breakpoint_tolerance = 1e-6;
+
+        /** @brief The most points a resampled axis may have. */
+        uint32_t max_axis_points = 1024;
+    };
+
+    /**
+     * @brief The breakpoints of one axis of source data, for compileAeroTable.
+     */
+    struct AeroAxisBreakpoints {
+        AeroParameter parameter;
+        std::vector<double> breakpoints;
+    };
+
+    /**
+     * @brief An N-dimensional (1 to AERO_MAX_AXES axes) multilinear table of AeroCoefficients.
+     *
+     * Every axis is a UniformAxis over one AeroParameter; parameters the table has no axis for
+     * do not affect it. The coefficients of all points are stored in one flat, cache-line
+     * aligned array, first axis slowest, so a lookup is index arithmetic per axis followed by
+     * a blend of the 2^N corners of the cell. The lookup and blend are compiled once per axis
+     * count, so the corner loop is fully unrolled. Values outside an axis take its edge value.
+     *
+     * A table either owns its values or views values held elsewhere, such as a mapped aero
+     * table file (see readAeroTable). Lookups are const and may run concurrently.
+     */
+    class AeroTable {
+    public:
+        /** @brief One table axis: the parameter it indexes and its grid. */
+        struct Axis {
+            AeroParameter parameter;
+            UniformAxis grid;
+        };
+
+        AeroTable() = default;
+
+        /**
+         * @brief Builds a table from its grid points.
+         * @param axes The axes, 1 to AERO_MAX_AXES of them, each over a different parameter.
+         * @param values The coefficients at every grid point, first axis slowest.
+         * @throws std::runtime_error If the axes are invalid or values has the wrong length.
+         */
+        AeroTable(std::span<const Axis> axes, std::span<const AeroCoefficients> values);
+
+        /**
+         * @brief Builds a table over values it does not own, without copying them.
+         * @param values As for the constructor; they must outlive the table.
+         * @throws std::runtime_error If the axes are invalid or values has the wrong length.
+         */
+        static AeroTable view(std::span<const Axis> axes, std::span<const AeroCoefficients> values);
+
+        [[nodiscard]] bool empty() const { return _axis_count == 0; }
+
+        [[nodiscard]] std::span<const Axis> axes() const { return {_axes.data(), _axis_count}; }
+
+        /** @brief The coefficients at every grid point, first axis slowest. */
+        [[nodiscard]] std::span<const AeroCoefficients> values() const {
+            return {reinterpret_cast<const AeroCoefficients*>(_values), _point_count};
+        }
+
+        /** @brief Whether every axis was compiled from its breakpoints without approximation. */
+        [[nodiscard]] bool isExact() const;
+
+        /** @brief Whether the table has an axis over a parameter. */
+        [[nodiscard]] bool hasAxis(AeroParameter parameter) const;
+
+        /**
+         * @brief The interpolated coefficients at a flight condition; zero if the table is empty.
+         */
+        [[nodiscard]] AeroCoefficients lookup(const AeroFlightCondition& condition) const;
+
+        /**
+         * @brief Batched lookup: out[i] receives the coefficients at conditions[i]. Several
+         * lookups run per SIMD instruction where the CPU supports it.
+         * @param out The results; must be at least as long as conditions.
+         */
+        void lookup(std::span<const AeroFlightCondition> conditions, std::span<AeroCoefficients> out) const;
+
+    private:
+        struct AlignedDelete {
+            void operator()(double* p) const { ::operator delete(p, std::align_val_t{64}); }
+        };
+
+        using LookupFn = AeroCoefficients (*)(const Axis* axes, const size_t* strides, const double* values,
+                                              const AeroFlightCondition& condition);
+        using BatchFn = size_t (*)(const Axis* axes, const size_t* strides, const double* values,
+                                   const AeroFlightCondition* conditions, AeroCoefficients* out, size_t count);
+
+        void setAxes(std::span<const Axis> axes, size_t valueCount);
+
+        std::array<Axis, AERO_MAX_AXES> _axes{};
+        size_t _axis_count = 0;
+        std::array<size_t, AERO_MAX_AXES> _strides{}; // In doubles, between neighbouring points along each axis
+        size_t _point_count = 0;
+        const double* _values = nullptr;
+        std::unique_ptr<double[], AlignedDelete> _storage; // The values, when the table owns them
+
+        // The kernels for this axis count; the batch kernel is null where SIMD is unavailable.
+        LookupFn _lookup = nullptr;
+        BatchFn _lookup_batch = nullptr;
+    };
+
+    /**
+     * @brief Compiles source data on arbitrary breakpoints into a table: each axis is resampled
+     * onto the coarsest uniform grid with a point on every breakpoint (see makeUniformAxis), by
+     * multilinear interpolation over the source points.
+     * @param values The coefficients at every source point, first axis slowest.
+     * @throws std::runtime_error If the breakpoints are invalid or values has the wrong length.
+     */
+    AeroTable compileAeroTable(std::span<const AeroAxisBreakpoints> axes, std::span<const AeroCoefficients> values,
+                               const AeroTableOptions& options = {});
+
+    /** @brief The first eight bytes of every aero table file. */
+    inline constexpr char AERO_TABLE_MAGIC[8] = {'S', 'E', 'A', 'E', 'R', 'O', 'T', 'B'};
+
+    /** @brief The format version this build reads and writes. */
+    inline constexpr uint32_t AERO_TABLE_VERSION = 2;
+
+    /** @brief The names and types of the AeroCoefficients fields, in declaration order. */
+    inline constexpr char AERO_TABLE_FIELDS[] = "cl:f64,cd:f64,cy:f64,cr:f64,cm:f64,cn:f64";
+
+    /** @brief The values start on a multiple of this many bytes, so a mapped table is cache-line aligned. */
+    inline constexpr uint64_t AERO_TABLE_ALIGNMENT = 64;
+
+    /**
+     * @brief One axis as stored in an aero table file.
+     */
+    struct AeroTableAxisRecord {
+        uint32_t parameter; // AeroParameter
+        uint32_t points;
+        double origin;
+        double spacing;
+        uint32_t exact;
+        uint32_t reserved;
+    };
+
+    /**
+     * @brief The header at the start of an aero table file. The values follow from data_offset:
+     * the AeroCoefficients of every point, first axis slowest.
+     */
+    struct AeroTableHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t header_size;
+        uint32_t axis_count;
+        uint32_t coefficient_count; // AERO_COEFFICIENT_COUNT
+        AeroTableAxisRecord axes[AERO_MAX_AXES];
+        uint64_t point_count;
+        uint64_t data_offset;       // sizeof(AeroTableHeader), rounded up to AERO_TABLE_ALIGNMENT
+        char fields[64];            // AERO_TABLE_FIELDS, zero padded
+        uint64_t checksum;          // aeroTableChecksum of the values
+    };
+
+    static_assert(sizeof(AERO_TABLE_FIELDS) <= sizeof(AeroTableHeader::fields));
+
+    /**
+     * @brief The 64-bit FNV-1a hash of the values, taken over their 8-byte words.
+     */
+    uint64_t aeroTableChecksum(std::span<const AeroCoefficients> values);
+
+    /**
+     * @brief Writes a table as an aero table file.
+     * @throws std::runtime_error If the table is empty or the file cannot be written.
+     */
+    void writeAeroTable(const std::string& filepath, const AeroTable& table);
+
+    /**
+     * @brief Validates an aero table file held in memory and returns a table viewing its values
+     * in place, so the bytes must outlive the table.
+     * @param bytes The whole file, aligned for double (as a mapping is).
+     * @throws std::runtime_error If the magic, version, layout, size or checksum is wrong.
+     */
+    AeroTable readAeroTable(std::span<const std::byte> bytes);
+
+} // namespace StrikeEngine
@@ -1,50 +1,74 @@
 #pragma once
 
+#include "strikeengine/flight/AeroTable.hpp"
+#include "strikeengine/core/MappedFile.hpp"
+#include <span>
 #include <string>
-#include <vector>
 
 namespace StrikeEngine {
 
-  /**
-   * @brief A struct to hold a set of aerodynamic coefficients.
-   */
-  struct AeroCoefficients {
-    double Cl = 0.0; // Lift coefficient
-    double Cd = 0.0; // Drag coefficient
-  };
-
   /**
    * @brief Loads and manages aerodynamic coefficient data from profiles.
    *
-   * This class reads aerodynamic lookup tables from a JSON file and provides
-   * a function to perform bilinear interpolation to find the coefficients
-   * for any given flight condition (Mach number and Angle of Attack).
+   * A profile is an AeroTable: up to six axes over Mach, alpha, beta, pitch and yaw fin
+   * deflection and altitude, with all six force and moment coefficients at every point. It is
+   * read from an aero table file (see writeAeroTable, and tools/CompileAeroProfile), which is
+   * mapped read-only and used in place: loading costs a header check and a checksum pass, and
+   * processes on one host share the table's pages.
+   *
+   * JSON profiles are the source CompileAeroProfile compiles, and are still accepted directly
+   * at the cost of parsing and compiling them on load (see compileAeroTable). They come in two
+   * forms:
+   * - Tables: "axes" lists {"parameter", "breakpoints"} objects, the parameter named as the
+   *   AeroFlightCondition field ("mach", "alpha_rad", ...), and "coefficients" maps "cl", "cd",
+   *   "cy", "cr", "cm" and "cn" to flat arrays over the breakpoints, first axis slowest.
+   *   Coefficients left out are zero.
+   * - Legacy profiles, which tabulate Cl and Cd against Mach and the angle of attack of an
+   *   axisymmetric airframe. They are mirrored to negative alpha with Cl odd and Cd even.
    */
   class AerodynamicsDatabase {
   public:
-    AerodynamicsDatabase() = default;
+    explicit AerodynamicsDatabase(const AeroTableOptions& options = {});
 
     /**
-     * @brief Loads an aerodynamic profile from a JSON file.
-     * @param filepath The path to the aero profile JSON.
+     * @brief Loads an aerodynamic profile: a legacy JSON profile if the path ends in ".json",
+     * an aero table file otherwise.
+     * @param filepath The path to the aero profile.
      * @return True if loading was successful, false otherwise.
      */
     bool loadProfile(const std::string& filepath);
 
     /**
      * @brief Gets the interpolated aerodynamic coefficients for a given flight state.
-     * @param mach The current Mach number.
-     * @param AoARad The current Angle of Attack in radians.
-     * @return An AeroCoefficients struct with the interpolated Cl and Cd values.
+     * @param condition The current flight condition.
+     * @return An AeroCoefficients struct with the interpolated coefficients.
+     */
+    [[nodiscard]] AeroCoefficients getCoefficients(const AeroFlightCondition& condition) const {
+      return _table.lookup(condition);
+    }
+
+    /**
+     * @brief Batched getCoefficients: out[i] receives the coefficients at conditions[i].
+     * Several lookups run per SIMD instruction where the CPU supports it.
+     * @param out The results; must be at least as long as conditions.
+     */
+    void getCoefficients(std::span<const AeroFlightCondition> conditions, std::span<AeroCoefficients> out) const {
+      _table.lookup(conditions, out);
+    }
+
+    /**
+     * @brief Whether the loaded tables were resampled without approximation.
      */
-    [[nodiscard]] AeroCoefficients getCoefficients(double mach, double AoARad) const;
+    [[nodiscard]] bool isExact() const { return _table.isExact(); }
+
+    [[nodiscard]] const AeroTable& table() const { return _table; }
 
   private:
-    std::vector<double> _machBreakpoints;
-    std::vector<double> _aoaBreakpointsRad;
+    bool loadJsonProfile(const std::string& filepath);
 
-    std::vector<std::vector<double>> _clTable;
-    std::vector<std::vector<double>> _cdTable;
+    AeroTableOptions _options;
+    MappedFile _file; // The aero table file the table views, when loaded from one
+    AeroTable _table;
   };
 
 } // namespace StrikeEngine
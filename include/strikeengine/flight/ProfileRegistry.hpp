@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace StrikeEngine {
+
+    class AerodynamicsDatabase;
+    class IRSignatureDatabase;
+    class RCSDatabase;
+
+    /**
+     * @brief An interned profile name. Equal names intern to the same ID for the life of the process.
+     */
+    enum class ProfileId : uint32_t {};
+
+    /**
+     * @brief The process-wide store of aerodynamic, RCS and IR signature databases.
+     *
+     * Each profile is loaded once per process, on its first request, and then lives unchanged
+     * until the process exits, shared by every Engine in it. Requests return a plain pointer that
+     * entities keep in their profile components from the moment the component is added (see
+     * EntityFactory and the components' onAdd hooks), so per-frame loops read their database
+     * directly: no name hashing, no lock. A profile that fails to load
+     * is remembered as missing (nullptr) and not retried.
+     *
+     * All members are thread-safe. Loading a profile holds the registry's lock, so requests
+     * belong at spawn time rather than in per-frame loops.
+     */
+    class ProfileRegistry {
+    public:
+        /** @brief The registry shared by the whole process. */
+        static ProfileRegistry& instance();
+
+        ProfileRegistry();
+        ~ProfileRegistry();
+
+        ProfileRegistry(const ProfileRegistry&) = delete;
+        ProfileRegistry& operator=(const ProfileRegistry&) = delete;
+
+        /** @brief The ID of a profile name, assigning a new one on first use. */
+        [[nodiscard]] ProfileId intern(std::string_view name);
+
+        /** @brief The name an ID was interned from. */
+        [[nodiscard]] const std::string& name(ProfileId id) const;
+
+        /**
+         * @brief The aerodynamic database of an aero profile ID: data/aero/<id>.aero, or the
+         * JSON profile where there is no compiled table.
+         * @return The database, or nullptr if the profile could not be loaded.
+         */
+        const AerodynamicsDatabase* aerodynamics(ProfileId id);
+        const AerodynamicsDatabase* aerodynamics(std::string_view profileId) { return aerodynamics(intern(profileId)); }
+
+        /**
+         * @brief The RCS database of an RCS profile path.
+         * @return The database, or nullptr if the profile could not be loaded.
+         */
+        const RCSDatabase* rcs(ProfileId path);
+        const RCSDatabase* rcs(std::string_view path) { return rcs(intern(path)); }
+
+        /**
+         * @brief The IR signature database of an IR signature profile path.
+         * @return The database, or nullptr if the profile could not be loaded.
+         */
+        const IRSignatureDatabase* infrared(ProfileId path);
+        const IRSignatureDatabase* infrared(std::string_view path) { return infrared(intern(path)); }
+
+    private:
+        template<typename Database, typename Loader>
+        const Database* resolve(std::unordered_map<ProfileId, std::unique_ptr<const Database>>& databases, ProfileId id,
+                                Loader&& load);
+
+        mutable std::shared_mutex _mutex;
+
+        // Interned names; a deque so the views keying _ids stay valid as names are added.
+        std::deque<std::string> _names;
+        std::unordered_map<std::string_view, ProfileId> _ids;
+
+        std::unordered_map<ProfileId, std::unique_ptr<const AerodynamicsDatabase>> _aerodynamics;
+        std::unordered_map<ProfileId, std::unique_ptr<const RCSDatabase>> _rcs;
+        std::unordered_map<ProfileId, std::unique_ptr<const IRSignatureDatabase>> _infrared;
+    };
+
+} // namespace StrikeEngine
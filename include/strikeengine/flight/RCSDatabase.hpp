@@ -1,16 +1,27 @@
 #pragma once
 
+#include "strikeengine/flight/UniformAxis.hpp"
+#include <span>
 #include <string>
 #include <vector>
 
 namespace StrikeEngine {
 
+    /**
+     * @brief An aspect-dependent radar cross-section table.
+     *
+     * The profile's dBsm table is resampled at load onto uniform azimuth and elevation grids
+     * (see makeUniformAxis) and stored as log2 of the RCS in m^2. Interpolating log2 values is
+     * the same as interpolating dBsm, so a lookup is index arithmetic on both axes, a bilinear
+     * blend and a single exp2, with no search and no pow.
+     */
     class RCSDatabase {
     public:
         /**
          * @brief Loads and parses an RCS profile from a JSON file.
          * @param file_path The path to the RCS JSON profile.
-         * @return True if loading was successful, false otherwise.
+         * @return True if loading was successful, false otherwise; a profile that fails to load
+         * leaves the previously loaded one in place.
          */
         bool loadProfile(const std::string& file_path);
 
@@ -22,15 +33,25 @@ namespace StrikeEngine {
          */
         [[nodiscard]] double getRCS(double azimuth_rad, double elevation_rad) const;
 
+        /**
+         * @brief Batched getRCS: out[i] receives the RCS at (azimuth_rad[i], elevation_rad[i]).
+         * Four aspects run per SIMD instruction where the CPU supports it.
+         * @param elevation_rad As long as azimuth_rad.
+         * @param out The results, in m^2; must be at least as long as azimuth_rad.
+         * @throws std::runtime_error If the spans are too short.
+         */
+        void getRCSBatch(std::span<const double> azimuth_rad, std::span<const double> elevation_rad,
+                         std::span<double> out) const;
+
     private:
         std::string _name;
 
-        // Breakpoints for the lookup table axes, stored in radians.
-        std::vector<double> _azimuth_breakpoints_rad;
-        std::vector<double> _elevation_breakpoints_rad;
+        // The lookup table axes, in radians.
+        UniformAxis _azimuth;
+        UniformAxis _elevation;
 
-        // The 2D table of RCS values in decibels relative to one square meter (dBsm).
-        std::vector<std::vector<double>> _rcs_table_dbsm;
+        // log2 of the RCS in m^2 at every grid point, elevation slowest; empty if nothing is loaded.
+        std::vector<double> _rcs_log2;
     };
 
 } // namespace StrikeEngine
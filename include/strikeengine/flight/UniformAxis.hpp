@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace StrikeEngine {
+
+    /**
+     * @brief A lookup-table axis with evenly spaced points, so a value's cell is found by index
+     * arithmetic instead of a search over the breakpoints.
+     */
+    struct UniformAxis {
+        double origin = 0.0;
+        double spacing = 1.0;
+        double inverse_spacing = 1.0;
+        uint32_t points = 0; // At least 2 once built
+
+        /** @brief Whether every source breakpoint lies on a point, so resampling lost nothing. */
+        bool exact = true;
+
+        /** @brief Where a value falls: the lower point of its cell and the fraction across it. */
+        struct Cell {
+            uint32_t index;
+            double fraction;
+        };
+
+        /** @brief The value of point i. */
+        [[nodiscard]] double at(uint32_t i) const { return origin + i * spacing; }
+
+        /**
+         * @brief The cell of a value, clamped to the axis; NaN maps to the first point.
+         */
+        [[nodiscard]] Cell locate(double value) const;
+    };
+
+    /**
+     * @brief Builds the coarsest uniform axis that has a point on every breakpoint.
+     *
+     * Breakpoints within tolerance (a fraction of the spacing) of a point count as on it. If no
+     * axis of at most maxPoints points fits, the axis gets maxPoints points and exact = false:
+     * the resampled table then rounds the corners at breakpoints off the grid. A single
+     * breakpoint gives a two-point axis whose points carry the same values.
+     * @throws std::runtime_error If there are no breakpoints or they do not strictly ascend.
+     */
+    UniformAxis makeUniformAxis(std::span<const double> breakpoints, double tolerance, uint32_t maxPoints);
+
+    /**
+     * @brief The cell of a value among arbitrary ascending breakpoints, clamped to their range.
+     * A binary search: for resampling source tables onto a UniformAxis, not for lookups.
+     */
+    UniformAxis::Cell locateBreakpoint(std::span<const double> breakpoints, double value);
+
+} // namespace StrikeEngine
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "strikeengine/ecs/Entity.hpp"
+#include "strikeengine/flight/ProfileRegistry.hpp"
 #include <string>
 
 namespace StrikeEngine {
@@ -19,8 +20,9 @@ namespace StrikeEngine {
         /**
          * @brief Constructs the factory with a reference to the ECS registry.
          * @param registry The registry where new entities will be created.
+         * @param profiles Where the aerodynamic, RCS and IR databases of new entities are resolved.
          */
-        explicit EntityFactory(Registry& registry);
+        explicit EntityFactory(Registry& registry, ProfileRegistry& profiles = ProfileRegistry::instance());
 
         /**
          * @brief Creates a single entity from a JSON profile file.
@@ -32,6 +34,7 @@ namespace StrikeEngine {
 
     private:
         Registry& _registry;
+        ProfileRegistry& _profiles;
     };
 
 } // namespace StrikeEngine
@@ -3,8 +3,19 @@
 #include "strikeengine/ecs/System.hpp"
 
 namespace StrikeEngine {
+    struct AutopilotCommandComponent;
+    struct AutopilotStateComponent;
+    struct ControlSurfaceComponent;
+    struct NavigationStateComponent;
+    struct TransformComponent;
+    struct VelocityComponent;
+
     class ControlSystem final : public System {
     public:
+        using Reads = ComponentList<AutopilotCommandComponent, NavigationStateComponent, TransformComponent,
+                                    VelocityComponent>;
+        using Writes = ComponentList<AutopilotStateComponent, ControlSurfaceComponent>;
+
         /**
          * @brief Executes the autopilot logic for one time step.
          * @param registry The ECS registry containing all entities and components.
@@ -5,8 +5,16 @@
 
 namespace StrikeEngine {
 
+    struct AntennaComponent;
+    struct CountermeasureDispenserComponent;
+    struct JammerComponent;
+    struct TransformComponent;
+
     class ElectronicWarfareSystem final : public System {
     public:
+        using Reads = ComponentList<JammerComponent, TransformComponent>;
+        using Writes = ComponentList<AntennaComponent, CountermeasureDispenserComponent>;
+
         void update(Registry& registry, double dt) override;
     };
 
@@ -5,8 +5,16 @@
 
 namespace StrikeEngine {
 
+    struct FuzeComponent;
+    struct SeekerComponent;
+    struct TransformComponent;
+    struct WarheadComponent;
+
     class EndgameSystem final : public System {
     public:
+        using Reads = ComponentList<FuzeComponent, SeekerComponent, TransformComponent>;
+        using Writes = ComponentList<WarheadComponent>;
+
         void update(Registry& registry, double dt) override;
     };
 
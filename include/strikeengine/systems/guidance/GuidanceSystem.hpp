@@ -5,12 +5,32 @@
 #include <glm/glm.hpp>
 
 namespace StrikeEngine {
+    class JobSystem;
+
+    struct AutopilotCommandComponent;
+    struct GuidanceComponent;
+    struct NavigationStateComponent;
+    struct SeekerComponent;
+    struct TransformComponent;
+    struct VelocityComponent;
 
     class GuidanceSystem final : public System {
     public:
+        using Reads = ComponentList<GuidanceComponent, SeekerComponent, NavigationStateComponent, TransformComponent,
+                                    VelocityComponent>;
+        using Writes = ComponentList<AutopilotCommandComponent>;
+
+        /**
+         * @brief Constructs the system.
+         * @param jobSystem The job system used to spread the entity loop over worker threads.
+         */
+        explicit GuidanceSystem(JobSystem& jobSystem);
+
         void update(Registry& registry, double dt) override;
 
     private:
+        JobSystem& _job_system;
+
 
         /**
          * @brief Calculates the acceleration command using Proportional Navigation (PN).
@@ -14,8 +14,18 @@ namespace StrikeEngine {
     using KalmanCovarianceMatrix = std::array<std::array<double, 6>, 6>;
 
 
+    struct ForceAccumulatorComponent;
+    struct GPSComponent;
+    struct IMUComponent;
+    struct MassComponent;
+    struct NavigationStateComponent;
+    struct TransformComponent;
+
     class NavigationSystem final : public System {
     public:
+        using Reads = ComponentList<IMUComponent, TransformComponent, ForceAccumulatorComponent, MassComponent>;
+        using Writes = ComponentList<NavigationStateComponent, GPSComponent>;
+
         NavigationSystem();
         void update(Registry& registry, double dt) override;
 
@@ -3,19 +3,20 @@
 #include "strikeengine/ecs/System.hpp"
 #include "strikeengine/ecs/Registry.hpp"
 #include "strikeengine/flight/RCSDatabase.hpp"
-#include <string>
-#include <memory>
-#include <unordered_map>
 
 namespace StrikeEngine {
 
+    struct AntennaComponent;
+    struct RCSProfileComponent;
+    struct SeekerComponent;
+    struct TransformComponent;
+
     class RadarSystem final : public System {
     public:
-        void update(Registry& registry, double dt) override;
+        using Reads = ComponentList<AntennaComponent, TransformComponent, RCSProfileComponent>;
+        using Writes = ComponentList<SeekerComponent>;
 
-    private:
-        // cache
-        std::unordered_map<std::string, std::unique_ptr<RCSDatabase>> _rcs_database_cache;
+        void update(Registry& registry, double dt) override;
     };
 
 } // namespace StrikeEngine
@@ -4,18 +4,21 @@
 #include "strikeengine/ecs/Registry.hpp"
 #include "strikeengine/flight/RCSDatabase.hpp"
 #include "strikeengine/flight/IRSignatureDatabase.hpp"
-#include <string>
-#include <memory>
-#include <unordered_map>
 
 namespace StrikeEngine {
+    struct AntennaComponent;
+    struct InfraredSeekerComponent;
+    struct InfraredSignatureComponent;
+    struct RCSProfileComponent;
+    struct SeekerComponent;
+    struct TransformComponent;
+
     class SensorSystem final : public System {
     public:
-        void update(Registry& registry, double dt) override;
+        using Reads = ComponentList<AntennaComponent, InfraredSeekerComponent, TransformComponent, RCSProfileComponent,
+                                    InfraredSignatureComponent>;
+        using Writes = ComponentList<SeekerComponent>;
 
-    private:
-        // Caches to store loaded databases to avoid reading files every frame.
-        std::unordered_map<std::string, std::unique_ptr<RCSDatabase>> _rcs_database_cache;
-        std::unordered_map<std::string, std::unique_ptr<IRSignatureDatabase>> _ir_database_cache;
+        void update(Registry& registry, double dt) override;
     };
 } // namespace StrikeEngine
@@ -1,23 +1,52 @@
 #pragma once
 
 #include "strikeengine/ecs/System.hpp"
-#include <string>
-#include <map>
-#include <memory>
+#include <glm/glm.hpp>
+#include <vector>
 
 namespace StrikeEngine {
 	class Registry;
 	class AtmosphereManager;
-	class AerodynamicsDatabase;
+	class JobSystem;
+	class WeatherField;
 }
 
 namespace StrikeEngine {
+	struct AerodynamicProfileComponent;
+	struct ControlSurfaceComponent;
+	struct ForceAccumulatorComponent;
+	struct MassComponent;
+	struct TransformComponent;
+	struct VelocityComponent;
+
 	/**
-	 * @brief Calculates and applies aerodynamic forces (lift and drag) to entities.
+	 * @brief Calculates and applies aerodynamic forces and moments to entities.
+	 *
+	 * Coefficients are looked up at each entity's Mach number, angle of attack, sideslip,
+	 * altitude above the Earth's reference sphere (the weather field's, or its default radius
+	 * without one) and, for entities with a ControlSurfaceComponent, fin deflections. A table with
+	 * no sideslip axis, such as a legacy profile, describes an axisymmetric airframe: it is looked
+	 * up at the total angle between the body axis and the airflow, and its lift acts in the plane
+	 * of that angle, so a sideslip turns the lift sideways rather than reading the table at alpha 0.
+	 *
+	 * With a loaded WeatherField, forces follow each entity's velocity relative to the local
+	 * wind, and density and speed of sound come from the field. Without one the air is still
+	 * and the standard atmosphere applies.
 	 */
 	class AerodynamicsSystem final : public System {
 	public:
-		explicit AerodynamicsSystem(const AtmosphereManager& atmosphereManager);
+		using Reads = ComponentList<TransformComponent, VelocityComponent, MassComponent, ControlSurfaceComponent>;
+		using Writes = ComponentList<ForceAccumulatorComponent, AerodynamicProfileComponent>;
+
+		/**
+		 * @brief Constructs the system.
+		 * @param atmosphereManager The standard atmosphere, used where there is no weather field.
+		 * @param jobSystem The job system used to spread the entity loop over worker threads.
+		 * @param weatherField The wind, temperature and density field, if any. The system
+		 * prefetches its tiles each frame, so nothing else may use it while the system runs.
+		 */
+		AerodynamicsSystem(const AtmosphereManager& atmosphereManager, JobSystem& jobSystem,
+		                   WeatherField* weatherField = nullptr);
 
 		~AerodynamicsSystem() override;
 
@@ -26,7 +55,11 @@ namespace StrikeEngine {
 
 	private:
 		const AtmosphereManager& _atmosphere_manager;
+		JobSystem& _job_system;
+		WeatherField* _weather_field;
 
-		std::map<std::string, std::unique_ptr<AerodynamicsDatabase>> _aeroDatabases;
+		// Simulation time the weather field is sampled at, advanced by each update.
+		double _time_s = 0.0;
+		std::vector<glm::dvec3> _positions; // Member positions for the weather prefetch
 	};
 } // namespace StrikeEngine
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "strikeengine/core/Simd.hpp"
+#include <glm/glm.hpp>
+#include <cstddef>
+
+namespace StrikeEngine {
+
+    /**
+     * @brief The Earth gravity model used by GravitySystem.
+     *
+     * Point-mass gravity, optionally with the J2 zonal harmonic that accounts for the Earth's
+     * oblateness. J2 matters for long-range ballistic flights: it shifts the impact point by
+     * kilometres over intercontinental ranges, and is negligible over short tactical ones.
+     */
+    struct GravityModel {
+        /** @brief Standard gravitational parameter GM, m^3/s^2 (G * 5.97219e24 kg). */
+        double mu = 6.67430e-11 * 5.97219e24;
+
+        /** @brief Enables the J2 oblateness term. */
+        bool j2_enabled = false;
+
+        /** @brief Second zonal harmonic coefficient (EGM96). */
+        double j2 = 1.08262668e-3;
+
+        /** @brief Equatorial radius the J2 coefficient is referenced to, m (WGS 84). */
+        double equatorial_radius_m = 6378137.0;
+
+        /** @brief Unit vector along the Earth's rotation axis in the simulation frame (Y-up). */
+        glm::dvec3 polar_axis{0.0, 1.0, 0.0};
+    };
+
+    /**
+     * @brief A block of entities for the batched gravity kernel, as structure-of-arrays.
+     *
+     * The kernel reads the positions and masses and adds the gravitational force to fx/fy/fz.
+     * Entities closer than 1 m to the Earth's centre are left untouched.
+     */
+    struct GravityBatch {
+        const double* x;
+        const double* y;
+        const double* z;
+        const double* mass;
+        double* fx;
+        double* fy;
+        double* fz;
+        size_t count;
+    };
+
+    /**
+     * @brief Adds the gravitational force on every entity of the batch, using detectSimdLevel().
+     */
+    void accumulateGravity(const GravityModel& model, const GravityBatch& batch);
+
+    /**
+     * @brief As above, with an explicit SIMD level, capped at detectSimdLevel().
+     */
+    void accumulateGravity(const GravityModel& model, const GravityBatch& batch, SimdLevel level);
+
+} // namespace StrikeEngine
@@ -1,30 +1,51 @@
 #pragma once
 
 #include "strikeengine/ecs/System.hpp"
+#include "strikeengine/systems/physics/GravityKernel.hpp"
 
 namespace StrikeEngine {
 
     // Forward-declare Registry to avoid including the full header here.
     class Registry;
+    class JobSystem;
+
+    struct ForceAccumulatorComponent;
+    struct MassComponent;
+    struct TransformComponent;
 
     /**
      * @brief Applies gravitational force to all physical entities.
      *
      * This system calculates gravity based on the universal law of gravitation,
-     * accounting for changes in force due to altitude. It assumes a simplified,
-     * non-rotating spherical Earth model.
+     * accounting for changes in force due to altitude. It assumes a non-rotating
+     * Earth: a point mass by default, optionally with the J2 oblateness term (see
+     * GravityModel).
      *
      * The calculated gravitational force is added to each entity's
-     * ForceAccumulatorComponent each tick.
+     * ForceAccumulatorComponent each tick, by the batched SIMD kernel in GravityKernel.
      */
     class GravitySystem final : public System {
     public:
+        using Reads = ComponentList<TransformComponent, MassComponent>;
+        using Writes = ComponentList<ForceAccumulatorComponent>;
+
+        /**
+         * @brief Constructs the system.
+         * @param jobSystem The job system used to spread the entity loop over worker threads.
+         * @param model The gravity model; point-mass Earth by default.
+         */
+        explicit GravitySystem(JobSystem& jobSystem, const GravityModel& model = {});
+
         /**
          * @brief Updates the system, applying gravitational force to all relevant entities.
          * @param registry A reference to the ECS registry to access components.
          * @param dt The time elapsed since the last frame (delta time), in seconds.
          */
         void update(Registry& registry, double dt) override;
+
+    private:
+        JobSystem& _job_system;
+        GravityModel _model;
     };
 
 } // namespace StrikeEngine
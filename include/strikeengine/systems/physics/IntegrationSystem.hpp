@@ -1,32 +1,69 @@
 #pragma once
 
 #include "strikeengine/ecs/System.hpp"
+#include "strikeengine/systems/physics/GravityKernel.hpp"
+#include "strikeengine/systems/physics/RigidBodyIntegrator.hpp"
+
+#include <optional>
 
 namespace StrikeEngine {
     class Registry;
+    class JobSystem;
 }
 
 namespace StrikeEngine {
 
+    struct AdaptiveStepComponent;
+    struct ForceAccumulatorComponent;
+    struct InertiaComponent;
+    struct MassComponent;
+    struct TransformComponent;
+    struct VelocityComponent;
+
     /**
      * @brief Integrates forces and torques to update entity position and orientation.
      *
-     * This is the final system in the physics pipeline for a given tick. It uses the
-     * total accumulated forces and torques to calculate linear and angular acceleration.
-     * It then employs a fourth-order Runge-Kutta (RK4) integrator to update the
-     * kinematic state (position, velocity, orientation) of each physical entity.
+     * This is the final system in the physics pipeline for a given tick. Rigid bodies are
+     * gathered into SoA batches and advanced with RigidBodyIntegrator, a fourth-order
+     * Runge-Kutta (RK4) integrator over the full 13-element state: position, velocity,
+     * orientation quaternion and body rates. Bodies with an AdaptiveStepComponent are instead
+     * integrated with adaptive Dormand-Prince 5(4), sub-stepping inside the frame as their own
+     * error estimate demands.
+     *
+     * The accumulated force and torque (world frame) are held over the step, except for
+     * gravity: when a gravity model is given, gravity is re-evaluated at every RK4 stage.
+     * This requires the accumulator to hold gravity from the same model at the start-of-step
+     * position, as GravitySystem adds it; the integrator swaps that for the stage value.
      *
      * After integration, it clears the ForceAccumulatorComponent for all entities,
      * preparing them for the next simulation tick.
      */
     class IntegrationSystem final : public System {
     public:
+        using Reads = ComponentList<MassComponent, InertiaComponent>;
+        using Writes = ComponentList<TransformComponent, VelocityComponent, ForceAccumulatorComponent, AdaptiveStepComponent>;
+
+        /**
+         * @brief Constructs the system.
+         * @param jobSystem The job system used to spread the entity loop over worker threads.
+         * @param gravity The model GravitySystem uses, to re-evaluate gravity at every stage.
+         * Without it all accumulated forces are held constant over the step.
+         * @param stepControl The error control for bodies with an AdaptiveStepComponent.
+         */
+        explicit IntegrationSystem(JobSystem& jobSystem, std::optional<GravityModel> gravity = std::nullopt,
+                                   const AdaptiveStepControl& stepControl = {});
+
         /**
          * @brief Updates the system, integrating the physics state for all relevant entities.
          * @param registry A reference to the ECS registry to access components.
          * @param dt The time elapsed since the last frame (delta time), in seconds.
          */
         void update(Registry& registry, double dt) override;
+
+    private:
+        JobSystem& _job_system;
+        std::optional<GravityModel> _gravity;
+        AdaptiveStepControl _step_control;
     };
 
 } // namespace StrikeEngine
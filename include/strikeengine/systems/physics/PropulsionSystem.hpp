@@ -18,23 +18,34 @@
 // Forward declaration
 namespace StrikeEngine {
     class AtmosphereManager;
+    class JobSystem;
 }
 
 namespace StrikeEngine {
 
+    struct ForceAccumulatorComponent;
+    struct MassComponent;
+    struct PropulsionComponent;
+    struct TransformComponent;
+
     class PropulsionSystem final : public System {
     public:
+        using Reads = ComponentList<TransformComponent>;
+        using Writes = ComponentList<PropulsionComponent, ForceAccumulatorComponent, MassComponent>;
+
         /**
          * @brief Constructs the system, requiring an atmosphere manager.
          * @param atmosphereManager A reference to the simulation's atmosphere manager.
+         * @param jobSystem The job system used to spread the entity loop over worker threads.
          */
-        explicit PropulsionSystem(const AtmosphereManager& atmosphereManager);
+        PropulsionSystem(const AtmosphereManager& atmosphereManager, JobSystem& jobSystem);
         ~PropulsionSystem() override;
 
         void update(Registry& registry, double dt) override;
 
     private:
         const AtmosphereManager& _atmosphere_manager;
+        JobSystem& _job_system;
     };
 
 } // namespace StrikeEngine
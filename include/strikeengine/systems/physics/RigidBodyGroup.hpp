@@ -0,0 +1,29 @@
+#pragma once
+
+#include "strikeengine/ecs/Registry.hpp"
+#include "strikeengine/components/transform/TransformComponent.hpp"
+#include "strikeengine/components/physics/VelocityComponent.hpp"
+#include "strikeengine/components/physics/MassComponent.hpp"
+#include "strikeengine/components/physics/ForceAccumulatorComponent.hpp"
+
+namespace StrikeEngine {
+
+    /**
+     * @brief Returns the owning group shared by the physics hot path.
+     *
+     * Gravity, Aerodynamics and Integration all join Transform, Velocity, Mass and
+     * ForceAccumulator. The group keeps those four pools sorted so that every rigid
+     * body sits at the same dense index in each of them, and the physics loops become
+     * linear sweeps over parallel arrays. Callbacks receive the owned components in
+     * that order, followed by any extra components.
+     *
+     * @param registry The registry that owns the group.
+     * @param extra Non-owned components the caller additionally requires.
+     */
+    template<typename... Extra>
+    auto rigidBodyGroup(Registry& registry, Get<Extra...> extra = {})
+    {
+        return registry.group<TransformComponent, VelocityComponent, MassComponent, ForceAccumulatorComponent>(extra);
+    }
+
+} // namespace StrikeEngine
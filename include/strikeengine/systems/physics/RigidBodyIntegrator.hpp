@@ -0,0 +1,192 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace StrikeEngine {
+
+    /**
+     * @brief A block of rigid bodies in structure-of-arrays form, as integrated by RigidBodyIntegrator.
+     *
+     * Each quantity is a contiguous lane of doubles; lane(k)[i] is scalar k of body i. The first
+     * STATE_LANES lanes are the 13-element rigid-body state:
+     *  - POSITION: world position, m;
+     *  - VELOCITY: world linear velocity, m/s;
+     *  - ORIENTATION: the body-to-world quaternion as w, x, y, z;
+     *  - ANGULAR_VELOCITY: body-frame angular velocity, rad/s.
+     *
+     * The mass properties are constant over a step. FORCE and TORQUE are world-frame and are
+     * written by the force function at every stage. TIME holds the time of each body's state
+     * lanes in seconds from the start of the integration call, and STEP the suggested step size
+     * for adaptive integration. BODY holds each body's index in the caller's batch, so a force
+     * function handed a reordered working copy can still find per-body data.
+     */
+    class RigidBodyBatch {
+    public:
+        static constexpr size_t POSITION = 0;
+        static constexpr size_t VELOCITY = 3;
+        static constexpr size_t ORIENTATION = 6;
+        static constexpr size_t ANGULAR_VELOCITY = 10;
+        static constexpr size_t STATE_LANES = 13;
+
+        static constexpr size_t MASS = 13;
+        static constexpr size_t INVERSE_MASS = 14;
+        static constexpr size_t INERTIA = 15;         // Body-frame tensor, 9 lanes, column-major
+        static constexpr size_t INVERSE_INERTIA = 24; // 9 lanes, column-major
+        static constexpr size_t FORCE = 33;
+        static constexpr size_t TORQUE = 36;
+        static constexpr size_t TIME = 39;
+        static constexpr size_t STEP = 40;
+        static constexpr size_t BODY = 41;
+        static constexpr size_t LANES = 42;
+
+        /**
+         * @brief Sets the number of bodies. Shrinking keeps the first count bodies; after
+         * growing, lane contents are unspecified.
+         */
+        void resize(size_t count);
+
+        [[nodiscard]] size_t size() const { return _count; }
+
+        /** @brief Distance between consecutive lanes, in doubles; at least size(). */
+        [[nodiscard]] size_t stride() const { return _stride; }
+
+        [[nodiscard]] double* lane(size_t k) { return _lanes.data() + k * _stride; }
+        [[nodiscard]] const double* lane(size_t k) const { return _lanes.data() + k * _stride; }
+
+        void setState(size_t i, const glm::dvec3& position, const glm::dvec3& velocity,
+                      const glm::dquat& orientation, const glm::dvec3& angularVelocity);
+
+        /**
+         * @brief Sets the mass properties of body i. The inverses are taken as given, so a
+         * body with zero inverse mass and inverse inertia does not accelerate.
+         */
+        void setMassProperties(size_t i, double mass, double inverseMass,
+                               const glm::dmat3& inertia, const glm::dmat3& inverseInertia);
+
+        void setForce(size_t i, const glm::dvec3& force, const glm::dvec3& torque);
+
+        /** @brief Copies every lane of body `from` in source into body `to` of this batch. */
+        void copyBody(size_t to, const RigidBodyBatch& source, size_t from);
+
+        [[nodiscard]] glm::dvec3 position(size_t i) const { return loadVec3(POSITION, i); }
+        [[nodiscard]] glm::dvec3 velocity(size_t i) const { return loadVec3(VELOCITY, i); }
+        [[nodiscard]] glm::dvec3 angularVelocity(size_t i) const { return loadVec3(ANGULAR_VELOCITY, i); }
+        [[nodiscard]] glm::dquat orientation(size_t i) const;
+
+    private:
+        [[nodiscard]] glm::dvec3 loadVec3(size_t first, size_t i) const {
+            return {lane(first)[i], lane(first + 1)[i], lane(first + 2)[i]};
+        }
+
+        void storeVec3(size_t first, size_t i, const glm::dvec3& value) {
+            lane(first)[i] = value.x;
+            lane(first + 1)[i] = value.y;
+            lane(first + 2)[i] = value.z;
+        }
+
+        std::vector<double> _lanes;
+        size_t _count = 0;
+        size_t _stride = 0;
+    };
+
+    /**
+     * @brief Error control for RigidBodyIntegrator::integrateAdaptive.
+     *
+     * A step is accepted when, for every state element, the embedded error estimate is within
+     * absolute + relative * |state|. The absolute tolerances are per state group.
+     */
+    struct AdaptiveStepControl {
+        double relative_tolerance = 1e-7;
+        double position_tolerance_m = 1e-2;
+        double velocity_tolerance_mps = 1e-4;
+        double orientation_tolerance = 1e-8;
+        double angular_velocity_tolerance_rps = 1e-6;
+
+        /** @brief Steps are never shortened below this; a step this short is always accepted. */
+        double min_step_s = 1e-5;
+        double max_step_s = 10.0;
+
+        /** @brief Step size change per step: safety * err^(-1/5), clamped to these factors. */
+        double safety = 0.9;
+        double min_factor = 0.2;
+        double max_factor = 5.0;
+    };
+
+    /**
+     * @brief Integrator for the full 6-DOF rigid-body equations of motion.
+     *
+     * Integrates the 13-element state of every body in a RigidBodyBatch:
+     *  - dp/dt = v
+     *  - dv/dt = F / m
+     *  - dq/dt = q * (0, w) / 2
+     *  - dw/dt = I^-1 (tau_body - w x I w)
+     *
+     * Forces and torques are re-evaluated at every stage through a force function, so
+     * state-dependent forces such as gravity are integrated to full order. Each stage runs as
+     * lane-wise loops over the batch, which the compiler vectorises. The integrator keeps its
+     * stage buffers between steps; use one instance per thread.
+     *
+     * Two schemes are provided: classic fixed-step RK4, and adaptive Dormand-Prince 5(4) with
+     * per-body step sizes, for bodies whose dynamics vary from benign cruise to the endgame.
+     */
+    class RigidBodyIntegrator {
+    public:
+        /**
+         * @brief Writes the FORCE and TORQUE lanes for the batch's current state and TIME lanes.
+         *
+         * The batch passed in may be a working copy holding a subset of the bodies, in any
+         * order; the BODY lane maps them back to the caller's batch.
+         */
+        using ForceFunction = std::function<void(RigidBodyBatch& batch)>;
+
+        /**
+         * @brief Advances every body in the batch by dt with classic fourth-order Runge-Kutta.
+         * Orientations are renormalised at the end of the step.
+         */
+        void stepRK4(RigidBodyBatch& batch, double dt, const ForceFunction& forces);
+
+        /**
+         * @brief Advances every body in the batch by duration with adaptive Dormand-Prince 5(4).
+         *
+         * Each body sub-steps independently, starting from the step in its STEP lane (the whole
+         * duration if not positive), and only bodies that still have time left take part in a
+         * sub-step. On return STEP holds the step size to start the next call with, and
+         * acceptedSteps()/rejectedSteps() report how each body fared.
+         */
+        void integrateAdaptive(RigidBodyBatch& batch, double duration, const ForceFunction& forces,
+                               const AdaptiveStepControl& control);
+
+        /** @brief Sub-steps body i accepted in the last integrateAdaptive call. */
+        [[nodiscard]] uint32_t acceptedSteps(size_t i) const { return _accepted[i]; }
+
+        /** @brief Sub-steps body i rejected and retried in the last integrateAdaptive call. */
+        [[nodiscard]] uint32_t rejectedSteps(size_t i) const { return _rejected[i]; }
+
+        /**
+         * @brief Computes the state derivative of every body from the batch's state and force lanes.
+         * @param out STATE_LANES lanes of batch.stride() doubles each.
+         */
+        static void derivative(const RigidBodyBatch& batch, double* out);
+
+    private:
+        std::vector<double> _initial;
+        std::vector<double> _slope;
+        std::vector<double> _sum;
+
+        // Adaptive integration: the working copy of the bodies still sub-stepping, the seven
+        // stage derivatives, and per-body time, step and error.
+        RigidBodyBatch _work;
+        std::vector<double> _stages;
+        std::vector<double> _elapsed;
+        std::vector<double> _taken;
+        std::vector<double> _error;
+        std::vector<uint32_t> _accepted;
+        std::vector<uint32_t> _rejected;
+    };
+
+} // namespace StrikeEngine
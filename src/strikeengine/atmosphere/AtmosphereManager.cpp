@@ -1,24 +1,95 @@
 #include "strikeengine/atmosphere/AtmosphereManager.hpp"
-#include <fstream>
+#include "strikeengine/atmosphere/AtmosphereTable.hpp"
+#include "strikeengine/core/Simd.hpp"
 #include <stdexcept>
 #include <cmath>
 #include <algorithm>
+#include <cstddef>
+
+#if STRIKEENGINE_SIMD_X86
+#include <immintrin.h>
+#endif
 
 namespace StrikeEngine {
 
+    namespace {
+        AtmosphereProperties interpolate(const AtmosphereProperties& low, const AtmosphereProperties& high,
+                                         double fraction, double altitude) {
+            AtmosphereProperties interpolated{};
+            interpolated.altitude = altitude;
+            interpolated.temperature = low.temperature + fraction * (high.temperature - low.temperature);
+            interpolated.pressure = low.pressure + fraction * (high.pressure - low.pressure);
+            interpolated.density = low.density + fraction * (high.density - low.density);
+            interpolated.speedOfSound = low.speedOfSound + fraction * (high.speedOfSound - low.speedOfSound);
+            return interpolated;
+        }
+
+#if STRIKEENGINE_SIMD_X86
+        // Looks up whole blocks of four altitudes on an evenly spaced table and returns the
+        // number done. Row indices and fractions are computed in vector registers and each
+        // column is fetched with a gather straight from the array of structs.
+        __attribute__((target("avx2,fma")))
+        size_t lookupUniformAvx2(std::span<const AtmosphereProperties> table, double inverse_spacing,
+                                 const double* altitudes, AtmosphereProperties* out, size_t count) {
+            constexpr int STRIDE = sizeof(AtmosphereProperties) / sizeof(double);
+            const double* columns = reinterpret_cast<const double*>(table.data());
+            const __m256d base = _mm256_set1_pd(table.front().altitude);
+            const __m256d top = _mm256_set1_pd(table.back().altitude);
+            const __m256d scale = _mm256_set1_pd(inverse_spacing);
+            const __m256d last_row = _mm256_set1_pd(static_cast<double>(table.size() - 1));
+            const __m256d last_interval = _mm256_set1_pd(static_cast<double>(table.size() - 2));
+            const __m128i stride = _mm_set1_epi32(STRIDE);
+
+            alignas(32) double lanes[STRIDE][4];
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                const __m256d altitude = _mm256_min_pd(_mm256_max_pd(_mm256_loadu_pd(altitudes + i), base), top);
+                const __m256d position = _mm256_min_pd(_mm256_mul_pd(_mm256_sub_pd(altitude, base), scale), last_row);
+                const __m256d row = _mm256_min_pd(_mm256_floor_pd(position), last_interval);
+                const __m256d fraction = _mm256_sub_pd(position, row);
+                const __m128i offset = _mm_mullo_epi32(_mm256_cvttpd_epi32(row), stride);
+
+                _mm256_store_pd(lanes[0], altitude);
+                for (int column = 1; column < STRIDE; ++column) {
+                    const __m256d low = _mm256_i32gather_pd(columns + column, offset, 8);
+                    const __m256d high = _mm256_i32gather_pd(columns + STRIDE + column, offset, 8);
+                    _mm256_store_pd(lanes[column], _mm256_fmadd_pd(fraction, _mm256_sub_pd(high, low), low));
+                }
+                for (int k = 0; k < 4; ++k) {
+                    out[i + k] = {lanes[0][k], lanes[1][k], lanes[2][k], lanes[3][k], lanes[4][k]};
+                }
+            }
+            return i;
+        }
+#endif
+    }
+
     bool AtmosphereManager::loadTable(const std::string& filepath) {
-        std::ifstream file(filepath, std::ios::binary);
-        if (!file) {
+        _table = {};
+        _compact = {};
+        _uniform = false;
+        _inverse_spacing = 0.0;
+        if (!_file.open(filepath)) {
             return false;
         }
 
-        _table.clear();
-        AtmosphereProperties entry{};
-        while (file.read(reinterpret_cast<char*>(&entry), sizeof(entry))) {
-            _table.push_back(entry);
+        AtmosphereTableHeader header{};
+        try {
+            _table = readAtmosphereTable(_file.bytes(), header);
+        } catch (const std::runtime_error& e) {
+            _file.close();
+            throw std::runtime_error("AtmosphereManager error: " + filepath + ": " + e.what());
         }
 
-        return !_table.empty();
+        // The writer recorded whether the rows are evenly spaced, so lookups can index rows directly.
+        _uniform = header.spacing_m > 0.0;
+        _inverse_spacing = _uniform ? 1.0 / header.spacing_m : 0.0;
+
+        if (_table.size() >= 2) {
+            _compact = CompactAtmosphereTable([this](double altitude) { return getProperties(altitude); },
+                                              _table.front().altitude, _table.back().altitude);
+        }
+        return true;
     }
 
     bool AtmosphereManager::isLoaded() const {
@@ -30,13 +101,21 @@ namespace StrikeEngine {
             throw std::runtime_error("AtmosphereManager error: Table not loaded.");
         }
 
-        if (altitude <= _table.front().altitude) {
+        // Written so that NaN takes the first row too; it would pass both edge tests otherwise,
+        // and neither the row cast nor the search below is defined for it.
+        if (!(altitude > _table.front().altitude)) {
             return _table.front();
         }
         if (altitude >= _table.back().altitude) {
             return _table.back();
         }
 
+        if (_uniform) {
+            const double position = (altitude - _table.front().altitude) * _inverse_spacing;
+            const size_t row = std::min(static_cast<size_t>(position), _table.size() - 2);
+            return interpolate(_table[row], _table[row + 1], position - static_cast<double>(row), altitude);
+        }
+
         auto it = std::lower_bound(_table.begin(), _table.end(), altitude,
             [](const AtmosphereProperties& p, double alt) {
                 return p.altitude < alt;
@@ -46,15 +125,26 @@ namespace StrikeEngine {
         const auto& low = *(--it);
 
         const double fraction = (altitude - low.altitude) / (high.altitude - low.altitude);
+        return interpolate(low, high, fraction, altitude);
+    }
 
-        AtmosphereProperties interpolated{};
-        interpolated.altitude = altitude;
-        interpolated.temperature = low.temperature + fraction * (high.temperature - low.temperature);
-        interpolated.pressure = low.pressure + fraction * (high.pressure - low.pressure);
-        interpolated.density = low.density + fraction * (high.density - low.density);
-        interpolated.speedOfSound = low.speedOfSound + fraction * (high.speedOfSound - low.speedOfSound);
+    void AtmosphereManager::getProperties(std::span<const double> altitudes, std::span<AtmosphereProperties> out) const {
+        if (!isLoaded()) {
+            throw std::runtime_error("AtmosphereManager error: Table not loaded.");
+        }
+        if (out.size() < altitudes.size()) {
+            throw std::runtime_error("AtmosphereManager error: Output span is shorter than the altitude span.");
+        }
 
-        return interpolated;
+        size_t done = 0;
+#if STRIKEENGINE_SIMD_X86
+        if (_uniform && detectSimdLevel() >= SimdLevel::AVX2) {
+            done = lookupUniformAvx2(_table, _inverse_spacing, altitudes.data(), out.data(), altitudes.size());
+        }
+#endif
+        for (size_t i = done; i < altitudes.size(); ++i) {
+            out[i] = getProperties(altitudes[i]);
+        }
     }
 
     double AtmosphereManager::getTransmissivity(double range_m, double altitude_m, IRWavelengthBand band) {
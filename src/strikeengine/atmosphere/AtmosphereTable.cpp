@@ -0,0 +1,134 @@
+#include "strikeengine/atmosphere/AtmosphereTable.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace StrikeEngine {
+
+    namespace {
+        // Rows may deviate from the even grid by this fraction of the spacing.
+        constexpr double UNIFORM_TOLERANCE = 1e-6;
+
+        constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+        constexpr uint64_t FNV_PRIME = 0x100000001b3ull;
+
+        constexpr uint32_t FIELD_COUNT = sizeof(AtmosphereProperties) / sizeof(double);
+        static_assert(sizeof(AtmosphereProperties) == FIELD_COUNT * sizeof(double));
+
+        double evenSpacing(std::span<const AtmosphereProperties> rows) {
+            if (rows.size() < 2) {
+                return 0.0;
+            }
+            const double spacing = (rows.back().altitude - rows.front().altitude) / static_cast<double>(rows.size() - 1);
+            for (size_t i = 0; i < rows.size(); ++i) {
+                const double expected = rows.front().altitude + static_cast<double>(i) * spacing;
+                if (std::abs(rows[i].altitude - expected) > UNIFORM_TOLERANCE * spacing) {
+                    return 0.0;
+                }
+            }
+            return spacing;
+        }
+
+        [[noreturn]] void fail(const std::string& reason) {
+            throw std::runtime_error("Atmosphere table error: " + reason);
+        }
+    }
+
+    uint64_t atmosphereTableChecksum(std::span<const AtmosphereProperties> rows) {
+        const auto* words = reinterpret_cast<const uint64_t*>(rows.data());
+        const size_t count = rows.size() * FIELD_COUNT;
+        uint64_t hash = FNV_OFFSET_BASIS;
+        for (size_t i = 0; i < count; ++i) {
+            hash = (hash ^ words[i]) * FNV_PRIME;
+        }
+        return hash;
+    }
+
+    AtmosphereTableHeader makeAtmosphereTableHeader(std::span<const AtmosphereProperties> rows) {
+        if (rows.empty()) {
+            fail("The table has no rows.");
+        }
+        for (size_t i = 1; i < rows.size(); ++i) {
+            if (!(rows[i].altitude > rows[i - 1].altitude)) {
+                fail("Row altitudes must strictly ascend (row " + std::to_string(i) + ").");
+            }
+        }
+
+        AtmosphereTableHeader header{};
+        std::memcpy(header.magic, ATMOSPHERE_TABLE_MAGIC, sizeof(header.magic));
+        header.version = ATMOSPHERE_TABLE_VERSION;
+        header.header_size = sizeof(AtmosphereTableHeader);
+        header.row_size = sizeof(AtmosphereProperties);
+        header.field_count = FIELD_COUNT;
+        header.row_count = rows.size();
+        header.base_altitude_m = rows.front().altitude;
+        header.spacing_m = evenSpacing(rows);
+        std::memcpy(header.fields, ATMOSPHERE_TABLE_FIELDS, sizeof(ATMOSPHERE_TABLE_FIELDS));
+        header.checksum = atmosphereTableChecksum(rows);
+        return header;
+    }
+
+    void writeAtmosphereTable(const std::string& filepath, std::span<const AtmosphereProperties> rows) {
+        const AtmosphereTableHeader header = makeAtmosphereTableHeader(rows);
+        std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            fail("Failed to open file for writing: " + filepath);
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(rows.data()), static_cast<std::streamsize>(rows.size_bytes()));
+        if (!out) {
+            fail("Failed to write " + filepath);
+        }
+    }
+
+    std::span<const AtmosphereProperties> readAtmosphereTable(std::span<const std::byte> bytes,
+                                                              AtmosphereTableHeader& header) {
+        if (bytes.size() < sizeof(AtmosphereTableHeader)) {
+            fail("The file is too short for a header.");
+        }
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (std::memcmp(header.magic, ATMOSPHERE_TABLE_MAGIC, sizeof(header.magic)) != 0) {
+            fail("Not an atmosphere table; regenerate it with GenerateAtmosphereTable.");
+        }
+        if (header.version != ATMOSPHERE_TABLE_VERSION) {
+            fail("Unsupported version " + std::to_string(header.version) + ", expected " +
+                 std::to_string(ATMOSPHERE_TABLE_VERSION) + ".");
+        }
+        const bool layout_matches = header.header_size == sizeof(AtmosphereTableHeader) &&
+                                    header.row_size == sizeof(AtmosphereProperties) &&
+                                    header.field_count == FIELD_COUNT &&
+                                    std::memcmp(header.fields, ATMOSPHERE_TABLE_FIELDS, sizeof(ATMOSPHERE_TABLE_FIELDS)) == 0 &&
+                                    std::all_of(header.fields + sizeof(ATMOSPHERE_TABLE_FIELDS), std::end(header.fields),
+                                                [](char c) { return c == '\0'; });
+        if (!layout_matches) {
+            fail("The field layout does not match this build's AtmosphereProperties.");
+        }
+        if (header.row_count == 0 || (bytes.size() - header.header_size) / header.row_size != header.row_count ||
+            (bytes.size() - header.header_size) % header.row_size != 0) {
+            fail("The file size does not match its row count.");
+        }
+        if (reinterpret_cast<uintptr_t>(bytes.data()) % alignof(AtmosphereProperties) != 0) {
+            fail("The table is not aligned for reading in place.");
+        }
+
+        const std::span rows(reinterpret_cast<const AtmosphereProperties*>(bytes.data() + header.header_size),
+                             static_cast<size_t>(header.row_count));
+        if (atmosphereTableChecksum(rows) != header.checksum) {
+            fail("Checksum mismatch; the table is corrupt.");
+        }
+        if (rows.front().altitude != header.base_altitude_m) {
+            fail("The first row does not start at the base altitude.");
+        }
+        if (header.spacing_m != 0.0) {
+            const double top = header.base_altitude_m + static_cast<double>(rows.size() - 1) * header.spacing_m;
+            if (!(header.spacing_m > 0.0) || rows.size() < 2 ||
+                std::abs(rows.back().altitude - top) > UNIFORM_TOLERANCE * header.spacing_m) {
+                fail("The rows do not match the recorded spacing.");
+            }
+        }
+        return rows;
+    }
+
+} // namespace StrikeEngine
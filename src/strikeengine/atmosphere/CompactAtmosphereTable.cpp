@@ -0,0 +1,86 @@
+#include "strikeengine/atmosphere/CompactAtmosphereTable.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace StrikeEngine {
+
+    CompactAtmosphereTable::CompactAtmosphereTable(const std::function<AtmosphereProperties(double)>& source,
+                                                   double baseAltitude, double topAltitude,
+                                                   std::span<const AtmosphereBand> bands) {
+        if (!(topAltitude > baseAltitude)) {
+            throw std::runtime_error("CompactAtmosphereTable error: The altitude range is empty.");
+        }
+
+        double band_base = baseAltitude;
+        for (const AtmosphereBand& requested : bands) {
+            if (!(requested.spacing_m > 0.0)) {
+                throw std::runtime_error("CompactAtmosphereTable error: Band spacing must be positive.");
+            }
+            if (requested.top_altitude_m <= band_base) {
+                continue;
+            }
+            const double band_top = std::min(requested.top_altitude_m, topAltitude);
+            const double intervals = std::max(1.0, std::ceil((band_top - band_base) / requested.spacing_m));
+            const double spacing = (band_top - band_base) / intervals;
+
+            Band band{band_base, band_top, 1.0 / spacing, static_cast<uint32_t>(_rows.size()),
+                      static_cast<uint32_t>(intervals) + 1};
+            for (uint32_t i = 0; i < band.row_count; ++i) {
+                // The last row is sampled at the top itself, not at base + intervals * spacing.
+                const double altitude = i + 1 == band.row_count ? band_top : band_base + i * spacing;
+                const AtmosphereProperties p = source(altitude);
+                _rows.push_back({static_cast<float>(p.temperature), static_cast<float>(p.pressure),
+                                 static_cast<float>(p.density), static_cast<float>(p.speedOfSound)});
+            }
+            _bands.push_back(band);
+
+            band_base = band_top;
+            if (band_top >= topAltitude) {
+                break;
+            }
+        }
+        if (band_base < topAltitude) {
+            throw std::runtime_error("CompactAtmosphereTable error: The bands end below the top altitude.");
+        }
+    }
+
+    AtmosphereProperties CompactAtmosphereTable::getProperties(double altitude) const {
+        if (_rows.empty()) {
+            throw std::runtime_error("CompactAtmosphereTable error: Table not built.");
+        }
+
+        // std::clamp passes NaN through, and a NaN row index is undefined; take the base row.
+        if (!(altitude >= _bands.front().base_altitude_m)) {
+            altitude = _bands.front().base_altitude_m;
+        }
+        altitude = std::min(altitude, _bands.back().top_altitude_m);
+        size_t index = 0;
+        while (altitude > _bands[index].top_altitude_m) {
+            ++index;
+        }
+        const Band& band = _bands[index];
+
+        const double position = (altitude - band.base_altitude_m) * band.inverse_spacing;
+        const uint32_t row = std::min(static_cast<uint32_t>(position), band.row_count - 2);
+        const double fraction = position - row;
+        const Row& low = _rows[band.first_row + row];
+        const Row& high = _rows[band.first_row + row + 1];
+
+        auto lerp = [fraction](float a, float b) {
+            return static_cast<double>(a) + fraction * (static_cast<double>(b) - static_cast<double>(a));
+        };
+        return {altitude, lerp(low.temperature, high.temperature), lerp(low.pressure, high.pressure),
+                lerp(low.density, high.density), lerp(low.speedOfSound, high.speedOfSound)};
+    }
+
+    void CompactAtmosphereTable::getProperties(std::span<const double> altitudes, std::span<AtmosphereProperties> out) const {
+        if (out.size() < altitudes.size()) {
+            throw std::runtime_error("CompactAtmosphereTable error: Output span is shorter than the altitude span.");
+        }
+        for (size_t i = 0; i < altitudes.size(); ++i) {
+            out[i] = getProperties(altitudes[i]);
+        }
+    }
+
+} // namespace StrikeEngine
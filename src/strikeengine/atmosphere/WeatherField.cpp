@@ -0,0 +1,307 @@
+#include "strikeengine/atmosphere/WeatherField.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <numbers>
+#include <stdexcept>
+#include <vector>
+
+namespace StrikeEngine {
+
+    namespace {
+        constexpr double DEGREES = 180.0 / std::numbers::pi;
+        constexpr uint32_t FIELD_COUNT = sizeof(WeatherPoint) / sizeof(float);
+        static_assert(sizeof(WeatherPoint) == FIELD_COUNT * sizeof(float));
+
+        [[noreturn]] void fail(const std::string& reason) {
+            throw std::runtime_error("Weather field error: " + reason);
+        }
+
+        uint64_t alignUp(uint64_t value, uint64_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+        uint32_t tilesAlong(const WeatherAxis& axis) {
+            const uint32_t cells_per_tile = axis.tile_points - 1;
+            return (axis.points - 1 + cells_per_tile - 1) / cells_per_tile;
+        }
+
+        uint64_t pointsPerTile(const WeatherGrid& grid) {
+            uint64_t points = 1;
+            for (const WeatherAxis& axis : grid.axes) {
+                points *= axis.tile_points;
+            }
+            return points;
+        }
+
+        void validateGrid(const WeatherGrid& grid) {
+            for (const WeatherAxis& axis : grid.axes) {
+                if (axis.points < 2 || axis.tile_points < 2 || axis.tile_points > axis.points) {
+                    fail("Every axis needs at least two points and tiles of 2 to all of its points.");
+                }
+                if (!(axis.spacing > 0.0) || !std::isfinite(axis.spacing) || !std::isfinite(axis.origin)) {
+                    fail("Axis spacing must be positive and finite.");
+                }
+            }
+            if (!(grid.earth_radius_m > 0.0)) {
+                fail("The earth radius must be positive.");
+            }
+        }
+
+        WeatherFieldHeader makeHeader(const WeatherGrid& grid) {
+            WeatherFieldHeader header{};
+            std::memcpy(header.magic, WEATHER_FIELD_MAGIC, sizeof(header.magic));
+            header.version = WEATHER_FIELD_VERSION;
+            header.header_size = sizeof(WeatherFieldHeader);
+            header.point_size = sizeof(WeatherPoint);
+            header.field_count = FIELD_COUNT;
+            header.grid = grid;
+            for (size_t k = 0; k < WeatherGrid::AXES; ++k) {
+                header.tiles[k] = tilesAlong(grid.axes[k]);
+            }
+            header.tile_size = alignUp(pointsPerTile(grid) * sizeof(WeatherPoint), WEATHER_TILE_ALIGNMENT);
+            header.data_offset = alignUp(sizeof(WeatherFieldHeader), WEATHER_TILE_ALIGNMENT);
+            std::memcpy(header.fields, WEATHER_FIELD_FIELDS, sizeof(WEATHER_FIELD_FIELDS));
+            return header;
+        }
+    }
+
+    void writeWeatherField(const std::string& filepath, const WeatherGrid& grid, const WeatherSource& source) {
+        validateGrid(grid);
+        const WeatherFieldHeader header = makeHeader(grid);
+        std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            fail("Failed to open file for writing: " + filepath);
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        const std::vector<char> padding(header.data_offset - sizeof(header), 0);
+        out.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+        const WeatherAxis* axes = grid.axes;
+        std::vector<char> tile(header.tile_size, 0);
+        auto* points = reinterpret_cast<WeatherPoint*>(tile.data());
+        // The value of one axis at a tile-local point; points past the grid's end repeat its last point.
+        auto coordinate = [&](size_t axis, uint32_t tile_index, uint32_t local) {
+            const uint32_t global = std::min(tile_index * (axes[axis].tile_points - 1) + local, axes[axis].points - 1);
+            return axes[axis].origin + global * axes[axis].spacing;
+        };
+
+        using G = WeatherGrid;
+        for (uint32_t tt = 0; tt < header.tiles[G::TIME]; ++tt)
+        for (uint32_t ta = 0; ta < header.tiles[G::ALTITUDE]; ++ta)
+        for (uint32_t tla = 0; tla < header.tiles[G::LATITUDE]; ++tla)
+        for (uint32_t tlo = 0; tlo < header.tiles[G::LONGITUDE]; ++tlo) {
+            size_t i = 0;
+            for (uint32_t t = 0; t < axes[G::TIME].tile_points; ++t)
+            for (uint32_t a = 0; a < axes[G::ALTITUDE].tile_points; ++a)
+            for (uint32_t la = 0; la < axes[G::LATITUDE].tile_points; ++la)
+            for (uint32_t lo = 0; lo < axes[G::LONGITUDE].tile_points; ++lo) {
+                points[i++] = source(coordinate(G::LATITUDE, tla, la), coordinate(G::LONGITUDE, tlo, lo),
+                                     coordinate(G::ALTITUDE, ta, a), coordinate(G::TIME, tt, t));
+            }
+            out.write(tile.data(), static_cast<std::streamsize>(tile.size()));
+        }
+        if (!out) {
+            fail("Failed to write " + filepath);
+        }
+    }
+
+    bool WeatherField::open(const std::string& filepath, size_t maxResidentTiles) {
+        _tiles = nullptr;
+        _tile_count = 0;
+        _resident.clear();
+        _max_resident_tiles = maxResidentTiles;
+        if (!_file.open(filepath)) {
+            return false;
+        }
+
+        try {
+            const std::span<const std::byte> bytes = _file.bytes();
+            if (bytes.size() < sizeof(WeatherFieldHeader)) {
+                fail("The file is too short for a header.");
+            }
+            std::memcpy(&_header, bytes.data(), sizeof(_header));
+            if (std::memcmp(_header.magic, WEATHER_FIELD_MAGIC, sizeof(_header.magic)) != 0) {
+                fail("Not a weather field file.");
+            }
+            if (_header.version != WEATHER_FIELD_VERSION) {
+                fail("Unsupported version " + std::to_string(_header.version) + ", expected " +
+                     std::to_string(WEATHER_FIELD_VERSION) + ".");
+            }
+            const bool layout_matches = _header.header_size == sizeof(WeatherFieldHeader) &&
+                                        _header.point_size == sizeof(WeatherPoint) &&
+                                        _header.field_count == FIELD_COUNT &&
+                                        std::memcmp(_header.fields, WEATHER_FIELD_FIELDS, sizeof(WEATHER_FIELD_FIELDS)) == 0;
+            if (!layout_matches) {
+                fail("The field layout does not match this build's WeatherPoint.");
+            }
+            validateGrid(_header.grid);
+
+            // Everything derived from the grid must agree with what the writer recorded.
+            const WeatherFieldHeader expected = makeHeader(_header.grid);
+            if (!std::equal(std::begin(_header.tiles), std::end(_header.tiles), std::begin(expected.tiles)) ||
+                _header.tile_size != expected.tile_size || _header.data_offset != expected.data_offset) {
+                fail("The tiling does not match the grid.");
+            }
+            size_t count = 1;
+            for (const uint32_t tiles : _header.tiles) {
+                count *= tiles;
+            }
+            if (bytes.size() < _header.data_offset || (bytes.size() - _header.data_offset) / _header.tile_size < count) {
+                fail("The file is shorter than its tiles.");
+            }
+
+            _tiles = bytes.data() + _header.data_offset;
+            _tile_count = count;
+        } catch (const std::runtime_error&) {
+            _file.close();
+            throw;
+        }
+        return true;
+    }
+
+    WeatherField::AxisCell WeatherField::locate(size_t axis, double value) const {
+        const WeatherAxis& a = _header.grid.axes[axis];
+        // Clamped to the grid; max before min also sends NaN to the first point.
+        const double u = std::min(std::max(0.0, (value - a.origin) / a.spacing), static_cast<double>(a.points - 1));
+        const uint32_t cell = std::min(static_cast<uint32_t>(u), a.points - 2);
+        const uint32_t cells_per_tile = a.tile_points - 1;
+        return {cell / cells_per_tile, cell % cells_per_tile, u - cell};
+    }
+
+    WeatherField::Location WeatherField::locate(const glm::dvec3& position, const AxisCell& time) const {
+        const double rho = std::hypot(position.x, position.z);
+        const double r = std::hypot(rho, position.y);
+        const double cos_lon = rho > 0.0 ? position.x / rho : 1.0;
+        const double sin_lon = rho > 0.0 ? -position.z / rho : 0.0;
+        const double cos_lat = r > 0.0 ? rho / r : 1.0;
+        const double sin_lat = r > 0.0 ? position.y / r : 0.0;
+
+        // Bring the longitude into the 360 degrees that start at the grid's origin. Past the
+        // east edge of a regional grid, positions nearer its west edge clamp to that instead.
+        const WeatherAxis& lon_axis = _header.grid.axes[WeatherGrid::LONGITUDE];
+        const double lon_end = lon_axis.origin + (lon_axis.points - 1) * lon_axis.spacing;
+        double longitude = std::atan2(sin_lon, cos_lon) * DEGREES;
+        longitude = lon_axis.origin + std::fmod(longitude - lon_axis.origin, 360.0);
+        if (longitude < lon_axis.origin) {
+            longitude += 360.0;
+        }
+        if (longitude > lon_end && lon_axis.origin + 360.0 - longitude < longitude - lon_end) {
+            longitude = lon_axis.origin;
+        }
+
+        Location location{};
+        location.cells[WeatherGrid::LATITUDE] = locate(WeatherGrid::LATITUDE, std::atan2(sin_lat, cos_lat) * DEGREES);
+        location.cells[WeatherGrid::LONGITUDE] = locate(WeatherGrid::LONGITUDE, longitude);
+        location.cells[WeatherGrid::ALTITUDE] = locate(WeatherGrid::ALTITUDE, r - _header.grid.earth_radius_m);
+        location.cells[WeatherGrid::TIME] = time;
+        location.east = {-sin_lon, 0.0, -cos_lon};
+        location.north = {-sin_lat * cos_lon, cos_lat, sin_lat * sin_lon};
+        location.up = {cos_lat * cos_lon, sin_lat, -cos_lat * sin_lon};
+        return location;
+    }
+
+    size_t WeatherField::tileIndex(const Location& location) const {
+        using G = WeatherGrid;
+        const auto& c = location.cells;
+        return ((static_cast<size_t>(c[G::TIME].tile) * _header.tiles[G::ALTITUDE] + c[G::ALTITUDE].tile)
+                * _header.tiles[G::LATITUDE] + c[G::LATITUDE].tile) * _header.tiles[G::LONGITUDE] + c[G::LONGITUDE].tile;
+    }
+
+    WeatherSample WeatherField::interpolate(const Location& location) const {
+        using G = WeatherGrid;
+        const WeatherAxis* axes = _header.grid.axes;
+        const auto* points = reinterpret_cast<const WeatherPoint*>(_tiles + tileIndex(location) * _header.tile_size);
+
+        // Point strides inside a tile; longitude is fastest.
+        size_t stride[G::AXES];
+        stride[G::LONGITUDE] = 1;
+        stride[G::LATITUDE] = axes[G::LONGITUDE].tile_points;
+        stride[G::ALTITUDE] = stride[G::LATITUDE] * axes[G::LATITUDE].tile_points;
+        stride[G::TIME] = stride[G::ALTITUDE] * axes[G::ALTITUDE].tile_points;
+
+        size_t base = 0;
+        for (size_t k = 0; k < G::AXES; ++k) {
+            base += location.cells[k].local * stride[k];
+        }
+
+        // Sum the 16 corners of the space-time cell, each weighted by its share of the point.
+        double east = 0.0, north = 0.0, up = 0.0, temperature = 0.0, density = 0.0;
+        for (uint32_t corner = 0; corner < (1u << G::AXES); ++corner) {
+            double weight = 1.0;
+            size_t offset = base;
+            for (size_t k = 0; k < G::AXES; ++k) {
+                const double fraction = location.cells[k].fraction;
+                if (corner & (1u << k)) {
+                    weight *= fraction;
+                    offset += stride[k];
+                } else {
+                    weight *= 1.0 - fraction;
+                }
+            }
+            const WeatherPoint& point = points[offset];
+            east += weight * point.wind_east_mps;
+            north += weight * point.wind_north_mps;
+            up += weight * point.wind_up_mps;
+            temperature += weight * point.temperature_K;
+            density += weight * point.density_kgpm3;
+        }
+        return {east * location.east + north * location.north + up * location.up, temperature, density};
+    }
+
+    WeatherSample WeatherField::sample(const glm::dvec3& position, double time_s) const {
+        if (!isLoaded()) {
+            throw std::runtime_error("WeatherField error: No field loaded.");
+        }
+        return interpolate(locate(position, locate(WeatherGrid::TIME, time_s)));
+    }
+
+    void WeatherField::sample(std::span<const glm::dvec3> positions, double time_s, std::span<WeatherSample> out) const {
+        if (!isLoaded()) {
+            throw std::runtime_error("WeatherField error: No field loaded.");
+        }
+        if (out.size() < positions.size()) {
+            throw std::runtime_error("WeatherField error: Output span is shorter than the position span.");
+        }
+        const AxisCell time = locate(WeatherGrid::TIME, time_s);
+        for (size_t i = 0; i < positions.size(); ++i) {
+            out[i] = interpolate(locate(positions[i], time));
+        }
+    }
+
+    void WeatherField::prefetch(std::span<const glm::dvec3> positions, double time_s) {
+        if (!isLoaded()) {
+            return;
+        }
+        const uint64_t now = ++_prefetch_count;
+        const AxisCell time = locate(WeatherGrid::TIME, time_s);
+        for (const glm::dvec3& position : positions) {
+            const size_t tile = tileIndex(locate(position, time));
+            const auto [it, inserted] = _resident.try_emplace(tile, now);
+            if (inserted) {
+                _file.prefetch(_header.data_offset + tile * _header.tile_size, _header.tile_size);
+            } else {
+                it->second = now;
+            }
+        }
+
+        if (_resident.size() <= _max_resident_tiles) {
+            return;
+        }
+        // Over budget: release the tiles needed longest ago, sparing those needed just now.
+        std::vector<std::pair<uint64_t, size_t>> idle;
+        for (const auto& [tile, last_needed] : _resident) {
+            if (last_needed != now) {
+                idle.emplace_back(last_needed, tile);
+            }
+        }
+        std::sort(idle.begin(), idle.end());
+        for (size_t i = 0; i < idle.size() && _resident.size() > _max_resident_tiles; ++i) {
+            const size_t tile = idle[i].second;
+            _file.release(_header.data_offset + tile * _header.tile_size, _header.tile_size);
+            _resident.erase(tile);
+        }
+    }
+
+} // namespace StrikeEngine
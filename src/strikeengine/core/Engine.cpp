@@ -6,6 +6,7 @@
 #include "strikeengine/systems/physics/PropulsionSystem.hpp"
 #include "strikeengine/systems/physics/AerodynamicsSystem.hpp"
 #include "strikeengine/systems/physics/IntegrationSystem.hpp"
+#include "strikeengine/systems/physics/RigidBodyGroup.hpp"
 #include "strikeengine/systems/guidance/NavigationSystem.hpp"
 #include "strikeengine/systems/guidance/SensorSystem.hpp"
 #include "strikeengine/systems/guidance/GuidanceSystem.hpp"
@@ -13,66 +14,88 @@
 #include "strikeengine/systems/guidance/EndgameSystem.hpp"
 
 #include <iostream>
+#include <stdexcept>
 
 namespace StrikeEngine {
+    namespace {
+        // Update periods for systems that do not need the full physics rate.
+        constexpr double SENSOR_PERIOD_S = 1.0 / 50.0;   // Seeker/sensor sampling, 50 Hz
+        constexpr double GUIDANCE_PERIOD_S = 1.0 / 100.0; // Guidance law and autopilot, 100 Hz
+    }
+
     Engine::Engine() : _entity_factory(_registry)
     {
-        _atmosphere_manager.loadTable("data/atmosphere_table.bin");
+        // A stale or corrupt table is reported, not fatal: the systems that need the atmosphere
+        // skip their work while it is unloaded, as they do when the file is missing.
+        try {
+            _atmosphere_manager.loadTable("data/atmosphere_table.bin");
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << " Run GenerateAtmosphereTable to regenerate it." << std::endl;
+        }
+        // Optional: without a weather field, vehicles fly through still standard atmosphere. A
+        // stale or corrupt field is reported and left unloaded, the same as a missing one.
+        try {
+            _weather_field.open("data/weather/weather_field.bin");
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << " Continuing with still air." << std::endl;
+        }
         initializeSystems();
-        _execution_order = _system_graph.getExecutionOrder();
+        // Create the physics owning group up front, so no system builds it while others run
+        rigidBodyGroup(_registry);
+        _frame_graph = _system_graph.buildTaskGraph(_frame_dt, [this](System* system, double dt)
+        {
+            system->update(_registry, dt);
+        });
     }
 
     void Engine::initializeSystems()
     {
         // --- 1. Create instances of all systems ---
-        auto gravity_system = std::make_unique<GravitySystem>();
-        auto propulsion_system = std::make_unique<PropulsionSystem>(_atmosphere_manager);
+        // Integration re-evaluates gravity at its RK4 stages, so both share one model.
+        const GravityModel gravity_model;
+        auto gravity_system = std::make_unique<GravitySystem>(_job_system, gravity_model);
+        auto propulsion_system = std::make_unique<PropulsionSystem>(_atmosphere_manager, _job_system);
         auto nav_system = std::make_unique<NavigationSystem>();
         auto sensor_system = std::make_unique<SensorSystem>();
-        auto guidance_system = std::make_unique<GuidanceSystem>();
+        auto guidance_system = std::make_unique<GuidanceSystem>(_job_system);
         auto control_system = std::make_unique<ControlSystem>();
-        auto aero_system = std::make_unique<AerodynamicsSystem>(_atmosphere_manager);
-        auto integration_system = std::make_unique<IntegrationSystem>();
+        auto aero_system = std::make_unique<AerodynamicsSystem>(_atmosphere_manager, _job_system, &_weather_field);
+        auto integration_system = std::make_unique<IntegrationSystem>(_job_system, gravity_model);
         auto endgame_system = std::make_unique<EndgameSystem>();
 
 
-        // --- 2. Add systems to the graph (and get raw pointers for dependencies) ---
-        System* p_gravity = _system_graph.addSystem(std::move(gravity_system));
-        System* p_propulsion = _system_graph.addSystem(std::move(propulsion_system));
-        System* p_nav = _system_graph.addSystem(std::move(nav_system));
+        // --- 2. Add systems to the graph ---
+        // Dependencies are derived from each system's declared Reads/Writes: two systems that touch
+        // the same component run in the order they are added here, everything else runs in parallel.
+        _system_graph.addSystem(std::move(gravity_system));
+        _system_graph.addSystem(std::move(propulsion_system));
+        _system_graph.addSystem(std::move(nav_system));
         System* p_sensor = _system_graph.addSystem(std::move(sensor_system));
         System* p_guidance = _system_graph.addSystem(std::move(guidance_system));
         System* p_control = _system_graph.addSystem(std::move(control_system));
-        System* p_aero = _system_graph.addSystem(std::move(aero_system));
-        System* p_integration = _system_graph.addSystem(std::move(integration_system));
-        System* p_endgame = _system_graph.addSystem(std::move(endgame_system));
+        _system_graph.addSystem(std::move(aero_system));
+        _system_graph.addSystem(std::move(integration_system));
+        _system_graph.addSystem(std::move(endgame_system));
 
 
-        // --- 3. Define the execution dependencies ---
-        _system_graph.addDependency(p_guidance, p_nav);
-        _system_graph.addDependency(p_guidance, p_sensor);
-        _system_graph.addDependency(p_control, p_guidance);
-        _system_graph.addDependency(p_aero, p_control);
-        _system_graph.addDependency(p_integration, p_gravity);
-        _system_graph.addDependency(p_integration, p_propulsion);
-        _system_graph.addDependency(p_integration, p_aero);
-        _system_graph.addDependency(p_endgame, p_integration);
+        // --- 3. Run rates ---
+        // Physics, navigation and the fuze run every tick; sensors and the GNC loop run at the
+        // rates of real seeker and autopilot hardware and get their own, longer dt.
+        _system_graph.setPeriod(p_sensor, SENSOR_PERIOD_S);
+        _system_graph.setPeriod(p_guidance, GUIDANCE_PERIOD_S);
+        _system_graph.setPeriod(p_control, GUIDANCE_PERIOD_S);
     }
 
 
     void Engine::update(double dt)
     {
-        for (const auto& stage : _execution_order)
-        {
-            for (System* system : stage)
-            {
-                _job_system.submit([system, this, dt]()
-                {
-                    system->update(_registry, dt);
-                });
-            }
-            _job_system.wait();
-        }
+        // Each system starts as soon as its own prerequisites are done; no per-stage barrier.
+        // Systems with a period longer than dt are skipped until they are due.
+        _frame_dt = dt;
+        _frame_graph.run(_job_system);
+
+        // Sync point: apply the structural changes systems deferred during the frame.
+        _registry.flushCommands();
     }
 
     void Engine::run(double simulation_time_s, double dt)
@@ -1,9 +1,27 @@
 #include "strikeengine/core/JobSystem.hpp"
+#include "strikeengine/ecs/SystemAccess.hpp"
+#include <algorithm>
 #include <iostream>
 
 namespace StrikeEngine {
 
-    JobSystem::JobSystem(size_t num_threads) : _pending_jobs(0), _stop_processing(false) {
+    namespace {
+        // Identifies the pool and slot of the current thread, so submit() can find the local deque.
+        thread_local const JobSystem* t_job_system = nullptr;
+        thread_local size_t t_worker_index = 0;
+        // Victim selection for threads outside the pool.
+        thread_local uint32_t t_external_rng_state = 0x9E3779B9u;
+
+        uint32_t nextRandom(uint32_t& state) {
+            // xorshift32; only used to spread thieves across victims.
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+    }
+
+    JobSystem::JobSystem(size_t num_threads) {
         size_t thread_count = (num_threads == 0) ? std::thread::hardware_concurrency() : num_threads;
 
         if (thread_count == 0) {
@@ -12,67 +30,253 @@ namespace StrikeEngine {
 
         std::cout << "JobSystem: Initializing with " << thread_count << " worker threads." << std::endl;
 
+        // Every deque must exist before any worker starts looking for victims.
         for (size_t i = 0; i < thread_count; ++i) {
-            _worker_threads.emplace_back(&JobSystem::workerLoop, this);
+            _workers.push_back(std::make_unique<Worker>());
+            _workers.back()->rng_state = static_cast<uint32_t>(i + 1) * 0x9E3779B9u;
+        }
+        for (size_t i = 0; i < thread_count; ++i) {
+            _worker_threads.emplace_back(&JobSystem::workerLoop, this, i);
         }
     }
 
     JobSystem::~JobSystem() {
-        {
-            std::unique_lock<std::mutex> lock(_queue_mutex);
-            _stop_processing = true;
+        _stop_processing.store(true, std::memory_order_release);
+        _wake_epoch.fetch_add(1, std::memory_order_release);
+        _wake_epoch.notify_all();
+        // Join here, before the deques and the injection queue are destroyed.
+        _worker_threads.clear();
+    }
+
+    void JobSystem::wait() {
+        // Help with the remaining work; block only once there is nothing left to pick up.
+        size_t pending;
+        while ((pending = _pending_jobs.load(std::memory_order_acquire)) != 0) {
+            if (!runPendingJob()) {
+                _pending_jobs.wait(pending, std::memory_order_acquire);
+            }
         }
-        _condition.notify_all();
     }
 
-    void JobSystem::submit(std::function<void()> job) {
-        {
-            std::unique_lock<std::mutex> lock(_queue_mutex);
-            _job_queue.push(std::move(job));
-            ++_pending_jobs;
+    void JobSystem::helpUntilZero(const std::atomic<size_t>& counter) {
+        // Help with queued work instead of blocking, so nested calls from inside a job cannot deadlock.
+        while (counter.load(std::memory_order_acquire) != 0) {
+            if (!runPendingJob()) {
+                std::this_thread::yield();
+            }
         }
-        // Notify one waiting worker thread that a new job is available.
-        _condition.notify_one();
     }
 
-    void JobSystem::wait() {
-        // This function blocks until the number of jobs in flight becomes zero.
-        std::unique_lock<std::mutex> lock(_queue_mutex);
-        // The condition variable waits until the lambda returns true.
-        _condition.wait(lock, [this] { return _pending_jobs == 0; });
+    JobSystem::Job* JobSystem::allocateJob() {
+        const size_t worker_index = currentWorkerIndex();
+        JobCache& cache = (worker_index != NO_WORKER) ? _workers[worker_index]->cache : _external_cache;
+        std::unique_lock<std::mutex> lock(_external_cache_mutex, std::defer_lock);
+        if (worker_index == NO_WORKER) {
+            lock.lock();
+        }
+
+        if (!cache.free_list) {
+            cache.free_list = cache.returned.exchange(nullptr, std::memory_order_acquire);
+        }
+        if (!cache.free_list) {
+            // Only reached while the caches warm up; steady-state frames recycle.
+            cache.blocks.push_back(std::make_unique<Job[]>(JOB_BLOCK_SIZE));
+            Job* block = cache.blocks.back().get();
+            for (size_t i = 0; i < JOB_BLOCK_SIZE; ++i) {
+                block[i].home = &cache;
+                block[i].next = (i + 1 < JOB_BLOCK_SIZE) ? &block[i + 1] : nullptr;
+            }
+            cache.free_list = block;
+        }
+
+        Job* job = cache.free_list;
+        cache.free_list = job->next;
+        job->next = nullptr;
+        // Called on the submitting thread, so this is the system the job works for.
+        job->access = SystemAccess::current();
+        return job;
     }
 
-    void JobSystem::workerLoop() {
-        while (true) {
-            std::function<void()> job;
-            {
-                std::unique_lock<std::mutex> lock(_queue_mutex);
-                // Wait until the queue is not empty or the system is stopping.
-                _condition.wait(lock, [this] {
-                    return !_job_queue.empty() || _stop_processing;
-                });
-
-                // If we are stopping and the queue is empty, the thread can exit.
-                if (_stop_processing && _job_queue.empty()) {
-                    return;
+    void JobSystem::releaseJob(Job* job) {
+        JobCache* home = job->home;
+        const size_t worker_index = currentWorkerIndex();
+        if (worker_index != NO_WORKER && home == &_workers[worker_index]->cache) {
+            job->next = home->free_list;
+            home->free_list = job;
+            return;
+        }
+
+        // Someone else's job: push it onto its home's returned stack. The owner only ever takes
+        // the whole stack at once, so there is no ABA hazard.
+        job->next = home->returned.load(std::memory_order_relaxed);
+        while (!home->returned.compare_exchange_weak(job->next, job, std::memory_order_release,
+                                                     std::memory_order_relaxed)) {
+        }
+    }
+
+    void JobSystem::enqueue(std::span<Job* const> jobs) {
+        if (jobs.empty()) {
+            return;
+        }
+
+        const size_t worker_index = currentWorkerIndex();
+        if (worker_index != NO_WORKER) {
+            auto& deque = _workers[worker_index]->deque;
+            for (Job* job : jobs) {
+                if (!deque.push(job)) {
+                    execute(job); // Local deque is full; running it here is the back-pressure.
                 }
+            }
+        } else {
+            // Link the batch up before taking the lock.
+            for (size_t i = 0; i + 1 < jobs.size(); ++i) {
+                jobs[i]->next = jobs[i + 1];
+            }
+            jobs.back()->next = nullptr;
 
-                // Pop a job from the queue.
-                job = std::move(_job_queue.front());
-                _job_queue.pop();
+            std::unique_lock<std::mutex> lock(_injection_mutex);
+            if (_injection_tail) {
+                _injection_tail->next = jobs.front();
+            } else {
+                _injection_head = jobs.front();
             }
+            _injection_tail = jobs.back();
+            _injection_size.store(_injection_size.load(std::memory_order_relaxed) + jobs.size(),
+                                  std::memory_order_relaxed);
+        }
+        wakeWorkers(jobs.size());
+    }
 
-            // Execute the job.
-            if (job) {
-                job();
+    JobSystem::Job* JobSystem::findJob(size_t worker_index) {
+        // 1. Local deque, newest first.
+        if (worker_index != NO_WORKER) {
+            if (auto job = _workers[worker_index]->deque.pop()) {
+                return *job;
+            }
+        }
+
+        // 2. Steal the oldest job from some other worker, starting at a random victim.
+        const size_t worker_count = _workers.size();
+        uint32_t& rng_state = (worker_index != NO_WORKER) ? _workers[worker_index]->rng_state : t_external_rng_state;
+        const size_t start = nextRandom(rng_state) % worker_count;
+        for (size_t i = 0; i < worker_count; ++i) {
+            const size_t victim = (start + i) % worker_count;
+            if (victim == worker_index) {
+                continue;
+            }
+            if (auto job = _workers[victim]->deque.steal()) {
+                return *job;
             }
+        }
+
+        // 3. The injection queue. A worker takes its share of the batch into its own deque,
+        //    so the rest of the pool steals it from there instead of queuing on this lock.
+        if (_injection_size.load(std::memory_order_relaxed) == 0) {
+            return nullptr;
+        }
+        std::unique_lock<std::mutex> lock(_injection_mutex);
+        if (!_injection_head) {
+            return nullptr;
+        }
+        size_t queued = _injection_size.load(std::memory_order_relaxed);
+        Job* job = _injection_head;
+        _injection_head = job->next;
+        --queued;
+        if (worker_index != NO_WORKER) {
+            const size_t share = queued / worker_count;
+            auto& deque = _workers[worker_index]->deque;
+            for (size_t i = 0; i < share; ++i) {
+                // Read the link first: once pushed, a thief may run and recycle the job.
+                Job* moved = _injection_head;
+                Job* const following = moved->next;
+                if (!deque.push(moved)) {
+                    break;
+                }
+                _injection_head = following;
+                --queued;
+            }
+        }
+        if (!_injection_head) {
+            _injection_tail = nullptr;
+        }
+        _injection_size.store(queued, std::memory_order_relaxed);
+        job->next = nullptr;
+        return job;
+    }
+
+    void JobSystem::execute(Job* job) {
+        {
+            // Check the job against its own system, not whichever one is waiting on this thread.
+            SystemAccess::Scope scope(job->access);
+            job->run(*job);
+        }
+        releaseJob(job);
 
-            // Decrement the job counter and notify the main thread if all jobs are done.
-            {
-                std::unique_lock<std::mutex> lock(_queue_mutex);
-                --_pending_jobs;
+        if (_pending_jobs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            _pending_jobs.notify_all();
+        }
+    }
+
+    bool JobSystem::runPendingJob() {
+        Job* job = findJob(currentWorkerIndex());
+        if (!job) {
+            return false;
+        }
+        execute(job);
+        return true;
+    }
+
+    void JobSystem::wakeWorkers(size_t count) {
+        // Pairs with the fence in workerLoop: either the sleeper sees the new job, or we see the sleeper.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const uint32_t sleeping = _sleeping_workers.load(std::memory_order_relaxed);
+        if (sleeping == 0) {
+            return;
+        }
+
+        _wake_epoch.fetch_add(1, std::memory_order_release);
+        if (count >= sleeping) {
+            _wake_epoch.notify_all();
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                _wake_epoch.notify_one();
+            }
+        }
+    }
+
+    size_t JobSystem::currentWorkerIndex() const {
+        return (t_job_system == this) ? t_worker_index : NO_WORKER;
+    }
+
+    void JobSystem::workerLoop(size_t worker_index) {
+        t_job_system = this;
+        t_worker_index = worker_index;
+
+        while (true) {
+            Job* job = findJob(worker_index);
+            if (!job) {
+                // Announce that we are about to sleep, then look once more. A submit racing with
+                // us either lands before this second look or sees _sleeping_workers and bumps the
+                // epoch, which makes the wait below return immediately.
+                const uint32_t epoch = _wake_epoch.load(std::memory_order_acquire);
+                _sleeping_workers.fetch_add(1, std::memory_order_seq_cst);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                job = findJob(worker_index);
+                if (!job) {
+                    // If we are stopping and there is no work left, the thread can exit.
+                    if (_stop_processing.load(std::memory_order_acquire)) {
+                        _sleeping_workers.fetch_sub(1, std::memory_order_relaxed);
+                        return;
+                    }
+                    _wake_epoch.wait(epoch, std::memory_order_acquire);
+                }
+                _sleeping_workers.fetch_sub(1, std::memory_order_relaxed);
+            }
+
+            if (job) {
+                execute(job);
             }
-            _condition.notify_all(); // Use notify_all to be safe, especially for the wait() function.
         }
     }
 
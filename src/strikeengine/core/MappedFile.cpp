@@ -0,0 +1,130 @@
+#include "strikeengine/core/MappedFile.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define STRIKEENGINE_HAS_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define STRIKEENGINE_HAS_MMAP 0
+#include <fstream>
+#endif
+
+namespace StrikeEngine {
+
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : _data(std::exchange(other._data, nullptr)),
+          _size(std::exchange(other._size, 0)),
+          _open(std::exchange(other._open, false)),
+          _buffer(std::move(other._buffer)) {
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+            _open = std::exchange(other._open, false);
+            _buffer = std::move(other._buffer);
+        }
+        return *this;
+    }
+
+    bool MappedFile::open(const std::string& filepath) {
+        close();
+#if STRIKEENGINE_HAS_MMAP
+        const int fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info{};
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        const auto size = static_cast<size_t>(info.st_size);
+        if (size > 0) {
+            // The mapping keeps its own reference to the file, so the descriptor can go.
+            void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            if (mapped == MAP_FAILED) {
+                ::close(fd);
+                return false;
+            }
+            _data = static_cast<const std::byte*>(mapped);
+        }
+        ::close(fd);
+        _size = size;
+#else
+        std::ifstream file(filepath, std::ios::binary | std::ios::ate);
+        if (!file) {
+            return false;
+        }
+        _size = static_cast<size_t>(file.tellg());
+        _buffer = std::make_unique<std::byte[]>(_size);
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char*>(_buffer.get()), static_cast<std::streamsize>(_size))) {
+            _buffer.reset();
+            _size = 0;
+            return false;
+        }
+        _data = _buffer.get();
+#endif
+        _open = true;
+        return true;
+    }
+
+    void MappedFile::prefetch(size_t offset, size_t length) const {
+#if STRIKEENGINE_HAS_MMAP
+        if (_data == nullptr || offset >= _size) {
+            return;
+        }
+        // madvise wants a page-aligned start; widen the range down to its first page.
+        const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t begin = offset / page * page;
+        const size_t end = std::min(offset + length, _size);
+        ::madvise(const_cast<std::byte*>(_data) + begin, end - begin, MADV_WILLNEED);
+#else
+        (void)offset;
+        (void)length;
+#endif
+    }
+
+    void MappedFile::release(size_t offset, size_t length) const {
+#if STRIKEENGINE_HAS_MMAP
+        if (_data == nullptr || offset >= _size) {
+            return;
+        }
+        // Only whole pages inside the range, so neighbouring data keeps its pages.
+        const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t begin = (offset + page - 1) / page * page;
+        const size_t end = std::min(offset + length, _size) / page * page;
+        if (begin < end) {
+            ::madvise(const_cast<std::byte*>(_data) + begin, end - begin, MADV_DONTNEED);
+        }
+#else
+        (void)offset;
+        (void)length;
+#endif
+    }
+
+    void MappedFile::close() {
+#if STRIKEENGINE_HAS_MMAP
+        if (_data != nullptr) {
+            ::munmap(const_cast<std::byte*>(_data), _size);
+        }
+#endif
+        _buffer.reset();
+        _data = nullptr;
+        _size = 0;
+        _open = false;
+    }
+
+} // namespace StrikeEngine
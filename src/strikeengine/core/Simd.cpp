@@ -0,0 +1,21 @@
+#include "strikeengine/core/Simd.hpp"
+
+namespace StrikeEngine {
+
+    SimdLevel detectSimdLevel() {
+        static const SimdLevel level = [] {
+#if STRIKEENGINE_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) {
+                return SimdLevel::AVX512;
+            }
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+                return SimdLevel::AVX2;
+            }
+#endif
+            return SimdLevel::Scalar;
+        }();
+        return level;
+    }
+
+} // namespace StrikeEngine
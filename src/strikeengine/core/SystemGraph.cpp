@@ -3,12 +3,26 @@
 #include <stdexcept>
 
 namespace StrikeEngine {
-    System* SystemGraph::addSystem(std::unique_ptr<System> system) {
+    namespace {
+        // Slack when comparing elapsed time to a period, so that summing a tick that does not
+        // divide the period exactly in binary (1e-3 into 1e-2) does not slip a whole tick.
+        constexpr double PERIOD_TOLERANCE_S = 1e-9;
+    }
+
+    void SystemGraph::registerSystem(std::unique_ptr<System> system, SystemAccess access) {
         System* system_ptr = system.get();
-        _systems.push_back(std::move(system));
         _adjacency_list[system_ptr] = {};
         _in_degree[system_ptr] = 0;
-        return system_ptr;
+
+        // Any earlier system that could race with this one must finish before it starts.
+        for (const auto& earlier : _systems) {
+            if (access.conflictsWith(_access.at(earlier.get()))) {
+                addDependency(system_ptr, earlier.get());
+            }
+        }
+
+        _access.emplace(system_ptr, std::move(access));
+        _systems.push_back(std::move(system));
     }
 
     void SystemGraph::addDependency(System* dependent, System* prerequisite) {
@@ -19,14 +33,16 @@ namespace StrikeEngine {
         _in_degree[dependent]++;
     }
 
-    std::vector<std::vector<System*>> SystemGraph::getExecutionOrder() {
+    std::vector<std::vector<System*>> SystemGraph::getExecutionOrder() const {
         std::vector<std::vector<System*>> execution_stages;
         std::queue<System*> q;
+        // Work on a copy so the graph can be queried more than once.
+        std::unordered_map<System*, int> in_degree = _in_degree;
 
         // --- Kahn's Algorithm for Topological Sort ---
 
         // 1. Initialize the queue with all nodes that have an in-degree of 0 (no prerequisites).
-        for (const auto& [first, second] : _in_degree) {
+        for (const auto& [first, second] : in_degree) {
             if (second == 0) {
                 q.push(first);
             }
@@ -42,11 +58,11 @@ namespace StrikeEngine {
                 current_stage.push_back(u);
 
                 // 3. For each neighbor of the current system, decrement its in-degree.
-                if (_adjacency_list.contains(u)) {
-                    for (System* v : _adjacency_list[u]) {
-                        _in_degree[v]--;
+                if (const auto it = _adjacency_list.find(u); it != _adjacency_list.end()) {
+                    for (System* v : it->second) {
+                        in_degree[v]--;
                         // 4. If a neighbor's in-degree becomes 0, it can be added to the queue for the next stage.
-                        if (_in_degree[v] == 0) {
+                        if (in_degree[v] == 0) {
                             q.push(v);
                         }
                     }
@@ -67,4 +83,48 @@ namespace StrikeEngine {
         return execution_stages;
     }
 
+    void SystemGraph::setPeriod(System* system, double period_s) {
+        if (!_adjacency_list.contains(system)) {
+            throw std::runtime_error("SystemGraph: Attempted to set the period of an unregistered system.");
+        }
+        if (period_s < 0.0) {
+            throw std::runtime_error("SystemGraph: System period must not be negative.");
+        }
+        _periods[system] = period_s;
+    }
+
+    double SystemGraph::getPeriod(System* system) const {
+        const auto it = _periods.find(system);
+        return it != _periods.end() ? it->second : 0.0;
+    }
+
+    TaskGraph SystemGraph::buildTaskGraph(const double& tickDt,
+                                          const std::function<void(System*, double)>& runSystem) const {
+        TaskGraph task_graph;
+        std::unordered_map<System*, size_t> task_index;
+        for (const auto& system : _systems) {
+            System* system_ptr = system.get();
+            const double period = getPeriod(system_ptr);
+            const SystemAccess* access = &_access.at(system_ptr);
+            // A node only ever runs on one thread at a time, so its clock needs no synchronization.
+            task_index[system_ptr] = task_graph.addTask(
+                [runSystem, system_ptr, access, period, &tickDt, elapsed = 0.0]() mutable {
+                    elapsed += tickDt;
+                    if (elapsed + PERIOD_TOLERANCE_S < period) {
+                        return; // Not due this tick.
+                    }
+                    // Marks the thread for the Registry's access checks; two stores when they are off.
+                    SystemAccess::Scope scope(*access);
+                    runSystem(system_ptr, elapsed);
+                    elapsed = 0.0;
+                });
+        }
+        for (const auto& [prerequisite, dependents] : _adjacency_list) {
+            for (System* dependent : dependents) {
+                task_graph.addDependency(task_index.at(dependent), task_index.at(prerequisite));
+            }
+        }
+        return task_graph;
+    }
+
 } // namespace StrikeEngine
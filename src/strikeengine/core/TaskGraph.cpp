@@ -0,0 +1,107 @@
+#include "strikeengine/core/TaskGraph.hpp"
+#include "strikeengine/core/JobSystem.hpp"
+#include <stdexcept>
+
+namespace StrikeEngine {
+
+    namespace {
+        constexpr size_t NO_TASK = static_cast<size_t>(-1);
+    }
+
+    size_t TaskGraph::addTask(std::function<void()> work) {
+        auto node = std::make_unique<Node>();
+        node->work = std::move(work);
+        _nodes.push_back(std::move(node));
+        _roots.push_back(_nodes.size() - 1);
+        _validated = false;
+        return _nodes.size() - 1;
+    }
+
+    void TaskGraph::addDependency(size_t dependent, size_t prerequisite) {
+        if (dependent >= _nodes.size() || prerequisite >= _nodes.size()) {
+            throw std::runtime_error("TaskGraph: Attempted to add dependency with an unknown task.");
+        }
+        _nodes[prerequisite]->successors.push_back(dependent);
+        if (_nodes[dependent]->predecessor_count++ == 0) {
+            std::erase(_roots, dependent);
+        }
+        _validated = false;
+    }
+
+    void TaskGraph::validate() {
+        // Kahn's algorithm: every node must be reachable by peeling off nodes with no predecessors.
+        std::vector<size_t> in_degree(_nodes.size());
+        for (size_t i = 0; i < _nodes.size(); ++i) {
+            in_degree[i] = _nodes[i]->predecessor_count;
+        }
+        std::vector<size_t> ready = _roots;
+        size_t visited = 0;
+        while (!ready.empty()) {
+            const size_t index = ready.back();
+            ready.pop_back();
+            ++visited;
+            for (size_t successor : _nodes[index]->successors) {
+                if (--in_degree[successor] == 0) {
+                    ready.push_back(successor);
+                }
+            }
+        }
+        if (visited != _nodes.size()) {
+            throw std::runtime_error("TaskGraph: Cycle detected in task dependencies.");
+        }
+        _validated = true;
+    }
+
+    void TaskGraph::run(JobSystem& job_system) {
+        if (_nodes.empty()) {
+            return;
+        }
+        if (!_validated) {
+            validate();
+        }
+
+        for (const auto& node : _nodes) {
+            node->remaining_predecessors.store(node->predecessor_count, std::memory_order_relaxed);
+        }
+        _remaining_tasks->store(_nodes.size(), std::memory_order_relaxed);
+
+        // The submits below publish the resets above to whichever worker picks each root up.
+        job_system.submitN(_roots.size(), [this, &job_system](size_t root) {
+            runNode(job_system, _roots[root]);
+        });
+
+        size_t remaining;
+        while ((remaining = _remaining_tasks->load(std::memory_order_acquire)) != 0) {
+            if (!job_system.runPendingJob()) {
+                _remaining_tasks->wait(remaining, std::memory_order_acquire);
+            }
+        }
+    }
+
+    void TaskGraph::runNode(JobSystem& job_system, size_t index) {
+        while (index != NO_TASK) {
+            Node& node = *_nodes[index];
+            node.work();
+
+            // Launch every successor this node made ready, keeping one to run here: the
+            // critical path then stays on one thread instead of bouncing through the queues.
+            size_t next = NO_TASK;
+            for (size_t successor : node.successors) {
+                if (_nodes[successor]->remaining_predecessors.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                    continue;
+                }
+                if (next == NO_TASK) {
+                    next = successor;
+                } else {
+                    job_system.submit([this, &job_system, successor]() { runNode(job_system, successor); });
+                }
+            }
+
+            if (_remaining_tasks->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                _remaining_tasks->notify_all();
+            }
+            index = next;
+        }
+    }
+
+} // namespace StrikeEngine
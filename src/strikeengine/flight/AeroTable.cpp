@@ -0,0 +1,407 @@
+#include "strikeengine/flight/AeroTable.hpp"
+#include "strikeengine/core/Simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#if STRIKEENGINE_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace StrikeEngine {
+
+    namespace {
+        constexpr size_t TABLE_ALIGNMENT = 64;
+        constexpr size_t PARAMETER_COUNT = 6;
+
+        constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+        constexpr uint64_t FNV_PRIME = 0x100000001b3ull;
+
+        constexpr size_t DATA_OFFSET =
+            (sizeof(AeroTableHeader) + AERO_TABLE_ALIGNMENT - 1) / AERO_TABLE_ALIGNMENT * AERO_TABLE_ALIGNMENT;
+
+        [[noreturn]] void fail(const std::string& reason) {
+            throw std::runtime_error("Aero table error: " + reason);
+        }
+
+        // --- Lookup kernels, one instantiation per axis count ---
+
+        // Blends the 2^D corners of a cell along axes 0..D-1, starting from the corner at `corner`.
+        template<size_t D>
+        inline void blend(const double* corner, const size_t* strides, const double* fractions, double* out) {
+            if constexpr (D == 0) {
+                std::copy_n(corner, AERO_COEFFICIENT_COUNT, out);
+            } else {
+                double low[AERO_COEFFICIENT_COUNT];
+                double high[AERO_COEFFICIENT_COUNT];
+                blend<D - 1>(corner, strides, fractions, low);
+                blend<D - 1>(corner + strides[D - 1], strides, fractions, high);
+                for (size_t k = 0; k < AERO_COEFFICIENT_COUNT; ++k) {
+                    out[k] = low[k] + fractions[D - 1] * (high[k] - low[k]);
+                }
+            }
+        }
+
+        template<size_t N>
+        AeroCoefficients lookupKernel(const AeroTable::Axis* axes, const size_t* strides, const double* values,
+                                      const AeroFlightCondition& condition) {
+            size_t offset = 0;
+            double fractions[N];
+            for (size_t d = 0; d < N; ++d) {
+                const UniformAxis::Cell cell = axes[d].grid.locate(condition.value(axes[d].parameter));
+                offset += cell.index * strides[d];
+                fractions[d] = cell.fraction;
+            }
+            double c[AERO_COEFFICIENT_COUNT];
+            blend<N>(values + offset, strides, fractions, c);
+            return {c[0], c[1], c[2], c[3], c[4], c[5]};
+        }
+
+#if STRIKEENGINE_SIMD_X86
+        // blend() for four lookups at once; corner holds each lane's offset into values.
+        template<size_t D>
+        __attribute__((target("avx2,fma")))
+        inline void blendAvx2(const double* values, __m128i corner, const int* strides, const __m256d* fractions,
+                              __m256d* out) {
+            if constexpr (D == 0) {
+                for (size_t k = 0; k < AERO_COEFFICIENT_COUNT; ++k) {
+                    out[k] = _mm256_i32gather_pd(values + k, corner, 8);
+                }
+            } else {
+                __m256d low[AERO_COEFFICIENT_COUNT];
+                __m256d high[AERO_COEFFICIENT_COUNT];
+                blendAvx2<D - 1>(values, corner, strides, fractions, low);
+                blendAvx2<D - 1>(values, _mm_add_epi32(corner, _mm_set1_epi32(strides[D - 1])), strides, fractions, high);
+                for (size_t k = 0; k < AERO_COEFFICIENT_COUNT; ++k) {
+                    out[k] = _mm256_fmadd_pd(fractions[D - 1], _mm256_sub_pd(high[k], low[k]), low[k]);
+                }
+            }
+        }
+
+        // Looks up whole blocks of four conditions and returns the number done. Each lane's
+        // parameters are gathered from the array of conditions, at the offsets the AeroFlightCondition
+        // static_asserts pin down, and its cell corners from the table.
+        template<size_t N>
+        __attribute__((target("avx2,fma")))
+        size_t lookupBatchAvx2(const AeroTable::Axis* axes, const size_t* strides, const double* values,
+                               const AeroFlightCondition* conditions, AeroCoefficients* out, size_t count) {
+            constexpr int STRIDE = sizeof(AeroFlightCondition) / sizeof(double);
+            const __m128i lanes = _mm_setr_epi32(0, STRIDE, 2 * STRIDE, 3 * STRIDE);
+            int lane_strides[N];
+            for (size_t d = 0; d < N; ++d) {
+                lane_strides[d] = static_cast<int>(strides[d]);
+            }
+
+            alignas(32) double results[AERO_COEFFICIENT_COUNT][4];
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                const double* parameters = reinterpret_cast<const double*>(conditions + i);
+                __m128i corner = _mm_setzero_si128();
+                __m256d fractions[N];
+                for (size_t d = 0; d < N; ++d) {
+                    const UniformAxis& grid = axes[d].grid;
+                    const __m256d value = _mm256_i32gather_pd(parameters + static_cast<size_t>(axes[d].parameter), lanes, 8);
+                    // As UniformAxis::locate; max(u, 0) returns 0 for NaN.
+                    const __m256d u = _mm256_min_pd(
+                        _mm256_max_pd(_mm256_mul_pd(_mm256_sub_pd(value, _mm256_set1_pd(grid.origin)),
+                                                    _mm256_set1_pd(grid.inverse_spacing)), _mm256_setzero_pd()),
+                        _mm256_set1_pd(grid.points - 1.0));
+                    const __m256d index = _mm256_min_pd(_mm256_floor_pd(u), _mm256_set1_pd(grid.points - 2.0));
+                    fractions[d] = _mm256_sub_pd(u, index);
+                    corner = _mm_add_epi32(corner, _mm_mullo_epi32(_mm256_cvttpd_epi32(index), _mm_set1_epi32(lane_strides[d])));
+                }
+
+                __m256d blended[AERO_COEFFICIENT_COUNT];
+                blendAvx2<N>(values, corner, lane_strides, fractions, blended);
+                for (size_t k = 0; k < AERO_COEFFICIENT_COUNT; ++k) {
+                    _mm256_store_pd(results[k], blended[k]);
+                }
+                for (int lane = 0; lane < 4; ++lane) {
+                    out[i + lane] = {results[0][lane], results[1][lane], results[2][lane],
+                                     results[3][lane], results[4][lane], results[5][lane]};
+                }
+            }
+            return i;
+        }
+#endif
+
+        template<size_t... N>
+        constexpr auto makeLookupKernels(std::index_sequence<N...>) {
+            return std::array{lookupKernel<N + 1>...};
+        }
+
+        constexpr auto LOOKUP_KERNELS = makeLookupKernels(std::make_index_sequence<AERO_MAX_AXES>{});
+
+#if STRIKEENGINE_SIMD_X86
+        template<size_t... N>
+        constexpr auto makeBatchKernels(std::index_sequence<N...>) {
+            return std::array{lookupBatchAvx2<N + 1>...};
+        }
+
+        constexpr auto BATCH_KERNELS = makeBatchKernels(std::make_index_sequence<AERO_MAX_AXES>{});
+#endif
+
+        void validateAxes(std::span<const AeroTable::Axis> axes) {
+            if (axes.empty() || axes.size() > AERO_MAX_AXES) {
+                throw std::runtime_error("AeroTable error: A table needs between 1 and 6 axes.");
+            }
+            bool used[PARAMETER_COUNT] = {};
+            for (const AeroTable::Axis& axis : axes) {
+                const auto parameter = static_cast<size_t>(axis.parameter);
+                if (parameter >= PARAMETER_COUNT || used[parameter]) {
+                    throw std::runtime_error("AeroTable error: Each axis needs its own flight parameter.");
+                }
+                used[parameter] = true;
+                if (axis.grid.points < 2 || !(axis.grid.spacing > 0.0) || !std::isfinite(axis.grid.origin) ||
+                    !std::isfinite(axis.grid.spacing)) {
+                    throw std::runtime_error("AeroTable error: An axis needs at least two evenly spaced points.");
+                }
+            }
+        }
+    }
+
+    AeroTable::AeroTable(std::span<const Axis> axes, std::span<const AeroCoefficients> values) {
+        setAxes(axes, values.size());
+        const size_t bytes = (values.size_bytes() + TABLE_ALIGNMENT - 1) / TABLE_ALIGNMENT * TABLE_ALIGNMENT;
+        _storage.reset(static_cast<double*>(::operator new(bytes, std::align_val_t{TABLE_ALIGNMENT})));
+        std::memcpy(_storage.get(), values.data(), values.size_bytes());
+        _values = _storage.get();
+    }
+
+    AeroTable AeroTable::view(std::span<const Axis> axes, std::span<const AeroCoefficients> values) {
+        AeroTable table;
+        table.setAxes(axes, values.size());
+        table._values = reinterpret_cast<const double*>(values.data());
+        return table;
+    }
+
+    void AeroTable::setAxes(std::span<const Axis> axes, size_t valueCount) {
+        validateAxes(axes);
+        size_t points = 1;
+        for (const Axis& axis : axes) {
+            if (points > valueCount / axis.grid.points) {
+                throw std::runtime_error("AeroTable error: The values do not match the axes.");
+            }
+            points *= axis.grid.points;
+        }
+        if (valueCount != points) {
+            throw std::runtime_error("AeroTable error: The values do not match the axes.");
+        }
+
+        _axis_count = axes.size();
+        std::ranges::copy(axes, _axes.begin());
+        for (Axis& axis : std::span(_axes.data(), _axis_count)) {
+            axis.grid.inverse_spacing = 1.0 / axis.grid.spacing;
+        }
+        size_t stride = AERO_COEFFICIENT_COUNT;
+        for (size_t d = _axis_count; d-- > 0;) {
+            _strides[d] = stride;
+            stride *= _axes[d].grid.points;
+        }
+        _point_count = points;
+
+        _lookup = LOOKUP_KERNELS[_axis_count - 1];
+#if STRIKEENGINE_SIMD_X86
+        // The gathers take 32-bit offsets.
+        if (stride <= INT32_MAX && detectSimdLevel() >= SimdLevel::AVX2) {
+            _lookup_batch = BATCH_KERNELS[_axis_count - 1];
+        }
+#endif
+    }
+
+    bool AeroTable::isExact() const {
+        return std::ranges::all_of(axes(), [](const Axis& axis) { return axis.grid.exact; });
+    }
+
+    bool AeroTable::hasAxis(AeroParameter parameter) const {
+        return std::ranges::any_of(axes(), [parameter](const Axis& axis) { return axis.parameter == parameter; });
+    }
+
+    AeroCoefficients AeroTable::lookup(const AeroFlightCondition& condition) const {
+        if (empty()) {
+            return {};
+        }
+        return _lookup(_axes.data(), _strides.data(), _values, condition);
+    }
+
+    void AeroTable::lookup(std::span<const AeroFlightCondition> conditions, std::span<AeroCoefficients> out) const {
+        if (out.size() < conditions.size()) {
+            throw std::runtime_error("AeroTable error: Output span is shorter than the condition span.");
+        }
+        size_t done = 0;
+        if (_lookup_batch) {
+            done = _lookup_batch(_axes.data(), _strides.data(), _values, conditions.data(), out.data(),
+                                 conditions.size());
+        }
+        for (size_t i = done; i < conditions.size(); ++i) {
+            out[i] = lookup(conditions[i]);
+        }
+    }
+
+    AeroTable compileAeroTable(std::span<const AeroAxisBreakpoints> axes, std::span<const AeroCoefficients> values,
+                               const AeroTableOptions& options) {
+        if (axes.empty() || axes.size() > AERO_MAX_AXES) {
+            throw std::runtime_error("AeroTable error: A table needs between 1 and 6 axes.");
+        }
+
+        // Source strides, in points, and the uniform grid of every axis.
+        const size_t n = axes.size();
+        std::vector<AeroTable::Axis> grids(n);
+        std::vector<size_t> source_strides(n);
+        size_t source_points = 1;
+        for (size_t d = n; d-- > 0;) {
+            source_strides[d] = source_points;
+            source_points *= axes[d].breakpoints.size();
+            grids[d] = {axes[d].parameter,
+                        makeUniformAxis(axes[d].breakpoints, options.breakpoint_tolerance, options.max_axis_points)};
+        }
+        if (values.size() != source_points) {
+            throw std::runtime_error("AeroTable error: The values do not match the breakpoints.");
+        }
+
+        // Where every grid point falls among the source breakpoints, per axis.
+        std::vector<std::vector<UniformAxis::Cell>> cells(n);
+        size_t grid_points = 1;
+        for (size_t d = 0; d < n; ++d) {
+            for (uint32_t i = 0; i < grids[d].grid.points; ++i) {
+                cells[d].push_back(locateBreakpoint(axes[d].breakpoints, grids[d].grid.at(i)));
+            }
+            grid_points *= grids[d].grid.points;
+        }
+
+        // Visit the grid points in storage order, blending the 2^n source corners around each.
+        std::vector<AeroCoefficients> resampled(grid_points);
+        std::vector<uint32_t> point(n, 0);
+        for (AeroCoefficients& target : resampled) {
+            double sum[AERO_COEFFICIENT_COUNT] = {};
+            for (size_t corner = 0; corner < (size_t{1} << n); ++corner) {
+                double weight = 1.0;
+                size_t source = 0;
+                for (size_t d = 0; d < n; ++d) {
+                    const UniformAxis::Cell& cell = cells[d][point[d]];
+                    const bool upper = (corner >> d) & 1;
+                    weight *= upper ? cell.fraction : 1.0 - cell.fraction;
+                    const size_t index = std::min<size_t>(cell.index + upper, axes[d].breakpoints.size() - 1);
+                    source += index * source_strides[d];
+                }
+                if (weight != 0.0) {
+                    for (size_t k = 0; k < AERO_COEFFICIENT_COUNT; ++k) {
+                        sum[k] += weight * values[source].coefficient(k);
+                    }
+                }
+            }
+            target = {sum[0], sum[1], sum[2], sum[3], sum[4], sum[5]};
+
+            for (size_t d = n; d-- > 0;) {
+                if (++point[d] < grids[d].grid.points) {
+                    break;
+                }
+                point[d] = 0;
+            }
+        }
+        return {grids, resampled};
+    }
+
+    uint64_t aeroTableChecksum(std::span<const AeroCoefficients> values) {
+        const auto* words = reinterpret_cast<const uint64_t*>(values.data());
+        const size_t count = values.size() * AERO_COEFFICIENT_COUNT;
+        uint64_t hash = FNV_OFFSET_BASIS;
+        for (size_t i = 0; i < count; ++i) {
+            hash = (hash ^ words[i]) * FNV_PRIME;
+        }
+        return hash;
+    }
+
+    void writeAeroTable(const std::string& filepath, const AeroTable& table) {
+        if (table.empty()) {
+            fail("Cannot write an empty table.");
+        }
+
+        AeroTableHeader header{};
+        std::memcpy(header.magic, AERO_TABLE_MAGIC, sizeof(header.magic));
+        header.version = AERO_TABLE_VERSION;
+        header.header_size = sizeof(AeroTableHeader);
+        header.axis_count = static_cast<uint32_t>(table.axes().size());
+        header.coefficient_count = AERO_COEFFICIENT_COUNT;
+        for (size_t d = 0; d < table.axes().size(); ++d) {
+            const AeroTable::Axis& axis = table.axes()[d];
+            header.axes[d] = {static_cast<uint32_t>(axis.parameter), axis.grid.points, axis.grid.origin,
+                              axis.grid.spacing, axis.grid.exact ? 1u : 0u, 0};
+        }
+        header.point_count = table.values().size();
+        header.data_offset = DATA_OFFSET;
+        std::memcpy(header.fields, AERO_TABLE_FIELDS, sizeof(AERO_TABLE_FIELDS));
+        header.checksum = aeroTableChecksum(table.values());
+
+        std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            fail("Failed to open file for writing: " + filepath);
+        }
+        const char padding[DATA_OFFSET - sizeof(AeroTableHeader)] = {};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(padding, sizeof(padding));
+        out.write(reinterpret_cast<const char*>(table.values().data()),
+                  static_cast<std::streamsize>(table.values().size_bytes()));
+        if (!out) {
+            fail("Failed to write " + filepath);
+        }
+    }
+
+    AeroTable readAeroTable(std::span<const std::byte> bytes) {
+        if (bytes.size() < sizeof(AeroTableHeader)) {
+            fail("The file is too short for a header.");
+        }
+        AeroTableHeader header{};
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (std::memcmp(header.magic, AERO_TABLE_MAGIC, sizeof(header.magic)) != 0) {
+            fail("Not an aero table; compile it with CompileAeroProfile.");
+        }
+        if (header.version != AERO_TABLE_VERSION) {
+            fail("Unsupported version " + std::to_string(header.version) + ", expected " +
+                 std::to_string(AERO_TABLE_VERSION) + ".");
+        }
+        const bool layout_matches = header.header_size == sizeof(AeroTableHeader) &&
+                                    header.coefficient_count == AERO_COEFFICIENT_COUNT &&
+                                    header.data_offset == DATA_OFFSET &&
+                                    std::memcmp(header.fields, AERO_TABLE_FIELDS, sizeof(AERO_TABLE_FIELDS)) == 0 &&
+                                    std::all_of(header.fields + sizeof(AERO_TABLE_FIELDS), std::end(header.fields),
+                                                [](char c) { return c == '\0'; });
+        if (!layout_matches) {
+            fail("The layout does not match this build's AeroCoefficients.");
+        }
+        if (header.axis_count == 0 || header.axis_count > AERO_MAX_AXES) {
+            fail("A table needs between 1 and 6 axes.");
+        }
+        if (bytes.size() < header.data_offset ||
+            (bytes.size() - header.data_offset) / sizeof(AeroCoefficients) != header.point_count ||
+            (bytes.size() - header.data_offset) % sizeof(AeroCoefficients) != 0) {
+            fail("The file size does not match its point count.");
+        }
+        if (reinterpret_cast<uintptr_t>(bytes.data()) % alignof(AeroCoefficients) != 0) {
+            fail("The table is not aligned for reading in place.");
+        }
+
+        const std::span values(reinterpret_cast<const AeroCoefficients*>(bytes.data() + header.data_offset),
+                               static_cast<size_t>(header.point_count));
+        if (aeroTableChecksum(values) != header.checksum) {
+            fail("Checksum mismatch; the table is corrupt.");
+        }
+
+        std::vector<AeroTable::Axis> axes(header.axis_count);
+        for (size_t d = 0; d < axes.size(); ++d) {
+            const AeroTableAxisRecord& record = header.axes[d];
+            axes[d] = {static_cast<AeroParameter>(record.parameter),
+                       {record.origin, record.spacing, 1.0 / record.spacing, record.points, record.exact != 0}};
+        }
+        try {
+            return AeroTable::view(axes, values);
+        } catch (const std::runtime_error& e) {
+            fail(e.what());
+        }
+    }
+
+} // namespace StrikeEngine
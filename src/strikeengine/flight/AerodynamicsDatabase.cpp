@@ -4,69 +4,139 @@
 #include <stdexcept>
 #include <algorithm>
 #include <iostream>
+#include <vector>
 
 namespace StrikeEngine {
 
     using json = nlohmann::json;
 
+    namespace {
+        // JSON names of the AeroFlightCondition fields and AeroCoefficients members, in order.
+        constexpr const char* PARAMETER_NAMES[AERO_MAX_AXES] = {
+            "mach", "alpha_rad", "beta_rad", "pitch_deflection_rad", "yaw_deflection_rad", "altitude_m"};
+        constexpr const char* COEFFICIENT_NAMES[AERO_COEFFICIENT_COUNT] = {"cl", "cd", "cy", "cr", "cm", "cn"};
+
+        AeroTable compileTableProfile(const json& data, const AeroTableOptions& options) {
+            std::vector<AeroAxisBreakpoints> axes;
+            size_t points = 1;
+            for (const json& axis : data.at("axes")) {
+                const std::string name = axis.at("parameter").get<std::string>();
+                const auto parameter = std::ranges::find(PARAMETER_NAMES, name) - std::begin(PARAMETER_NAMES);
+                if (parameter == AERO_MAX_AXES) {
+                    throw std::runtime_error("Unknown axis parameter '" + name + "'.");
+                }
+                axes.push_back({static_cast<AeroParameter>(parameter), axis.at("breakpoints").get<std::vector<double>>()});
+                points *= axes.back().breakpoints.size();
+            }
+
+            std::vector<AeroCoefficients> values(points);
+            const json& coefficients = data.at("coefficients");
+            for (size_t k = 0; k < AERO_COEFFICIENT_COUNT; ++k) {
+                if (!coefficients.contains(COEFFICIENT_NAMES[k])) {
+                    continue;
+                }
+                const auto column = coefficients.at(COEFFICIENT_NAMES[k]).get<std::vector<double>>();
+                if (column.size() != points) {
+                    throw std::runtime_error(std::string("Coefficient '") + COEFFICIENT_NAMES[k] +
+                                             "' does not match the breakpoints.");
+                }
+                for (size_t i = 0; i < points; ++i) {
+                    values[i].coefficient(k) = column[i];
+                }
+            }
+            return compileAeroTable(axes, values, options);
+        }
+
+        AeroTable compileLegacyProfile(const json& data, const AeroTableOptions& options) {
+            const auto machBreakpoints = data.at("mach_breakpoints").get<std::vector<double>>();
+            const auto aoaBreakpointsRad = data.at("aoa_breakpoints_rad").get<std::vector<double>>();
+            const auto clTable = data.at("cl_table").get<std::vector<std::vector<double>>>();
+            const auto cdTable = data.at("cd_table").get<std::vector<std::vector<double>>>();
+
+            auto matches = [&](const std::vector<std::vector<double>>& table) {
+                return table.size() == machBreakpoints.size() &&
+                       std::ranges::all_of(table, [&](const auto& row) { return row.size() == aoaBreakpointsRad.size(); });
+            };
+            if (machBreakpoints.empty() || aoaBreakpointsRad.empty() || !matches(clTable) || !matches(cdTable)) {
+                throw std::runtime_error("The tables do not match their breakpoints.");
+            }
+
+            // --- Mirror the angle of attack to negative alpha: lift is odd in alpha, drag even ---
+            // source[a] and sign[a] give where each mirrored breakpoint's values come from.
+            std::vector<size_t> source;
+            std::vector<double> alpha;
+            std::vector<double> sign;
+            if (aoaBreakpointsRad.front() >= 0.0) {
+                for (size_t a = aoaBreakpointsRad.size(); a-- > 0;) {
+                    if (aoaBreakpointsRad[a] > 0.0) {
+                        source.push_back(a);
+                        alpha.push_back(-aoaBreakpointsRad[a]);
+                        sign.push_back(-1.0);
+                    }
+                }
+            }
+            for (size_t a = 0; a < aoaBreakpointsRad.size(); ++a) {
+                source.push_back(a);
+                alpha.push_back(aoaBreakpointsRad[a]);
+                sign.push_back(1.0);
+            }
+
+            std::vector<AeroCoefficients> values;
+            values.reserve(machBreakpoints.size() * alpha.size());
+            for (size_t m = 0; m < machBreakpoints.size(); ++m) {
+                for (size_t a = 0; a < alpha.size(); ++a) {
+                    AeroCoefficients point;
+                    point.Cl = sign[a] * clTable[m][source[a]];
+                    point.Cd = cdTable[m][source[a]];
+                    values.push_back(point);
+                }
+            }
+
+            const AeroAxisBreakpoints axes[] = {{AeroParameter::Mach, machBreakpoints}, {AeroParameter::Alpha, alpha}};
+            return compileAeroTable(axes, values, options);
+        }
+    }
+
+    AerodynamicsDatabase::AerodynamicsDatabase(const AeroTableOptions& options) : _options(options) {
+    }
+
     bool AerodynamicsDatabase::loadProfile(const std::string& filepath) {
+        _table = {};
+        _file.close();
+        if (filepath.ends_with(".json")) {
+            return loadJsonProfile(filepath);
+        }
+
+        if (!_file.open(filepath)) {
+            return false;
+        }
+        try {
+            _table = readAeroTable(_file.bytes());
+        } catch (const std::runtime_error& e) {
+            std::cerr << "Error loading aerodynamic profile " << filepath << ": " << e.what() << std::endl;
+            _file.close();
+            return false;
+        }
+        return true;
+    }
+
+    bool AerodynamicsDatabase::loadJsonProfile(const std::string& filepath) {
         std::ifstream file(filepath);
         if (!file.is_open()) {
             return false;
         }
 
         try {
-            json data = json::parse(file);
-            _machBreakpoints = data.at("mach_breakpoints").get<std::vector<double>>();
-            _aoaBreakpointsRad = data.at("aoa_breakpoints_rad").get<std::vector<double>>();
-            _clTable = data.at("cl_table").get<std::vector<std::vector<double>>>();
-            _cdTable = data.at("cd_table").get<std::vector<std::vector<double>>>();
+            const json data = json::parse(file);
+            _table = data.contains("axes") ? compileTableProfile(data, _options) : compileLegacyProfile(data, _options);
         } catch (const json::exception& e) {
             std::cerr << "Error parsing aerodynamic profile file: " << filepath << std::endl;
             return false;
+        } catch (const std::runtime_error& e) {
+            std::cerr << "Error in aerodynamic profile " << filepath << ": " << e.what() << std::endl;
+            return false;
         }
         return true;
     }
 
-    AeroCoefficients AerodynamicsDatabase::getCoefficients(double mach, double AoARad) const {
-        if (_machBreakpoints.empty() || _aoaBreakpointsRad.empty()) {
-            return {};
-        }
-
-        auto it_mach = std::ranges::upper_bound(_machBreakpoints, mach);
-        size_t i_mach1 = std::distance(_machBreakpoints.begin(), it_mach) - 1;
-        size_t i_mach2 = i_mach1 + 1;
-        if (i_mach1 < 0) i_mach1 = 0;
-        if (i_mach2 >= _machBreakpoints.size()) i_mach2 = _machBreakpoints.size() - 1;
-        double machFraction = (mach - _machBreakpoints[i_mach1]) / (_machBreakpoints[i_mach2] - _machBreakpoints[i_mach1]);
-        machFraction = std::clamp(machFraction, 0.0, 1.0);
-
-        // Find the indices and fractions for interpolation for AoA
-        auto it_aoa = std::ranges::upper_bound(_aoaBreakpointsRad, AoARad);
-        size_t j_aoa1 = std::distance(_aoaBreakpointsRad.begin(), it_aoa) - 1;
-        size_t j_aoa2 = j_aoa1 + 1;
-        if (j_aoa1 < 0) j_aoa1 = 0;
-        if (j_aoa2 >= _aoaBreakpointsRad.size()) j_aoa2 = _aoaBreakpointsRad.size() - 1;
-        double AoAFraction = (AoARad - _aoaBreakpointsRad[j_aoa1]) / (_aoaBreakpointsRad[j_aoa2] - _aoaBreakpointsRad[j_aoa1]);
-        AoAFraction = std::clamp(AoAFraction, 0.0, 1.0);
-
-        // Bilinear interpolation function
-        auto interpolate = [&](const std::vector<std::vector<double>>& table) {
-            const double c00 = table[i_mach1][j_aoa1];
-            const double c10 = table[i_mach2][j_aoa1];
-            const double c01 = table[i_mach1][j_aoa2];
-            const double c11 = table[i_mach2][j_aoa2];
-
-            const double r1 = c00 * (1.0 - machFraction) + c10 * machFraction;
-            const double r2 = c01 * (1.0 - machFraction) + c11 * machFraction;
-
-            return r1 * (1.0 - AoAFraction) + r2 * AoAFraction;
-        };
-
-        AeroCoefficients coefficients;
-        coefficients.Cl = interpolate(_clTable);
-        coefficients.Cd = interpolate(_cdTable);
-        return coefficients;
-    }
-
 } // namespace StrikeEngine
@@ -0,0 +1,117 @@
+#include "strikeengine/flight/ProfileRegistry.hpp"
+#include "strikeengine/flight/AerodynamicsDatabase.hpp"
+#include "strikeengine/flight/IRSignatureDatabase.hpp"
+#include "strikeengine/flight/RCSDatabase.hpp"
+#include "strikeengine/components/metadata/InfraredSignatureComponent.hpp"
+#include "strikeengine/components/metadata/RCSProfileComponent.hpp"
+#include "strikeengine/components/physics/AerodynamicProfileComponent.hpp"
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+
+namespace StrikeEngine {
+
+    ProfileRegistry& ProfileRegistry::instance() {
+        static ProfileRegistry registry;
+        return registry;
+    }
+
+    ProfileRegistry::ProfileRegistry() = default;
+
+    ProfileRegistry::~ProfileRegistry() = default;
+
+    ProfileId ProfileRegistry::intern(std::string_view name) {
+        {
+            std::shared_lock lock(_mutex);
+            if (const auto it = _ids.find(name); it != _ids.end()) {
+                return it->second;
+            }
+        }
+        std::unique_lock lock(_mutex);
+        if (const auto it = _ids.find(name); it != _ids.end()) {
+            return it->second;
+        }
+        const auto id = static_cast<ProfileId>(_names.size());
+        _ids.emplace(_names.emplace_back(name), id);
+        return id;
+    }
+
+    const std::string& ProfileRegistry::name(ProfileId id) const {
+        std::shared_lock lock(_mutex);
+        const auto index = static_cast<size_t>(id);
+        if (index >= _names.size()) {
+            throw std::runtime_error("ProfileRegistry error: Unknown profile ID.");
+        }
+        return _names[index];
+    }
+
+    template<typename Database, typename Loader>
+    const Database* ProfileRegistry::resolve(std::unordered_map<ProfileId, std::unique_ptr<const Database>>& databases,
+                                             ProfileId id, Loader&& load) {
+        {
+            std::shared_lock lock(_mutex);
+            if (const auto it = databases.find(id); it != databases.end()) {
+                return it->second.get();
+            }
+        }
+        std::unique_lock lock(_mutex);
+        if (const auto it = databases.find(id); it != databases.end()) {
+            return it->second.get();
+        }
+
+        // Loaded under the lock, so concurrent requests for one profile load it once.
+        const std::string& name = _names.at(static_cast<size_t>(id));
+        auto database = std::make_unique<Database>();
+        bool loaded = false;
+        try {
+            loaded = load(*database, name);
+        } catch (const std::exception& e) {
+            std::cerr << "ProfileRegistry: Failed to load profile " << name << ": " << e.what() << std::endl;
+        }
+        if (!loaded) {
+            database.reset();
+        }
+        return databases.emplace(id, std::move(database)).first->second.get();
+    }
+
+    const AerodynamicsDatabase* ProfileRegistry::aerodynamics(ProfileId id) {
+        return resolve(_aerodynamics, id, [](AerodynamicsDatabase& database, const std::string& profileId) {
+            // A compiled aero table is preferred over the JSON profile.
+            const std::string path = "data/aero/" + profileId;
+            return database.loadProfile(path + ".aero") || database.loadProfile(path + ".json");
+        });
+    }
+
+    const RCSDatabase* ProfileRegistry::rcs(ProfileId path) {
+        return resolve(_rcs, path, [](RCSDatabase& database, const std::string& file) { return database.loadProfile(file); });
+    }
+
+    const IRSignatureDatabase* ProfileRegistry::infrared(ProfileId path) {
+        return resolve(_infrared, path, [](IRSignatureDatabase& database, const std::string& file) {
+            return database.loadProfile(file);
+        });
+    }
+
+    void onAdd(AerodynamicProfileComponent& component) {
+        if (!component.resolved && !component.profileID.empty()) {
+            component.database = ProfileRegistry::instance().aerodynamics(component.profileID);
+            component.resolved = true;
+        }
+    }
+
+    void onAdd(RCSProfileComponent& component) {
+        if (!component.resolved && !component.profile_path.empty()) {
+            component.database = ProfileRegistry::instance().rcs(component.profile_path);
+            component.resolved = true;
+        }
+    }
+
+    void onAdd(InfraredSignatureComponent& component) {
+        if (!component.resolved && !component.profile_path.empty()) {
+            component.database = ProfileRegistry::instance().infrared(component.profile_path);
+            component.resolved = true;
+        }
+    }
+
+} // namespace StrikeEngine
@@ -1,87 +1,201 @@
 #include "strikeengine/flight/RCSDatabase.hpp"
+#include "strikeengine/core/Simd.hpp"
 #include "nlohmann/json.hpp"
 #include <fstream>
 #include <stdexcept>
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <utility>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 #include <glm/trigonometric.hpp>
 
+#if STRIKEENGINE_SIMD_X86
+#include <immintrin.h>
+#endif
+
 namespace StrikeEngine {
 
-    bool RCSDatabase::loadProfile(const std::string& file_path) {
-        std::ifstream f(file_path);
-        if (!f.is_open()) {
-            return false;
+    namespace {
+        // As the AeroTableOptions defaults: how far a breakpoint may sit from a grid point, as a
+        // fraction of the spacing, and the most points a resampled axis may have.
+        constexpr double BREAKPOINT_TOLERANCE = 1e-6;
+        constexpr uint32_t MAX_AXIS_POINTS = 1024;
+
+        // log2(10) / 10: dBsm to log2 of m^2.
+        constexpr double DB_TO_LOG2 = std::numbers::ln10 / std::numbers::ln2 / 10.0;
+
+        // Interpolates a bilinear cell of log2 values; row is the distance between elevation rows.
+        double blendLog2(const double* cell, size_t row, const UniformAxis::Cell& azimuth, const UniformAxis::Cell& elevation) {
+            const double low = cell[0] + azimuth.fraction * (cell[1] - cell[0]);
+            const double high = cell[row] + azimuth.fraction * (cell[row + 1] - cell[row]);
+            return low + elevation.fraction * (high - low);
         }
 
-        nlohmann::json data;
-        try {
-            data = nlohmann::json::parse(f);
-        } catch (const nlohmann::json::parse_error& e) {
-            return false;
+#if STRIKEENGINE_SIMD_X86
+        // The Taylor series of 2^f = e^(f ln 2); to degree 12 it is within 2e-16 for |f| <= 0.5.
+        constexpr std::array<double, 13> EXP2_TAYLOR = [] {
+            std::array<double, 13> c{};
+            double term = 1.0;
+            for (size_t k = 0; k < c.size(); ++k) {
+                c[k] = term;
+                term *= std::numbers::ln2 / static_cast<double>(k + 1);
+            }
+            return c;
+        }();
+
+        // 2^x: 2^f for the fraction about the nearest integer n, scaled by adding n to the
+        // exponent. x is clamped to where the result stays a normal double.
+        __attribute__((target("avx2,fma")))
+        inline __m256d exp2Avx2(__m256d x) {
+            x = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(-1021.0)), _mm256_set1_pd(1023.0));
+            const __m256d n = _mm256_round_pd(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            const __m256d f = _mm256_sub_pd(x, n);
+            __m256d p = _mm256_set1_pd(EXP2_TAYLOR.back());
+            for (size_t k = EXP2_TAYLOR.size() - 1; k-- > 0;) {
+                p = _mm256_fmadd_pd(p, f, _mm256_set1_pd(EXP2_TAYLOR[k]));
+            }
+            const __m256i exponent = _mm256_slli_epi64(_mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(n)), 52);
+            return _mm256_castsi256_pd(_mm256_add_epi64(_mm256_castpd_si256(p), exponent));
         }
 
-        _name = data.value("name", "Unnamed RCS Profile");
+        // As UniformAxis::locate, for four values; max(u, 0) returns 0 for NaN.
+        __attribute__((target("avx2,fma")))
+        inline __m256d locateAvx2(const UniformAxis& axis, __m256d value, __m256d& fraction) {
+            const __m256d u = _mm256_min_pd(
+                _mm256_max_pd(_mm256_mul_pd(_mm256_sub_pd(value, _mm256_set1_pd(axis.origin)),
+                                            _mm256_set1_pd(axis.inverse_spacing)), _mm256_setzero_pd()),
+                _mm256_set1_pd(axis.points - 1.0));
+            const __m256d index = _mm256_min_pd(_mm256_floor_pd(u), _mm256_set1_pd(axis.points - 2.0));
+            fraction = _mm256_sub_pd(u, index);
+            return index;
+        }
 
-        // Load breakpoints and convert from degrees to radians
-        auto az_deg = data.at("azimuth_breakpoints_deg").get<std::vector<double>>();
-        for (double deg : az_deg) {
-            _azimuth_breakpoints_rad.push_back(glm::radians(deg));
+        // Looks up whole blocks of four aspects and returns the number done.
+        __attribute__((target("avx2,fma")))
+        size_t rcsBatchAvx2(const UniformAxis& azimuth, const UniformAxis& elevation, const double* values,
+                            const double* azimuth_rad, const double* elevation_rad, double* out, size_t count) {
+            const int row = static_cast<int>(azimuth.points);
+            const __m128i right = _mm_set1_epi32(1);
+            const __m128i up = _mm_set1_epi32(row);
+            size_t i = 0;
+            for (; i + 4 <= count; i += 4) {
+                __m256d az_fraction;
+                __m256d el_fraction;
+                const __m256d az_index = locateAvx2(azimuth, _mm256_loadu_pd(azimuth_rad + i), az_fraction);
+                const __m256d el_index = locateAvx2(elevation, _mm256_loadu_pd(elevation_rad + i), el_fraction);
+                const __m128i corner = _mm_add_epi32(_mm_mullo_epi32(_mm256_cvttpd_epi32(el_index), up),
+                                                     _mm256_cvttpd_epi32(az_index));
+                const __m128i above = _mm_add_epi32(corner, up);
+
+                const __m256d v00 = _mm256_i32gather_pd(values, corner, 8);
+                const __m256d v01 = _mm256_i32gather_pd(values, _mm_add_epi32(corner, right), 8);
+                const __m256d v10 = _mm256_i32gather_pd(values, above, 8);
+                const __m256d v11 = _mm256_i32gather_pd(values, _mm_add_epi32(above, right), 8);
+                const __m256d low = _mm256_fmadd_pd(az_fraction, _mm256_sub_pd(v01, v00), v00);
+                const __m256d high = _mm256_fmadd_pd(az_fraction, _mm256_sub_pd(v11, v10), v10);
+                const __m256d log2_rcs = _mm256_fmadd_pd(el_fraction, _mm256_sub_pd(high, low), low);
+                _mm256_storeu_pd(out + i, exp2Avx2(log2_rcs));
+            }
+            return i;
         }
+#endif
+    }
 
-        auto el_deg = data.at("elevation_breakpoints_deg").get<std::vector<double>>();
-        for (double deg : el_deg) {
-            _elevation_breakpoints_rad.push_back(glm::radians(deg));
+    bool RCSDatabase::loadProfile(const std::string& file_path) {
+        std::ifstream f(file_path);
+        if (!f.is_open()) {
+            return false;
         }
 
-        _rcs_table_dbsm = data.at("rcs_table_dbsm").get<std::vector<std::vector<double>>>();
+        // Everything is built in locals and only committed once it is all valid, so a profile
+        // that fails to load leaves the previous one intact.
+        std::string name;
+        UniformAxis azimuth;
+        UniformAxis elevation;
+        std::vector<double> rcs_log2;
+        try {
+            const nlohmann::json data = nlohmann::json::parse(f);
+            name = data.value("name", "Unnamed RCS Profile");
+
+            // Load breakpoints and convert from degrees to radians
+            std::vector<double> azimuth_breakpoints_rad;
+            for (double deg : data.at("azimuth_breakpoints_deg").get<std::vector<double>>()) {
+                azimuth_breakpoints_rad.push_back(glm::radians(deg));
+            }
+
+            std::vector<double> elevation_breakpoints_rad;
+            for (double deg : data.at("elevation_breakpoints_deg").get<std::vector<double>>()) {
+                elevation_breakpoints_rad.push_back(glm::radians(deg));
+            }
+
+            // One row per elevation breakpoint, one column per azimuth breakpoint.
+            const auto rcs_table_dbsm = data.at("rcs_table_dbsm").get<std::vector<std::vector<double>>>();
+            if (azimuth_breakpoints_rad.empty() || elevation_breakpoints_rad.empty() ||
+                rcs_table_dbsm.size() != elevation_breakpoints_rad.size() ||
+                std::ranges::any_of(rcs_table_dbsm, [&](const auto& r) { return r.size() != azimuth_breakpoints_rad.size(); })) {
+                return false;
+            }
+
+            // Resample the table onto uniform grids, interpolating in dBsm as the lookups do.
+            // makeUniformAxis throws on breakpoints that are not strictly increasing.
+            azimuth = makeUniformAxis(azimuth_breakpoints_rad, BREAKPOINT_TOLERANCE, MAX_AXIS_POINTS);
+            elevation = makeUniformAxis(elevation_breakpoints_rad, BREAKPOINT_TOLERANCE, MAX_AXIS_POINTS);
+            rcs_log2.assign(static_cast<size_t>(azimuth.points) * elevation.points, 0.0);
+            for (uint32_t e = 0; e < elevation.points; ++e) {
+                const UniformAxis::Cell el = locateBreakpoint(elevation_breakpoints_rad, elevation.at(e));
+                const auto& low_row = rcs_table_dbsm[el.index];
+                const auto& high_row = rcs_table_dbsm[std::min<size_t>(el.index + 1, rcs_table_dbsm.size() - 1)];
+                for (uint32_t a = 0; a < azimuth.points; ++a) {
+                    const UniformAxis::Cell az = locateBreakpoint(azimuth_breakpoints_rad, azimuth.at(a));
+                    const size_t next = std::min<size_t>(az.index + 1, azimuth_breakpoints_rad.size() - 1);
+                    const double low = low_row[az.index] + az.fraction * (low_row[next] - low_row[az.index]);
+                    const double high = high_row[az.index] + az.fraction * (high_row[next] - high_row[az.index]);
+                    rcs_log2[static_cast<size_t>(e) * azimuth.points + a] = (low + el.fraction * (high - low)) * DB_TO_LOG2;
+                }
+            }
+        } catch (const std::exception&) {
+            return false;
+        }
 
+        _name = std::move(name);
+        _azimuth = azimuth;
+        _elevation = elevation;
+        _rcs_log2 = std::move(rcs_log2);
         return true;
     }
 
     double RCSDatabase::getRCS(double azimuth_rad, double elevation_rad) const {
-        if (_azimuth_breakpoints_rad.empty() || _elevation_breakpoints_rad.empty()) {
+        if (_rcs_log2.empty()) {
             return 1.0; // Default RCS if no data is loaded
         }
 
-        // --- Bilinear Interpolation Logic ---
-
-        // Find indices for azimuth
-        auto it_az = std::ranges::lower_bound(_azimuth_breakpoints_rad, azimuth_rad);
-        int j = std::distance(_azimuth_breakpoints_rad.begin(), it_az);
-        if (j >= _azimuth_breakpoints_rad.size()) j = _azimuth_breakpoints_rad.size() - 1;
-        if (j == 0) j = 1;
-
-        // Find indices for elevation
-        auto it_el = std::ranges::lower_bound(_elevation_breakpoints_rad, elevation_rad);
-        int i = std::distance(_elevation_breakpoints_rad.begin(), it_el);
-        if (i >= _elevation_breakpoints_rad.size()) i = _elevation_breakpoints_rad.size() - 1;
-        if (i == 0) i = 1;
-
-        // Get the four corner points for interpolation
-        double az1 = _azimuth_breakpoints_rad[j - 1];
-        double az2 = _azimuth_breakpoints_rad[j];
-        double el1 = _elevation_breakpoints_rad[i - 1];
-        double el2 = _elevation_breakpoints_rad[i];
-
-        double rcs_dbsm_11 = _rcs_table_dbsm[i - 1][j - 1];
-        double rcs_dbsm_12 = _rcs_table_dbsm[i - 1][j];
-        double rcs_dbsm_21 = _rcs_table_dbsm[i][j - 1];
-        double rcs_dbsm_22 = _rcs_table_dbsm[i][j];
-
-        // Perform bilinear interpolation on the dBsm values
-        double term1 = rcs_dbsm_11 * (az2 - azimuth_rad) * (el2 - elevation_rad);
-        double term2 = rcs_dbsm_21 * (azimuth_rad - az1) * (el2 - elevation_rad);
-        double term3 = rcs_dbsm_12 * (az2 - azimuth_rad) * (elevation_rad - el1);
-        double term4 = rcs_dbsm_22 * (azimuth_rad - az1) * (elevation_rad - el1);
-
-        double interpolated_rcs_dbsm = (term1 + term2 + term3 + term4) / ((az2 - az1) * (el2 - el1));
-
-        // Convert the final result from dBsm back to a linear scale (m^2)
-        return std::pow(10.0, interpolated_rcs_dbsm / 10.0);
+        const UniformAxis::Cell az = _azimuth.locate(azimuth_rad);
+        const UniformAxis::Cell el = _elevation.locate(elevation_rad);
+        const size_t row = _azimuth.points;
+        return std::exp2(blendLog2(_rcs_log2.data() + el.index * row + az.index, row, az, el));
+    }
+
+    void RCSDatabase::getRCSBatch(std::span<const double> azimuth_rad, std::span<const double> elevation_rad,
+                                  std::span<double> out) const {
+        if (elevation_rad.size() < azimuth_rad.size() || out.size() < azimuth_rad.size()) {
+            throw std::runtime_error("RCSDatabase error: Elevation or output span is shorter than the azimuth span.");
+        }
+        size_t done = 0;
+#if STRIKEENGINE_SIMD_X86
+        // The gathers take 32-bit offsets.
+        if (!_rcs_log2.empty() && _rcs_log2.size() <= INT32_MAX && detectSimdLevel() >= SimdLevel::AVX2) {
+            done = rcsBatchAvx2(_azimuth, _elevation, _rcs_log2.data(), azimuth_rad.data(), elevation_rad.data(),
+                                out.data(), azimuth_rad.size());
+        }
+#endif
+        for (size_t i = done; i < azimuth_rad.size(); ++i) {
+            out[i] = getRCS(azimuth_rad[i], elevation_rad[i]);
+        }
     }
 
 } // namespace StrikeEngine
@@ -0,0 +1,57 @@
+#include "strikeengine/flight/UniformAxis.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace StrikeEngine {
+
+    UniformAxis::Cell UniformAxis::locate(double value) const {
+        // max before min also sends NaN to the first point.
+        const double u = std::min(std::max(0.0, (value - origin) * inverse_spacing), static_cast<double>(points - 1));
+        const uint32_t index = std::min(static_cast<uint32_t>(u), points - 2);
+        return {index, u - index};
+    }
+
+    UniformAxis makeUniformAxis(std::span<const double> breakpoints, double tolerance, uint32_t maxPoints) {
+        if (breakpoints.empty()) {
+            throw std::runtime_error("UniformAxis error: An axis needs at least one breakpoint.");
+        }
+        for (size_t i = 1; i < breakpoints.size(); ++i) {
+            if (!(breakpoints[i] > breakpoints[i - 1])) {
+                throw std::runtime_error("UniformAxis error: Breakpoints must strictly ascend.");
+            }
+        }
+        if (breakpoints.size() == 1) {
+            return {breakpoints.front(), 1.0, 1.0, 2, true};
+        }
+
+        const double span = breakpoints.back() - breakpoints.front();
+        const auto first = static_cast<uint32_t>(breakpoints.size() - 1);
+        const uint32_t last = std::max(first, std::max(maxPoints, 2u) - 1);
+        for (uint32_t intervals = first; intervals <= last; ++intervals) {
+            const double spacing = span / intervals;
+            const bool aligned = std::ranges::all_of(breakpoints, [&](double breakpoint) {
+                const double position = (breakpoint - breakpoints.front()) / spacing;
+                return std::abs(position - std::round(position)) <= tolerance;
+            });
+            if (aligned) {
+                return {breakpoints.front(), spacing, 1.0 / spacing, intervals + 1, true};
+            }
+        }
+        const double spacing = span / last;
+        return {breakpoints.front(), spacing, 1.0 / spacing, last + 1, false};
+    }
+
+    UniformAxis::Cell locateBreakpoint(std::span<const double> breakpoints, double value) {
+        if (breakpoints.size() < 2 || !(value > breakpoints.front())) {
+            return {0, 0.0};
+        }
+        if (value >= breakpoints.back()) {
+            return {static_cast<uint32_t>(breakpoints.size() - 2), 1.0};
+        }
+        const auto high = std::ranges::upper_bound(breakpoints, value);
+        const auto index = static_cast<uint32_t>(high - breakpoints.begin() - 1);
+        return {index, (value - breakpoints[index]) / (breakpoints[index + 1] - breakpoints[index])};
+    }
+
+} // namespace StrikeEngine
@@ -6,6 +6,7 @@
 #include "strikeengine/components/transform/TransformComponent.hpp"
 #include "strikeengine/components/physics/MassComponent.hpp"
 #include "strikeengine/components/physics/InertiaComponent.hpp"
+#include "strikeengine/components/physics/AdaptiveStepComponent.hpp"
 #include "strikeengine/components/physics/VelocityComponent.hpp"
 #include "strikeengine/components/physics/PropulsionComponent.hpp"
 #include "strikeengine/components/physics/AerodynamicProfileComponent.hpp"
@@ -45,7 +46,7 @@ namespace StrikeEngine {
         }
     }
 
-    EntityFactory::EntityFactory(Registry& registry) : _registry(registry) {}
+    EntityFactory::EntityFactory(Registry& registry, ProfileRegistry& profiles) : _registry(registry), _profiles(profiles) {}
 
     Entity EntityFactory::createFromProfile(const std::string& profilePath) {
         std::ifstream f(profilePath);
@@ -121,10 +122,14 @@ namespace StrikeEngine {
             }
             else if (componentName == "aerodynamics") {
                 const auto& c = data.at("aerodynamics");
-                auto& aero = _registry.add<AerodynamicProfileComponent>(newEntity);
+                AerodynamicProfileComponent aero;
                 aero.profileID = c.at("profile_id").get<std::string>();
                 aero.reference_area_m2 = c.at("reference_area_m2").get<double>();
                 aero.wingspan_m = c.value("wingspan_m", 1.0);
+                aero.reference_length_m = c.value("reference_length_m", 1.0);
+                aero.database = _profiles.aerodynamics(aero.profileID);
+                aero.resolved = true;
+                _registry.add<AerodynamicProfileComponent>(newEntity, std::move(aero));
             }
             else if (componentName == "guidance") {
                 const auto& c = data.at("guidance");
@@ -152,8 +157,11 @@ namespace StrikeEngine {
             else if (componentName == "rcs_profile") {
                 if (data.contains("rcs_profile")) {
                     const auto& c = data.at("rcs_profile");
-                    auto& rcs = _registry.add<RCSProfileComponent>(newEntity);
+                    RCSProfileComponent rcs;
                     rcs.profile_path = c.at("profile_path").get<std::string>();
+                    rcs.database = _profiles.rcs(rcs.profile_path);
+                    rcs.resolved = true;
+                    _registry.add<RCSProfileComponent>(newEntity, std::move(rcs));
                 }
             }
             else if (componentName == "antenna") {
@@ -178,8 +186,11 @@ namespace StrikeEngine {
             else if (componentName == "infrared_signature") {
                 if (data.contains("infrared_signature")) {
                     const auto& c = data.at("infrared_signature");
-                    auto& ir_sig = _registry.add<InfraredSignatureComponent>(newEntity);
+                    InfraredSignatureComponent ir_sig;
                     ir_sig.profile_path = c.at("profile_path").get<std::string>();
+                    ir_sig.database = _profiles.infrared(ir_sig.profile_path);
+                    ir_sig.resolved = true;
+                    _registry.add<InfraredSignatureComponent>(newEntity, std::move(ir_sig));
                 }
             }
             else if (componentName == "target_signature") {
@@ -209,6 +220,7 @@ namespace StrikeEngine {
             else if (componentName == "navigation_state") _registry.add<NavigationStateComponent>(newEntity);
             else if (componentName == "control_surfaces") _registry.add<ControlSurfaceComponent>(newEntity);
             else if (componentName == "force_accumulator") _registry.add<ForceAccumulatorComponent>(newEntity);
+            else if (componentName == "adaptive_step") _registry.add<AdaptiveStepComponent>(newEntity);
             else if (componentName == "autopilot_command") _registry.add<AutopilotCommandComponent>(newEntity);
             else if (componentName == "autopilot_state") _registry.add<AutopilotStateComponent>(newEntity);
         }
@@ -52,17 +52,13 @@ namespace StrikeEngine {
 
     void ControlSystem::update(Registry& registry, double dt)
     {
-        auto view = registry.view<AutopilotCommandComponent, AutopilotStateComponent, ControlSurfaceComponent,
-                                  NavigationStateComponent, TransformComponent, VelocityComponent>();
+        auto view = registry.view<const AutopilotCommandComponent, AutopilotStateComponent, ControlSurfaceComponent,
+                                  const NavigationStateComponent, const TransformComponent, const VelocityComponent>();
 
-        for (auto entity : view)
+        view.each([&](const AutopilotCommandComponent& command, AutopilotStateComponent& state,
+                      ControlSurfaceComponent& fins, const NavigationStateComponent& navigation,
+                      const TransformComponent& transform, ComponentRef<const VelocityComponent> velocity)
         {
-            auto& command = view.get<AutopilotCommandComponent>(entity);
-            auto& state = view.get<AutopilotStateComponent>(entity);
-            auto& fins = view.get<ControlSurfaceComponent>(entity);
-            auto& navigation = view.get<NavigationStateComponent>(entity);
-            auto& transform = view.get<TransformComponent>(entity);
-            auto& velocity = view.get<VelocityComponent>(entity);
 
             // --- 1. Calculate Current Flight Conditions ---
             const double altitude = glm::length(transform.position);
@@ -115,6 +111,6 @@ namespace StrikeEngine {
             double current_yaw = fins.current_deflection_rad_yaw;
             fins.current_deflection_rad_yaw = std::clamp(desired_deflection_yaw, current_yaw - max_change,
                                                          current_yaw + max_change);
-        }
+        });
     }
 } // namespace StrikeEngine
@@ -14,19 +14,14 @@ namespace StrikeEngine {
     void ElectronicWarfareSystem::update(Registry& registry, double dt) {
         // --- 1. Process Noise Jammers ---
         // For each active jammer, calculate its effect on every radar receiver.
-        auto jammer_view = registry.view<JammerComponent, TransformComponent>();
-        auto receiver_view = registry.view<AntennaComponent, TransformComponent>();
+        auto jammer_view = registry.view<const JammerComponent, const TransformComponent>();
+        auto receiver_view = registry.view<AntennaComponent, const TransformComponent>();
 
-        for (auto receiver_entity : receiver_view) {
-            auto& antenna = receiver_view.get<AntennaComponent>(receiver_entity);
-            auto& receiver_transform = receiver_view.get<TransformComponent>(receiver_entity);
+        receiver_view.each([&](AntennaComponent& antenna, const TransformComponent& receiver_transform) {
             double total_jamming_power_W = 0.0;
 
-            for (auto jammer_entity : jammer_view) {
-                auto& jammer = jammer_view.get<JammerComponent>(jammer_entity);
-                auto& jammer_transform = jammer_view.get<TransformComponent>(jammer_entity);
-
-                if (!jammer.active) continue;
+            jammer_view.each([&](const JammerComponent& jammer, const TransformComponent& jammer_transform) {
+                if (!jammer.active) return;
 
                 // Calculate range between jammer and receiver
                 double range = glm::length(receiver_transform.position - jammer_transform.position);
@@ -41,19 +36,19 @@ namespace StrikeEngine {
                 double effective_aperture = (gain_linear * antenna.wavelength_m * antenna.wavelength_m) / (4.0 * std::numbers::pi);
 
                 total_jamming_power_W += power_density * effective_aperture;
-            }
+            });
 
             // Add the calculated jamming power to the receiver's natural noise floor.
             // The RadarSystem will now use this higher noise floor, reducing its SNR.
             antenna.noise_floor_W += total_jamming_power_W;
-        }
+        });
 
 
         // --- 2. Process Countermeasure Deployment ---
-        auto dispenser_view = registry.view<CountermeasureDispenserComponent, TransformComponent>();
-        for (auto entity : dispenser_view) {
-            auto& dispenser = dispenser_view.get<CountermeasureDispenserComponent>(entity);
-            auto& transform = dispenser_view.get<TransformComponent>(entity);
+        // New decoys are recorded in the command buffer and appear at the end of the frame.
+        CommandBuffer& commands = registry.commands();
+        auto dispenser_view = registry.view<CountermeasureDispenserComponent, const TransformComponent>();
+        dispenser_view.each([&](CountermeasureDispenserComponent& dispenser, const TransformComponent& transform) {
 
             // Deploy Chaff
             if (dispenser.deploy_chaff_command && dispenser.chaff_canisters > 0) {
@@ -61,12 +56,13 @@ namespace StrikeEngine {
                 dispenser.deploy_chaff_command = false;
 
                 // Create a new entity to represent the chaff cloud
-                Entity chaff_cloud = registry.create();
+                Entity chaff_cloud = commands.create();
                 // Place it at the same position as the deploying aircraft
-                registry.add<TransformComponent>(chaff_cloud, transform);
+                commands.add<TransformComponent>(chaff_cloud, transform);
                 // Give it a very large, non-aspect-dependent radar signature
-                auto& rcs = registry.add<RCSProfileComponent>(chaff_cloud);
-                rcs.profile_path = "data/rcs/chaff_cloud_generic.json";
+                RCSProfileComponent rcs;
+                rcs.profile_path = "data/rcs/chaff_cloud_generic.json"; // Resolved when the add is flushed
+                commands.add<RCSProfileComponent>(chaff_cloud, std::move(rcs));
             }
 
             // Deploy Flare
@@ -75,12 +71,13 @@ namespace StrikeEngine {
                 dispenser.deploy_flare_command = false;
 
                 // Create a new entity to represent the flare
-                Entity flare = registry.create();
-                registry.add<TransformComponent>(flare, transform);
-                auto& ir_sig = registry.add<InfraredSignatureComponent>(flare);
+                Entity flare = commands.create();
+                commands.add<TransformComponent>(flare, transform);
+                InfraredSignatureComponent ir_sig;
                 ir_sig.profile_path = "data/ir/flare_generic.json";
+                commands.add<InfraredSignatureComponent>(flare, std::move(ir_sig));
             }
-        }
+        });
     }
 
 } // namespace StrikeEngine
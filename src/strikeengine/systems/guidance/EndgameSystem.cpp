@@ -12,18 +12,16 @@ namespace StrikeEngine {
     void EndgameSystem::update(Registry& registry, double dt)
     {
         // Get a view of all missiles with endgame components that have not yet detonated.
-        auto missile_view = registry.view<FuzeComponent, WarheadComponent, SeekerComponent, TransformComponent>();
+        auto missile_view = registry.view<const FuzeComponent, WarheadComponent, const SeekerComponent,
+                                          const TransformComponent>();
 
-        for (auto missile_entity : missile_view)
+        missile_view.each([&](const FuzeComponent& fuze, WarheadComponent& warhead, const SeekerComponent& seeker,
+                              const TransformComponent& missile_transform)
         {
-            auto& fuze = missile_view.get<FuzeComponent>(missile_entity);
-            auto& warhead = missile_view.get<WarheadComponent>(missile_entity);
-            auto& seeker = missile_view.get<SeekerComponent>(missile_entity);
-            auto& missile_transform = missile_view.get<TransformComponent>(missile_entity);
             // Skip if the warhead has already detonated or if there is no locked target.
             if (warhead.has_detonated || !seeker.has_lock)
             {
-                continue;
+                return;
             }
 
             Entity target_entity = seeker.locked_target;
@@ -31,10 +29,10 @@ namespace StrikeEngine {
             // Ensure the target is still valid and has a transform.
             if (!registry.isAlive(target_entity) || !registry.has<TransformComponent>(target_entity))
             {
-                continue;
+                return;
             }
 
-            const auto& target_transform = registry.get<TransformComponent>(target_entity);
+            const auto& target_transform = registry.get<const TransformComponent>(target_entity);
 
             // --- 1. Check Fuze Trigger Condition ---
             double distance_to_target = glm::length(missile_transform.position - target_transform.position);
@@ -49,10 +47,11 @@ namespace StrikeEngine {
                 // --- 3. Perform Lethality Assessment ---
                 if (distance_to_target <= warhead.lethal_radius_m)
                 {
-                    // Target is within the lethal radius. Mark it as destroyed.
-                    registry.destroy(target_entity);
+                    // Target is within the lethal radius. Mark it as destroyed; the
+                    // destruction is applied at the end of the frame.
+                    registry.commands().destroy(target_entity);
                 }
             }
-        }
+        });
     }
 } // namespace StrikeEngine
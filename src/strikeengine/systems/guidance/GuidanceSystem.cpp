@@ -16,21 +16,27 @@ namespace StrikeEngine {
     // Define standard gravity for converting acceleration from m/s^2 to G's.
     constexpr double STANDARD_GRAVITY = 9.80665;
 
+    namespace {
+        // Entities per parallel chunk.
+        constexpr size_t GRAIN_SIZE = 64;
+    }
+
+    GuidanceSystem::GuidanceSystem(JobSystem& jobSystem) : _job_system(jobSystem) {}
+
     void GuidanceSystem::update(Registry& registry, double dt) {
         // The view now requires the full set of components for a realistic GNC loop.
-        auto view = registry.view<GuidanceComponent, SeekerComponent, NavigationStateComponent, AutopilotCommandComponent>();
+        auto view = registry.view<const GuidanceComponent, const SeekerComponent, const NavigationStateComponent,
+                                  AutopilotCommandComponent>();
 
-        for (auto entity : view) {
-            auto& guidance = view.get<GuidanceComponent>(entity);
-            auto& seeker = view.get<SeekerComponent>(entity);
-            auto& navigation_state = view.get<NavigationStateComponent>(entity);
-            auto& autopilot_command = view.get<AutopilotCommandComponent>(entity);
+        // Each missile only writes its own autopilot command; target state is read-only here.
+        view.parallelEach(_job_system, GRAIN_SIZE, [&](const GuidanceComponent& guidance, const SeekerComponent& seeker,
+                      const NavigationStateComponent& navigation_state, AutopilotCommandComponent& autopilot_command) {
 
             // --- 1. Check for Seeker Lock ---
             // The core logic is now gated by the seeker's ability to track the target.
             if (!seeker.has_lock) {
                 autopilot_command.commanded_acceleration_g = glm::dvec3(0.0); // No lock, no command.
-                continue;
+                return;
             }
 
             Entity targetEntity = seeker.locked_target;
@@ -38,13 +44,13 @@ namespace StrikeEngine {
             // --- 2. Validate Target State ---
             if (!registry.has<TransformComponent>(targetEntity) || !registry.has<VelocityComponent>(targetEntity)) {
                 autopilot_command.commanded_acceleration_g = glm::dvec3(0.0); // Target is invalid.
-                continue;
+                return;
             }
 
             // --- 3. Gather Data for PN Calculation ---
             // Get PERFECT "ground truth" data for the target (as if from a perfect sensor).
-            const auto& target_transform = registry.get<TransformComponent>(targetEntity);
-            const auto& target_velocity = registry.get<VelocityComponent>(targetEntity);
+            const auto& target_transform = registry.get<const TransformComponent>(targetEntity);
+            const auto& target_velocity = registry.get<const VelocityComponent>(targetEntity);
 
             // Use the missile's own IMPERFECT, ESTIMATED state for its side of the calculation.
             const glm::dvec3& missile_position = navigation_state.estimated_position;
@@ -61,7 +67,7 @@ namespace StrikeEngine {
             // so guidance commands would be ineffective.
             if (closing_velocity < 0.0) {
                 autopilot_command.commanded_acceleration_g = glm::dvec3(0.0);
-                continue;
+                return;
             }
 
             // Calculate the line-of-sight (LOS) rotation rate vector (omega).
@@ -75,7 +81,7 @@ namespace StrikeEngine {
             // --- 5. Output Command in G's ---
             // Convert the command to G's for the autopilot system.
             autopilot_command.commanded_acceleration_g = commanded_acceleration_ms2 / STANDARD_GRAVITY;
-        }
+        });
     }
 
 } // namespace StrikeEngine
@@ -59,18 +59,16 @@ namespace StrikeEngine {
     }
 
     void NavigationSystem::update(Registry& registry, double dt) {
-        auto view = registry.view<IMUComponent, NavigationStateComponent, TransformComponent, ForceAccumulatorComponent, MassComponent>();
+        auto view = registry.view<const IMUComponent, NavigationStateComponent, const TransformComponent,
+                                  const ForceAccumulatorComponent, const MassComponent>();
 
         // A single random number generator for the whole system update
         std::random_device rd;
         std::mt19937 gen(rd());
 
-        for (auto entity : view) {
-            auto& imu = view.get<IMUComponent>(entity);
-            auto& navigation_state = view.get<NavigationStateComponent>(entity);
-            auto& transform = view.get<TransformComponent>(entity);
-            auto& accumulator = view.get<ForceAccumulatorComponent>(entity);
-            auto& mass = view.get<MassComponent>(entity);
+        view.each([&](Entity entity, const IMUComponent& imu, NavigationStateComponent& navigation_state,
+                      const TransformComponent& transform, ComponentRef<const ForceAccumulatorComponent> accumulator,
+                      const MassComponent& mass) {
 
             // --- 1. Simulate and Process IMU Data ---
             // Get the "perfect" ground truth acceleration for this frame.
@@ -107,7 +105,7 @@ namespace StrikeEngine {
             navigation_state.estimated_velocity = {_state_estimate[3], _state_estimate[4], _state_estimate[5]};
             // The estimated acceleration is the last (noisy) measurement from the IMU
             navigation_state.estimated_acceleration = imu_measured_acceleration;
-        }
+        });
     }
 
     void NavigationSystem::predict(double dt, const glm::dvec3& imu_acceleration) {
@@ -15,32 +15,25 @@ namespace StrikeEngine {
     }
 
     void RadarSystem::update(Registry& registry, double dt) {
-        auto radar_view = registry.view<AntennaComponent, SeekerComponent, TransformComponent>();
-        auto target_view = registry.view<RCSProfileComponent, TransformComponent>();
+        auto radar_view = registry.view<const AntennaComponent, SeekerComponent, const TransformComponent>();
+        auto target_view = registry.view<const RCSProfileComponent, const TransformComponent>();
 
-        for (auto radar_entity: radar_view) {
-            auto& antenna = radar_view.get<AntennaComponent>(radar_entity);
-            auto& seeker = radar_view.get<SeekerComponent>(radar_entity);
-            auto& radar_transform = radar_view.get<TransformComponent>(radar_entity);
+        radar_view.each([&](const AntennaComponent& antenna, SeekerComponent& seeker,
+                            const TransformComponent& radar_transform) {
 
             // For now, assume the seeker is always looking for the first available target.
             // A more advanced implementation would have target selection logic.
             bool lock_maintained = false;
 
             for (auto target_entity : target_view) {
-                auto& rcs_profile = target_view.get<RCSProfileComponent>(target_entity);
-                auto& target_transform = target_view.get<TransformComponent>(target_entity);
-
-                // --- 1. Load RCS Database (if not already cached) ---
-                if (!_rcs_database_cache.contains(rcs_profile.profile_path)) {
-                    auto db = std::make_unique<RCSDatabase>();
-                    if (db->loadProfile(rcs_profile.profile_path)) {
-                        _rcs_database_cache[rcs_profile.profile_path] = std::move(db);
-                    } else {
-                        continue; // Skip the target if its profile cannot be loaded
-                    }
+                auto& rcs_profile = target_view.get<const RCSProfileComponent>(target_entity);
+                auto& target_transform = target_view.get<const TransformComponent>(target_entity);
+
+                // --- 1. Get the RCS Database ---
+                const RCSDatabase* rcs_db = rcs_profile.database;
+                if (!rcs_db) {
+                    continue; // Skip the target if its profile cannot be loaded
                 }
-                const auto& rcs_db = _rcs_database_cache.at(rcs_profile.profile_path);
 
                 // --- 2. Calculate Geometry & Aspect Angles ---
                 glm::dvec3 range_vec = target_transform.position - radar_transform.position;
@@ -83,7 +76,7 @@ namespace StrikeEngine {
                 seeker.has_lock = false;
                 seeker.locked_target = NULL_ENTITY;
             }
-        }
+        });
     }
 
 } // namespace StrikeEngine
@@ -15,48 +15,42 @@ namespace StrikeEngine {
 
     extern AtmosphereManager g_atmosphere_manager;
 
-    void processRadarSeeker(Entity entity, Registry& registry, std::unordered_map<std::string, std::unique_ptr<RCSDatabase>>& cache);
-    void processIRSeeker(Entity entity, Registry& registry, std::unordered_map<std::string, std::unique_ptr<IRSignatureDatabase>>& cache);
+    void processRadarSeeker(Entity entity, Registry& registry);
+    void processIRSeeker(Entity entity, Registry& registry);
 
     // --- Main Update Loop ---
     void SensorSystem::update(Registry& registry, double dt) {
-        auto view = registry.view<SeekerComponent>();
+        auto view = registry.view<const SeekerComponent>();
 
-        for (auto entity : view) {
-            auto& seeker = view.get<SeekerComponent>(entity);
+        view.each([&](Entity entity, const SeekerComponent& seeker) {
             if (seeker.type == "RF") {
-                processRadarSeeker(entity, registry, _rcs_database_cache);
+                processRadarSeeker(entity, registry);
             }
             else if (seeker.type == "IR") {
-                processIRSeeker(entity, registry, _ir_database_cache);
+                processIRSeeker(entity, registry);
             }
-        }
+        });
     }
 
     // --- Radar Simulation Logic ---
     double dbToRatio(double db) { return std::pow(10.0, db / 10.0); }
 
-    void processRadarSeeker(Entity entity, Registry& registry, std::unordered_map<std::string, std::unique_ptr<RCSDatabase>>& cache) {
+    void processRadarSeeker(Entity entity, Registry& registry) {
         if (!registry.has<AntennaComponent>(entity) || !registry.has<TransformComponent>(entity)) return;
 
         auto& seeker = registry.get<SeekerComponent>(entity);
-        auto& antenna = registry.get<AntennaComponent>(entity);
-        auto& radar_transform = registry.get<TransformComponent>(entity);
+        const auto& antenna = registry.get<const AntennaComponent>(entity);
+        const auto& radar_transform = registry.get<const TransformComponent>(entity);
 
         bool lock_maintained = false;
-         auto target_view = registry.view<RCSProfileComponent, TransformComponent>();
+         auto target_view = registry.view<const RCSProfileComponent, const TransformComponent>();
         for ( auto target_entity : target_view) {
-            auto& rcs_profile = target_view.get<RCSProfileComponent>(target_entity);
-            auto& target_transform = target_view.get<TransformComponent>(target_entity);
+            auto& rcs_profile = target_view.get<const RCSProfileComponent>(target_entity);
+            auto& target_transform = target_view.get<const TransformComponent>(target_entity);
 
 
-            if (!cache.contains(rcs_profile.profile_path)) {
-                auto db = std::make_unique<RCSDatabase>();
-                if (db->loadProfile(rcs_profile.profile_path)) {
-                    cache[rcs_profile.profile_path] = std::move(db);
-                } else continue;
-            }
-            const auto& rcs_db = cache.at(rcs_profile.profile_path);
+            const RCSDatabase* rcs_db = rcs_profile.database;
+            if (!rcs_db) continue;
 
             glm::dvec3 range_vec = target_transform.position - radar_transform.position;
             double range = glm::length(range_vec);
@@ -83,25 +77,20 @@ namespace StrikeEngine {
     }
 
     // --- Infrared Simulation Logic ---
-    void processIRSeeker(Entity entity, Registry& registry, std::unordered_map<std::string, std::unique_ptr<IRSignatureDatabase>>& cache) {
+    void processIRSeeker(Entity entity, Registry& registry) {
         if (!registry.has<InfraredSeekerComponent>(entity) || !registry.has<TransformComponent>(entity)) return;
 
         auto& seeker = registry.get<SeekerComponent>(entity);
-        auto& ir_seeker = registry.get<InfraredSeekerComponent>(entity);
-        auto& seeker_transform = registry.get<TransformComponent>(entity);
+        const auto& ir_seeker = registry.get<const InfraredSeekerComponent>(entity);
+        const auto& seeker_transform = registry.get<const TransformComponent>(entity);
 
         bool lock_maintained = false;
-        auto target_view = registry.view<InfraredSignatureComponent, TransformComponent>();
+        auto target_view = registry.view<const InfraredSignatureComponent, const TransformComponent>();
         for (auto target_entity : target_view) {
-            auto& ir_profile = target_view.get<InfraredSignatureComponent>(target_entity);
-            auto& target_transform = target_view.get<TransformComponent>(target_entity);
-            if (!cache.contains(ir_profile.profile_path)) {
-                auto db = std::make_unique<IRSignatureDatabase>();
-                if (db->loadProfile(ir_profile.profile_path)) {
-                    cache[ir_profile.profile_path] = std::move(db);
-                } else continue;
-            }
-            const auto& ir_db = cache.at(ir_profile.profile_path);
+            auto& ir_profile = target_view.get<const InfraredSignatureComponent>(target_entity);
+            auto& target_transform = target_view.get<const TransformComponent>(target_entity);
+            const IRSignatureDatabase* ir_db = ir_profile.database;
+            if (!ir_db) continue;
 
             glm::dvec3 range_vec = target_transform.position - seeker_transform.position;
             double range = glm::length(range_vec);
@@ -1,18 +1,35 @@
 #include "strikeengine/systems/physics/AerodynamicsSystem.hpp"
+#include "strikeengine/systems/physics/RigidBodyGroup.hpp"
 #include "strikeengine/atmosphere/AtmosphereManager.hpp"
+#include "strikeengine/atmosphere/WeatherField.hpp"
 #include "strikeengine/flight/AerodynamicsDatabase.hpp"
 #include "strikeengine/ecs/Registry.hpp"
 #include "strikeengine/components/transform/TransformComponent.hpp"
 #include "strikeengine/components/physics/VelocityComponent.hpp"
 #include "strikeengine/components/physics/AerodynamicProfileComponent.hpp"
 #include "strikeengine/components/physics/ForceAccumulatorComponent.hpp"
+#include "strikeengine/components/physics/ControlSurfaceComponent.hpp"
 
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/norm.hpp>
 
+#include <cmath>
+#include <vector>
+
 namespace StrikeEngine {
-   AerodynamicsSystem::AerodynamicsSystem(const AtmosphereManager& atmosphereManager): _atmosphere_manager(
-      atmosphereManager)
+   namespace
+   {
+      // Entities per parallel chunk; each entity does a table lookup and several normalizations.
+      constexpr size_t GRAIN_SIZE = 64;
+
+      // Per-thread buffers for a chunk's weather lookups, reused from frame to frame.
+      thread_local std::vector<glm::dvec3> t_positions;
+      thread_local std::vector<WeatherSample> t_weather;
+   }
+
+   AerodynamicsSystem::AerodynamicsSystem(const AtmosphereManager& atmosphereManager, JobSystem& jobSystem,
+                                          WeatherField* weatherField):
+      _atmosphere_manager(atmosphereManager), _job_system(jobSystem), _weather_field(weatherField)
    {
    }
 
@@ -22,88 +39,156 @@ namespace StrikeEngine {
    {
       if (!_atmosphere_manager.isLoaded()) { return; }
 
-      auto view = registry.view<TransformComponent, VelocityComponent, AerodynamicProfileComponent,
-                                ForceAccumulatorComponent>();
-      for (auto entity : view)
+      auto group = rigidBodyGroup(registry, Get<AerodynamicProfileComponent>{});
+
+      // Page in the weather tiles under every member before the parallel lookups.
+      WeatherField* weather = _weather_field && _weather_field->isLoaded() ? _weather_field : nullptr;
+      if (weather)
       {
-         auto& transform = view.get<TransformComponent>(entity);
-         auto& velocity = view.get<VelocityComponent>(entity);
-         auto& aero = view.get<AerodynamicProfileComponent>(entity);
-         auto& accumulator = view.get<ForceAccumulatorComponent>(entity);
+         _positions.clear();
+         group.each([&](const TransformComponent& transform, auto&&...) { _positions.push_back(transform.position); });
+         weather->prefetch(_positions, _time_s);
+      }
+      // Altitudes are measured above the weather field's sphere, so the aero tables and the
+      // field see the same altitude; without a field, above the field's default sphere.
+      const double earth_radius_m = weather ? weather->grid().earth_radius_m : WeatherGrid{}.earth_radius_m;
 
-         // --- 1. Load Aerodynamic Database if is not already cached ---
-         if (!_aeroDatabases.contains(aero.profileID))
+      _job_system.parallelFor(group.size(), GRAIN_SIZE, [&](size_t begin, size_t end)
+      {
+         // Sample the weather for the chunk's members as one batch, in visiting order.
+         if (weather)
          {
-            auto db = std::make_unique<AerodynamicsDatabase>();
-            std::string profile_path = "data/aero/" + aero.profileID + ".json";
-            if (db->loadProfile(profile_path)) { _aeroDatabases[aero.profileID] = std::move(db); }
-            else
+            t_positions.clear();
+            group.eachInRange(begin, end, [](const TransformComponent& transform, auto&&...)
             {
-               continue;
-            }
+               t_positions.push_back(transform.position);
+            });
+            t_weather.resize(t_positions.size());
+            weather->sample(t_positions, _time_s, t_weather);
          }
-         const auto& aero_db = _aeroDatabases.at(aero.profileID);
 
-         // --- 2. Calculate Current Flight Conditions ---
-         if (glm::length2(velocity.getLinear()) < 1e-6)
+         size_t member = 0;
+         group.eachInRange(begin, end, [&](Entity entity, const TransformComponent& transform,
+                                           ComponentRef<const VelocityComponent> velocity, const MassComponent&,
+                                           ComponentRef<ForceAccumulatorComponent> accumulator,
+                                           AerodynamicProfileComponent& aero)
          {
-            aero.current_angle_of_attack_rad = 0.0;
-            aero.current_mach_number = 0.0;
-            continue;
-         }
-
-         // Note: This assumes a spherical Earth model where altitude is distance from the center.
-         // For ground effect, we need Altitude Above Ground Level (AGL). We will approximate
-         // this with the Y-coordinate, assuming a flat plane at y=0.
-         const double altitude_from_center = glm::length(transform.position);
-         const AtmosphereProperties atmosphere = _atmosphere_manager.getProperties(altitude_from_center);
-         const double speed = glm::length(velocity.getLinear());
-         aero.current_mach_number = speed / atmosphere.speedOfSound;
+            const WeatherSample* local_weather = weather ? &t_weather[member] : nullptr;
+            ++member;
 
-         const glm::dvec3 velocity_direction = glm::normalize(velocity.getLinear());
-         const glm::dvec3 body_forward_direction = glm::normalize(transform.orientation * glm::dvec3(0, 0, 1));
-         aero.current_angle_of_attack_rad = acos(
-            glm::clamp(glm::dot(velocity_direction, body_forward_direction), -1.0, 1.0));
+            // --- 1. Get the Aerodynamic Database (resolved when the component was added) ---
+            const AerodynamicsDatabase* aero_db = aero.database;
+            if (!aero_db)
+            {
+               return;
+            }
 
-         // --- 3. Look Up Base Aerodynamic Coefficients ---
-         auto [base_Cl, base_Cd] = aero_db->getCoefficients(aero.current_mach_number, aero.current_angle_of_attack_rad);
+            // --- 2. Calculate Current Flight Conditions ---
+            // Aerodynamic forces follow the velocity relative to the air mass, not the ground.
+            const glm::dvec3 air_velocity = local_weather ? velocity.getLinear() - local_weather->wind_mps : velocity.getLinear();
+            if (glm::length2(air_velocity) < 1e-6)
+            {
+               aero.current_angle_of_attack_rad = 0.0;
+               aero.current_sideslip_angle_rad = 0.0;
+               aero.current_mach_number = 0.0;
+               return;
+            }
 
-         // --- 4. Ground Effect Calculation ---
-         double lift_multiplier = 1.0;
-         double drag_multiplier = 1.0;
+            // Altitude above the reference sphere. For ground effect, we need Altitude Above Ground
+            // Level (AGL). We will approximate this with the Y-coordinate, assuming a flat plane at y=0.
+            const double altitude_m = glm::length(transform.position) - earth_radius_m;
+            double density;
+            double speed_of_sound;
+            if (local_weather)
+            {
+               density = local_weather->density_kgpm3;
+               speed_of_sound = local_weather->speedOfSound();
+            }
+            else
+            {
+               const AtmosphereProperties atmosphere = _atmosphere_manager.compactTable().getProperties(altitude_m);
+               density = atmosphere.density;
+               speed_of_sound = atmosphere.speedOfSound;
+            }
+            const double speed = glm::length(air_velocity);
+            aero.current_mach_number = speed / speed_of_sound;
+
+            // Angles of the airflow in the body frame (+Z forward, +Y up).
+            const glm::dvec3 velocity_direction = air_velocity / speed;
+            const glm::dvec3 body_velocity = glm::conjugate(transform.orientation) * velocity_direction;
+            aero.current_angle_of_attack_rad = std::atan2(-body_velocity.y, body_velocity.z);
+            aero.current_sideslip_angle_rad = std::asin(glm::clamp(body_velocity.x, -1.0, 1.0));
+
+            // --- 3. Look Up Aerodynamic Coefficients ---
+            AeroFlightCondition condition;
+            condition.mach = aero.current_mach_number;
+            condition.alpha_rad = aero.current_angle_of_attack_rad;
+            condition.beta_rad = aero.current_sideslip_angle_rad;
+            condition.altitude_m = altitude_m;
+            const bool axisymmetric = !aero_db->table().hasAxis(AeroParameter::Beta);
+            if (axisymmetric)
+            {
+               condition.alpha_rad = std::acos(glm::clamp(body_velocity.z, -1.0, 1.0));
+               condition.beta_rad = 0.0;
+            }
+            if (registry.has<ControlSurfaceComponent>(entity))
+            {
+               const ControlSurfaceComponent& fins = registry.get<const ControlSurfaceComponent>(entity);
+               condition.pitch_deflection_rad = fins.current_deflection_rad_pitch;
+               condition.yaw_deflection_rad = fins.current_deflection_rad_yaw;
+            }
+            const AeroCoefficients coefficients = aero_db->getCoefficients(condition);
 
-         const double altitude_agl = transform.position.y; // Approximation for AGL
-         const double wingspan = aero.wingspan_m;
+            // --- 4. Ground Effect Calculation ---
+            double lift_multiplier = 1.0;
+            double drag_multiplier = 1.0;
 
-         // The ground effect is significant when altitude is less than twice the wingspan.
-         if (altitude_agl > 0 && altitude_agl < (2.0 * wingspan))
-         {
-            // Use a standard engineering approximation for ground effect.
-            double h_over_b = altitude_agl / wingspan;
-            drag_multiplier = (33.0 * pow(h_over_b, 1.5)) / (1.0 + 33.0 * pow(h_over_b, 1.5));
-            lift_multiplier = 1.0 + (0.5 * (1.0 - drag_multiplier));
-         }
+            const double altitude_agl = transform.position.y; // Approximation for AGL
+            const double wingspan = aero.wingspan_m;
 
-         // Apply the multipliers to the base coefficients
-         const double final_Cl = base_Cl * lift_multiplier;
-         const double final_Cd = base_Cd * drag_multiplier;
+            // The ground effect is significant when altitude is less than twice the wingspan.
+            if (altitude_agl > 0 && altitude_agl < (2.0 * wingspan))
+            {
+               // Use a standard engineering approximation for ground effect.
+               double h_over_b = altitude_agl / wingspan;
+               drag_multiplier = (33.0 * pow(h_over_b, 1.5)) / (1.0 + 33.0 * pow(h_over_b, 1.5));
+               lift_multiplier = 1.0 + (0.5 * (1.0 - drag_multiplier));
+            }
 
-         // --- 5. Calculate Final Forces ---
-         const double dynamic_pressure = 0.5 * atmosphere.density * speed * speed;
-         const double lift_magnitude = final_Cl * dynamic_pressure * aero.reference_area_m2;
-         const double drag_magnitude = final_Cd * dynamic_pressure * aero.reference_area_m2;
+            // Apply the multipliers to the base coefficients
+            const double final_Cl = coefficients.Cl * lift_multiplier;
+            const double final_Cd = coefficients.Cd * drag_multiplier;
 
-         glm::dvec3 drag_force = -velocity_direction * drag_magnitude;
+            // --- 5. Calculate Final Forces ---
+            const double dynamic_pressure = 0.5 * density * speed * speed;
+            const double force_scale = dynamic_pressure * aero.reference_area_m2;
 
-         // This is a correct calculation for the lift vector direction
-         glm::dvec3 body_up_direction = glm::normalize(transform.orientation * glm::dvec3(0, 1, 0));
-         glm::dvec3 lift_direction = glm::normalize(
-            glm::cross(glm::cross(velocity_direction, body_up_direction), velocity_direction));
-         glm::dvec3 lift_force = lift_direction * lift_magnitude;
+            glm::dvec3 drag_force = -velocity_direction * final_Cd * force_scale;
 
-         // --- 6. Add Forces to Accumulator ---
-         accumulator.addForce(drag_force);
-         accumulator.addForce(lift_force);
-      }
+            // Lift and side force act along the body's up and +X axes, less their components along the airflow.
+            // An axisymmetric airframe's lift is towards the nose, in the plane of the total angle.
+            auto perpendicular = [&](const glm::dvec3& body_axis)
+            {
+               const glm::dvec3 axis = transform.orientation * body_axis;
+               const glm::dvec3 direction = axis - glm::dot(axis, velocity_direction) * velocity_direction;
+               const double length = glm::length(direction);
+               return length > 1e-9 ? direction / length : glm::dvec3(0.0);
+            };
+            glm::dvec3 lift_force = perpendicular(axisymmetric ? glm::dvec3(0, 0, 1) : glm::dvec3(0, 1, 0)) * final_Cl * force_scale;
+            glm::dvec3 side_force = perpendicular(glm::dvec3(1, 0, 0)) * coefficients.Cy * force_scale;
+
+            // Moments about the body axes, rotated into the world frame.
+            const glm::dvec3 body_moment(coefficients.Cm, coefficients.Cn, coefficients.Cr);
+            glm::dvec3 torque = transform.orientation * body_moment * (force_scale * aero.reference_length_m);
+
+            // --- 6. Add Forces to Accumulator ---
+            accumulator.addForce(drag_force);
+            accumulator.addForce(lift_force);
+            accumulator.addForce(side_force);
+            accumulator.addTorque(torque);
+         });
+      });
+
+      _time_s += dt;
    }
 } // namespace StrikeEngine
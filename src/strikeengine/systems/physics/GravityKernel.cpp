@@ -0,0 +1,163 @@
+#include "strikeengine/systems/physics/GravityKernel.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if STRIKEENGINE_SIMD_X86
+#include <immintrin.h>
+#endif
+
+namespace StrikeEngine {
+
+    namespace {
+        // Entities closer than this to the Earth's centre get no force (avoids the singularity).
+        constexpr double MIN_RADIUS_SQUARED = 1.0;
+
+        // The per-call constants of the model, precomputed once per batch.
+        //
+        // With k the polar axis, r the position, z = r.k and f = 1.5 J2 Re^2 / |r|^2,
+        //   F = -mu m / |r|^3 * ( r * (1 + f (1 - 5 z^2/|r|^2)) + k * 2 f z )
+        // which reduces to point-mass gravity when f = 0.
+        struct Coefficients {
+            double mu;
+            double j2_factor; // 1.5 J2 Re^2, or 0 with J2 disabled
+            double kx, ky, kz;
+
+            explicit Coefficients(const GravityModel& model)
+                : mu(model.mu),
+                  j2_factor(model.j2_enabled ? 1.5 * model.j2 * model.equatorial_radius_m * model.equatorial_radius_m : 0.0) {
+                const glm::dvec3 axis = glm::normalize(model.polar_axis);
+                kx = axis.x;
+                ky = axis.y;
+                kz = axis.z;
+            }
+        };
+
+        void accumulateScalar(const Coefficients& c, const GravityBatch& batch, size_t begin) {
+            for (size_t i = begin; i < batch.count; ++i) {
+                const double x = batch.x[i];
+                const double y = batch.y[i];
+                const double z = batch.z[i];
+                const double r2 = x * x + y * y + z * z;
+                if (r2 < MIN_RADIUS_SQUARED) {
+                    continue;
+                }
+                const double inv_r2 = 1.0 / r2;
+                const double inv_r3 = inv_r2 * std::sqrt(inv_r2);
+                const double polar = x * c.kx + y * c.ky + z * c.kz;
+                const double f = c.j2_factor * inv_r2;
+                const double scale = -c.mu * batch.mass[i] * inv_r3;
+                const double radial = scale * (1.0 + f * (1.0 - 5.0 * polar * polar * inv_r2));
+                const double axial = scale * 2.0 * f * polar;
+                batch.fx[i] += radial * x + axial * c.kx;
+                batch.fy[i] += radial * y + axial * c.ky;
+                batch.fz[i] += radial * z + axial * c.kz;
+            }
+        }
+
+#if STRIKEENGINE_SIMD_X86
+        // Processes whole 4-entity blocks and returns the index of the first unprocessed entity.
+        __attribute__((target("avx2,fma")))
+        size_t accumulateAvx2(const Coefficients& c, const GravityBatch& batch) {
+            const __m256d kx = _mm256_set1_pd(c.kx);
+            const __m256d ky = _mm256_set1_pd(c.ky);
+            const __m256d kz = _mm256_set1_pd(c.kz);
+            const __m256d neg_mu = _mm256_set1_pd(-c.mu);
+            const __m256d j2_factor = _mm256_set1_pd(c.j2_factor);
+            const __m256d one = _mm256_set1_pd(1.0);
+            const __m256d two = _mm256_set1_pd(2.0);
+            const __m256d five = _mm256_set1_pd(5.0);
+            const __m256d min_r2 = _mm256_set1_pd(MIN_RADIUS_SQUARED);
+
+            size_t i = 0;
+            for (; i + 4 <= batch.count; i += 4) {
+                const __m256d x = _mm256_loadu_pd(batch.x + i);
+                const __m256d y = _mm256_loadu_pd(batch.y + i);
+                const __m256d z = _mm256_loadu_pd(batch.z + i);
+                const __m256d r2 = _mm256_fmadd_pd(x, x, _mm256_fmadd_pd(y, y, _mm256_mul_pd(z, z)));
+                const __m256d valid = _mm256_cmp_pd(r2, min_r2, _CMP_GE_OQ);
+
+                const __m256d inv_r2 = _mm256_div_pd(one, r2);
+                const __m256d inv_r3 = _mm256_mul_pd(inv_r2, _mm256_sqrt_pd(inv_r2));
+                const __m256d polar = _mm256_fmadd_pd(x, kx, _mm256_fmadd_pd(y, ky, _mm256_mul_pd(z, kz)));
+                const __m256d f = _mm256_mul_pd(j2_factor, inv_r2);
+                const __m256d scale = _mm256_mul_pd(_mm256_mul_pd(neg_mu, _mm256_loadu_pd(batch.mass + i)), inv_r3);
+                const __m256d polar2 = _mm256_mul_pd(_mm256_mul_pd(polar, polar), inv_r2);
+                const __m256d radial = _mm256_and_pd(
+                    valid, _mm256_mul_pd(scale, _mm256_fmadd_pd(f, _mm256_fnmadd_pd(five, polar2, one), one)));
+                const __m256d axial = _mm256_and_pd(valid, _mm256_mul_pd(_mm256_mul_pd(scale, two), _mm256_mul_pd(f, polar)));
+
+                _mm256_storeu_pd(batch.fx + i, _mm256_add_pd(_mm256_loadu_pd(batch.fx + i),
+                                                             _mm256_fmadd_pd(radial, x, _mm256_mul_pd(axial, kx))));
+                _mm256_storeu_pd(batch.fy + i, _mm256_add_pd(_mm256_loadu_pd(batch.fy + i),
+                                                             _mm256_fmadd_pd(radial, y, _mm256_mul_pd(axial, ky))));
+                _mm256_storeu_pd(batch.fz + i, _mm256_add_pd(_mm256_loadu_pd(batch.fz + i),
+                                                             _mm256_fmadd_pd(radial, z, _mm256_mul_pd(axial, kz))));
+            }
+            return i;
+        }
+
+        // Processes whole 8-entity blocks and returns the index of the first unprocessed entity.
+        __attribute__((target("avx512f")))
+        size_t accumulateAvx512(const Coefficients& c, const GravityBatch& batch) {
+            const __m512d kx = _mm512_set1_pd(c.kx);
+            const __m512d ky = _mm512_set1_pd(c.ky);
+            const __m512d kz = _mm512_set1_pd(c.kz);
+            const __m512d neg_mu = _mm512_set1_pd(-c.mu);
+            const __m512d j2_factor = _mm512_set1_pd(c.j2_factor);
+            const __m512d one = _mm512_set1_pd(1.0);
+            const __m512d two = _mm512_set1_pd(2.0);
+            const __m512d five = _mm512_set1_pd(5.0);
+            const __m512d min_r2 = _mm512_set1_pd(MIN_RADIUS_SQUARED);
+
+            size_t i = 0;
+            for (; i + 8 <= batch.count; i += 8) {
+                const __m512d x = _mm512_loadu_pd(batch.x + i);
+                const __m512d y = _mm512_loadu_pd(batch.y + i);
+                const __m512d z = _mm512_loadu_pd(batch.z + i);
+                const __m512d r2 = _mm512_fmadd_pd(x, x, _mm512_fmadd_pd(y, y, _mm512_mul_pd(z, z)));
+                const __mmask8 valid = _mm512_cmp_pd_mask(r2, min_r2, _CMP_GE_OQ);
+
+                const __m512d inv_r2 = _mm512_div_pd(one, r2);
+                const __m512d inv_r3 = _mm512_mul_pd(inv_r2, _mm512_sqrt_pd(inv_r2));
+                const __m512d polar = _mm512_fmadd_pd(x, kx, _mm512_fmadd_pd(y, ky, _mm512_mul_pd(z, kz)));
+                const __m512d f = _mm512_mul_pd(j2_factor, inv_r2);
+                const __m512d scale = _mm512_mul_pd(_mm512_mul_pd(neg_mu, _mm512_loadu_pd(batch.mass + i)), inv_r3);
+                const __m512d polar2 = _mm512_mul_pd(_mm512_mul_pd(polar, polar), inv_r2);
+                const __m512d radial = _mm512_mul_pd(scale, _mm512_fmadd_pd(f, _mm512_fnmadd_pd(five, polar2, one), one));
+                const __m512d axial = _mm512_mul_pd(_mm512_mul_pd(scale, two), _mm512_mul_pd(f, polar));
+
+                // Masked adds leave entities inside the minimum radius untouched.
+                const __m512d fx = _mm512_loadu_pd(batch.fx + i);
+                const __m512d fy = _mm512_loadu_pd(batch.fy + i);
+                const __m512d fz = _mm512_loadu_pd(batch.fz + i);
+                _mm512_storeu_pd(batch.fx + i, _mm512_mask_add_pd(fx, valid, fx, _mm512_fmadd_pd(radial, x, _mm512_mul_pd(axial, kx))));
+                _mm512_storeu_pd(batch.fy + i, _mm512_mask_add_pd(fy, valid, fy, _mm512_fmadd_pd(radial, y, _mm512_mul_pd(axial, ky))));
+                _mm512_storeu_pd(batch.fz + i, _mm512_mask_add_pd(fz, valid, fz, _mm512_fmadd_pd(radial, z, _mm512_mul_pd(axial, kz))));
+            }
+            return i;
+        }
+#endif
+    }
+
+    void accumulateGravity(const GravityModel& model, const GravityBatch& batch) {
+        accumulateGravity(model, batch, detectSimdLevel());
+    }
+
+    void accumulateGravity(const GravityModel& model, const GravityBatch& batch, SimdLevel level) {
+        const Coefficients coefficients(model);
+        level = std::min(level, detectSimdLevel());
+
+        size_t done = 0;
+#if STRIKEENGINE_SIMD_X86
+        if (level == SimdLevel::AVX512) {
+            done = accumulateAvx512(coefficients, batch);
+        } else if (level == SimdLevel::AVX2) {
+            done = accumulateAvx2(coefficients, batch);
+        }
+#endif
+        // The scalar loop handles the whole batch without SIMD, and the tail with it.
+        accumulateScalar(coefficients, batch, done);
+    }
+
+} // namespace StrikeEngine
@@ -1,45 +1,62 @@
 #include "strikeengine/systems/physics/GravitySystem.hpp"
+#include "strikeengine/systems/physics/RigidBodyGroup.hpp"
 #include "strikeengine/ecs/Registry.hpp"
 #include "strikeengine/components/transform/TransformComponent.hpp"
 #include "strikeengine/components/physics/MassComponent.hpp"
 #include "strikeengine/components/physics/ForceAccumulatorComponent.hpp"
 
+#include <algorithm>
+
 namespace StrikeEngine {
-    // Physics Constants (WGS 84 standard)
-    constexpr double GRAVITATIONAL_CONSTANT = 6.67430e-11; /// m^3 kg^-1 s^-2
-    constexpr double EARTH_MASS_KG = 5.97219e24; /// kg
+    namespace {
+        // Entities per parallel chunk; the per-entity work is a handful of flops.
+        constexpr size_t GRAIN_SIZE = 512;
 
-    void GravitySystem::update(Registry& registry, double dt)
+        // Entities gathered into one SoA tile for the batched kernel; the tile lives on the stack.
+        constexpr size_t TILE_SIZE = 256;
+    }
+
+    GravitySystem::GravitySystem(JobSystem& jobSystem, const GravityModel& model)
+        : _job_system(jobSystem), _model(model)
     {
-        // Get a view of all entities that have the components we need.
-        auto view = registry.view<TransformComponent, MassComponent, ForceAccumulatorComponent>();
-        for (auto entity : view)
-        {
-            auto& transform = view.get<TransformComponent>(entity);
-            auto& mass = view.get<MassComponent>(entity);
-            auto& accumulator = view.get<ForceAccumulatorComponent>(entity);
-            // Calculate the distance from the center of the Earth.
-            double distance_from_center = glm::length(transform.position);
-
-            // Avoid division by zero if an object is at the exact center of the Earth.
-            if (distance_from_center < 1.0)
-            {
-                continue;
-            }
+    }
 
-            // Calculate the size of the gravitational force using Newton's law.
-            // F = G * (m1 * m2) / r^2
-            double force_magnitude = (GRAVITATIONAL_CONSTANT * EARTH_MASS_KG * mass.currentMass_kg) /
-                (distance_from_center * distance_from_center);
+    void GravitySystem::update(Registry& registry, double dt)
+    {
+        // Sweep the rigid-body group in tiles. Positions and masses are stored as structs, so
+        // each tile gathers them into SoA arrays first; the forces are already SoA lanes and
+        // the kernel adds to them in place.
+        auto group = rigidBodyGroup(registry);
+        const TransformComponent* transforms = group.data<TransformComponent>();
+        const MassComponent* masses = group.data<MassComponent>();
+        const SoAArray<ForceAccumulatorComponent> forces = group.data<ForceAccumulatorComponent>();
+        constexpr size_t FORCE = SoALayout<ForceAccumulatorComponent>::FORCE;
 
-            // Determine the direction of the force (towards the Earth's center at 0,0,0).
-            glm::dvec3 force_direction = -glm::normalize(transform.position);
+        _job_system.parallelFor(group.size(), GRAIN_SIZE, [&](size_t begin, size_t end)
+        {
+            alignas(64) double x[TILE_SIZE];
+            alignas(64) double y[TILE_SIZE];
+            alignas(64) double z[TILE_SIZE];
+            alignas(64) double mass[TILE_SIZE];
 
-            // Calculate the final force vector.
-            glm::dvec3 gravity_force = force_direction * force_magnitude;
+            for (size_t tile = begin; tile < end; tile += TILE_SIZE)
+            {
+                const size_t count = std::min(TILE_SIZE, end - tile);
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const glm::dvec3& position = transforms[tile + i].position;
+                    x[i] = position.x;
+                    y[i] = position.y;
+                    z[i] = position.z;
+                    mass[i] = masses[tile + i].currentMass_kg;
+                }
 
-            // Add the calculated force to the entity's force accumulator.
-            accumulator.addForce(gravity_force);
-        }
+                accumulateGravity(_model, {
+                    x, y, z, mass,
+                    forces.lane(FORCE) + tile, forces.lane(FORCE + 1) + tile, forces.lane(FORCE + 2) + tile,
+                    count
+                });
+            }
+        });
     }
 } // namespace StrikeEngine
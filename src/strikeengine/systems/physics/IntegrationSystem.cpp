@@ -1,103 +1,198 @@
 #include "strikeengine/systems/physics/IntegrationSystem.hpp"
+#include "strikeengine/systems/physics/RigidBodyGroup.hpp"
 #include "strikeengine/ecs/Registry.hpp"
 #include "strikeengine/components/transform/TransformComponent.hpp"
 #include "strikeengine/components/physics/VelocityComponent.hpp"
 #include "strikeengine/components/physics/MassComponent.hpp"
 #include "strikeengine/components/physics/InertiaComponent.hpp"
 #include "strikeengine/components/physics/ForceAccumulatorComponent.hpp"
-#include <glm/gtc/quaternion.hpp>
-#include <glm/gtx/quaternion.hpp>
+#include "strikeengine/components/physics/AdaptiveStepComponent.hpp"
+
+#include <algorithm>
+#include <vector>
 
 namespace StrikeEngine {
-    struct StateDerivative {
-        glm::dvec3 velocity; // dx/dt
-        glm::dvec3 acceleration; // dv/dt
-    };
-
-    // This helper function evaluates the forces acting on the body at a given state
-    // and computes the resulting derivatives (accelerations).
-    StateDerivative evaluate(const Registry& registry, const TransformComponent& transform,
-                             const VelocityComponent& velocity, const MassComponent& mass,
-                             const InertiaComponent& inertia, const ForceAccumulatorComponent& accumulator)
+    namespace {
+        // Entities per parallel chunk; each chunk is integrated as one batch per scheme.
+        constexpr size_t GRAIN_SIZE = 256;
+
+        // The members of a chunk gathered into one batch, in batch order.
+        struct Members {
+            RigidBodyBatch batch;
+            std::vector<double> held; // Force and torque lanes held over the step
+
+            std::vector<TransformComponent*> transforms;
+            std::vector<ComponentRef<VelocityComponent>> velocities;
+            std::vector<ComponentRef<ForceAccumulatorComponent>> accumulators;
+            std::vector<const MassComponent*> masses;
+            std::vector<const InertiaComponent*> inertias;
+            std::vector<AdaptiveStepComponent*> steps; // Adaptive members only
+
+            void clear() {
+                transforms.clear();
+                velocities.clear();
+                accumulators.clear();
+                masses.clear();
+                inertias.clear();
+                steps.clear();
+            }
+        };
+
+        // Per-thread buffers, reused from frame to frame.
+        struct Workspace {
+            RigidBodyIntegrator integrator;
+            Members fixed;
+            Members adaptive;
+        };
+
+        thread_local Workspace t_workspace;
+
+        GravityBatch gravityBatch(RigidBodyBatch& batch) {
+            using B = RigidBodyBatch;
+            return {
+                batch.lane(B::POSITION), batch.lane(B::POSITION + 1), batch.lane(B::POSITION + 2), batch.lane(B::MASS),
+                batch.lane(B::FORCE), batch.lane(B::FORCE + 1), batch.lane(B::FORCE + 2),
+                batch.size()
+            };
+        }
+
+        // Fills the batch from the gathered members and splits the state-dependent gravity off
+        // the accumulated forces, leaving the part held over the step in members.held.
+        void gather(Members& members, const std::optional<GravityModel>& gravity)
+        {
+            using B = RigidBodyBatch;
+            RigidBodyBatch& batch = members.batch;
+            const size_t count = members.transforms.size();
+            batch.resize(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                const TransformComponent& transform = *members.transforms[i];
+                batch.setState(i, transform.position, members.velocities[i].getLinear(), transform.orientation,
+                               members.velocities[i].getAngular());
+                batch.setMassProperties(i, members.masses[i]->currentMass_kg, members.masses[i]->inverseMass,
+                                        members.inertias[i]->getInertiaTensor(), members.inertias[i]->getInverseInertiaTensor());
+                batch.setForce(i, members.accumulators[i].getTotalForce(), members.accumulators[i].getTotalTorque());
+            }
+
+            const size_t stride = batch.stride();
+            members.held.resize(std::max(members.held.size(), 6 * stride));
+            std::copy_n(batch.lane(B::FORCE), 6 * stride, members.held.data());
+            if (gravity)
+            {
+                std::fill_n(batch.lane(B::FORCE), 3 * stride, 0.0);
+                accumulateGravity(*gravity, gravityBatch(batch));
+                for (size_t k = 0; k < 3; ++k)
+                {
+                    double* held = members.held.data() + k * stride;
+                    const double* start_gravity = batch.lane(B::FORCE + k);
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        held[i] -= start_gravity[i];
+                    }
+                }
+            }
+        }
+
+        // The held forces of each body plus gravity at its stage state. The adaptive integrator
+        // hands in a reordered working copy, so the held forces are looked up by BODY index.
+        RigidBodyIntegrator::ForceFunction stageForces(const Members& members, const std::optional<GravityModel>& gravity)
+        {
+            return [&members, &gravity](RigidBodyBatch& stage)
+            {
+                using B = RigidBodyBatch;
+                const size_t stride = members.batch.stride();
+                const double* body = stage.lane(B::BODY);
+                for (size_t k = 0; k < 6; ++k)
+                {
+                    const double* held = members.held.data() + k * stride;
+                    double* out = stage.lane(B::FORCE + k);
+                    for (size_t i = 0; i < stage.size(); ++i)
+                    {
+                        out[i] = held[static_cast<size_t>(body[i])];
+                    }
+                }
+                if (gravity)
+                {
+                    accumulateGravity(*gravity, gravityBatch(stage));
+                }
+            };
+        }
+
+        void scatter(Members& members)
+        {
+            const RigidBodyBatch& batch = members.batch;
+            for (size_t i = 0; i < members.transforms.size(); ++i)
+            {
+                members.transforms[i]->position = batch.position(i);
+                members.transforms[i]->orientation = batch.orientation(i);
+                members.velocities[i].setLinear(batch.velocity(i));
+                members.velocities[i].setAngular(batch.angularVelocity(i));
+                members.accumulators[i].clear();
+            }
+        }
+    }
+
+    IntegrationSystem::IntegrationSystem(JobSystem& jobSystem, std::optional<GravityModel> gravity,
+                                         const AdaptiveStepControl& stepControl)
+        : _job_system(jobSystem), _gravity(gravity), _step_control(stepControl)
     {
-        StateDerivative output{};
-        output.velocity = velocity.getLinear();
-        output.acceleration = accumulator.getTotalForce() * mass.inverseMass;
-
-        // Note: For a true RK4 on rotation, we would also calculate angular acceleration here
-        // and return it. For simplicity and stability, we will integrate rotation separately
-        // after the main RK4 position/velocity update.
-        return output;
     }
 
     void IntegrationSystem::update(Registry& registry, double dt)
     {
-        auto view = registry.view<TransformComponent, VelocityComponent, MassComponent, InertiaComponent,
-                                  ForceAccumulatorComponent>();
+        auto group = rigidBodyGroup(registry, Get<const InertiaComponent>{});
+        auto adaptive_view = registry.view<AdaptiveStepComponent>();
 
-        for (auto entity : view)
+        _job_system.parallelFor(group.size(), GRAIN_SIZE, [&](size_t begin, size_t end)
         {
-            auto& transform = view.get<TransformComponent>(entity);
-            auto& velocity = view.get<VelocityComponent>(entity);
-            auto& mass = view.get<MassComponent>(entity);
-            auto& inertia = view.get<InertiaComponent>(entity);
-            auto& accumulator = view.get<ForceAccumulatorComponent>(entity);
-
-            if (mass.inverseMass <= 0.0)
+            Workspace& ws = t_workspace;
+            ws.fixed.clear();
+            ws.adaptive.clear();
+            group.eachInRange(begin, end, [&](Entity entity, TransformComponent& transform, ComponentRef<VelocityComponent> velocity,
+                                              MassComponent& mass, ComponentRef<ForceAccumulatorComponent> accumulator,
+                                              const InertiaComponent& inertia)
             {
-                // Skip static or immovable objects
-                accumulator.clear();
-                continue;
-            }
-
-            // --- RK4 Integration for Linear Motion (Position and Velocity) ---
-
-            // k1: Evaluate at the beginning of the step (t)
-            StateDerivative k1 = evaluate(registry, transform, velocity, mass, inertia, accumulator);
-
-            // k2: Evaluate at the midpoint of the step (t + dt/2)
-            VelocityComponent mid_vel_k2 = velocity;
-            mid_vel_k2.addLinear(k1.acceleration * (dt * 0.5));
-            StateDerivative k2 = evaluate(registry, transform, mid_vel_k2, mass, inertia, accumulator);
-
-            // k3: Evaluate again at the midpoint (t + dt/2), but using k2's velocity
-            VelocityComponent mid_vel_k3 = velocity;
-            mid_vel_k2.addLinear(k2.acceleration * (dt * 0.5));
-            StateDerivative k3 = evaluate(registry, transform, mid_vel_k3, mass, inertia, accumulator);
-
-            // k4: Evaluate at the end of the step (t + dt)
-            VelocityComponent end_vel_k4 = velocity;
-            end_vel_k4.addLinear(k3.acceleration * dt);
-            StateDerivative k4 = evaluate(registry, transform, end_vel_k4, mass, inertia, accumulator);
-
-            // --- Update Final Linear State ---
-            // Combine the derivatives using the RK4 weighted average to get the final position and velocity.
-            transform.position += (dt / 6.0) * (k1.velocity + 2.0 * k2.velocity + 2.0 * k3.velocity + k4.velocity);
-            velocity.addLinear((dt / 6.0) * (k1.acceleration + 2.0 * k2.acceleration + 2.0 * k3.acceleration + k4.acceleration));
-
-            // --- Integrate Rotational Motion ---
-            // Rotational updates are kept separate for stability and clarity. We use the same
-            // gyroscopic precession formula as the previous implementation.
-            const glm::dvec3 angular_velocity_world = transform.orientation * velocity.getAngular();
-            const glm::dvec3 angular_acceleration_world = inertia.getInverseInertiaTensor() *
-            (accumulator.getTotalTorque() - glm::cross(angular_velocity_world,
-                                                  inertia.getInertiaTensor() * angular_velocity_world));
-
-            // Update angular velocity (convert world-space acceleration to body-space for storage)
-            velocity.setAngular(glm::inverse(transform.orientation) * angular_acceleration_world * dt);
-
-            // Update orientation using the new angular velocity
-            glm::dvec3 rotation_axis = velocity.getAngular();
-            double angle = glm::length(rotation_axis) * dt;
-            if (angle > 0.0)
+                if (mass.inverseMass <= 0.0)
+                {
+                    // Static or immovable objects are not integrated
+                    accumulator.clear();
+                    return;
+                }
+                Members& members = adaptive_view.contains(entity) ? ws.adaptive : ws.fixed;
+                members.transforms.push_back(&transform);
+                members.velocities.push_back(velocity);
+                members.accumulators.push_back(accumulator);
+                members.masses.push_back(&mass);
+                members.inertias.push_back(&inertia);
+                if (&members == &ws.adaptive)
+                {
+                    members.steps.push_back(&adaptive_view.get<AdaptiveStepComponent>(entity));
+                }
+            });
+
+            // --- Fixed step: one RK4 step over the frame ---
+            gather(ws.fixed, _gravity);
+            ws.integrator.stepRK4(ws.fixed.batch, dt, stageForces(ws.fixed, _gravity));
+            scatter(ws.fixed);
+
+            // --- Adaptive: Dormand-Prince sub-steps, starting from each body's last step size ---
+            Members& adaptive = ws.adaptive;
+            if (!adaptive.transforms.empty())
             {
-                rotation_axis = glm::normalize(rotation_axis);
-                glm::dquat rotation_delta = glm::angleAxis(angle, rotation_axis);
-                transform.orientation = glm::normalize(rotation_delta * transform.orientation);
+                gather(adaptive, _gravity);
+                for (size_t i = 0; i < adaptive.steps.size(); ++i)
+                {
+                    adaptive.batch.lane(RigidBodyBatch::STEP)[i] = adaptive.steps[i]->step_s;
+                }
+                ws.integrator.integrateAdaptive(adaptive.batch, dt, stageForces(adaptive, _gravity), _step_control);
+                for (size_t i = 0; i < adaptive.steps.size(); ++i)
+                {
+                    adaptive.steps[i]->step_s = adaptive.batch.lane(RigidBodyBatch::STEP)[i];
+                    adaptive.steps[i]->accepted_steps = ws.integrator.acceptedSteps(i);
+                    adaptive.steps[i]->rejected_steps = ws.integrator.rejectedSteps(i);
+                }
+                scatter(adaptive);
             }
-
-            // --- Clear the Force Accumulator for the next frame ---
-            accumulator.clear();
-        }
+        });
     }
 } // namespace StrikeEngine
@@ -27,23 +27,25 @@ namespace StrikeEngine {
         return thrust1 + fraction * (thrust2 - thrust1);
     }
 
-    PropulsionSystem::PropulsionSystem(const AtmosphereManager& atmosphereManager)
-        : _atmosphere_manager(atmosphereManager) {}
+    namespace {
+        // Entities per parallel chunk.
+        constexpr size_t GRAIN_SIZE = 128;
+    }
+
+    PropulsionSystem::PropulsionSystem(const AtmosphereManager& atmosphereManager, JobSystem& jobSystem)
+        : _atmosphere_manager(atmosphereManager), _job_system(jobSystem) {}
 
     PropulsionSystem::~PropulsionSystem() = default;
 
     void PropulsionSystem::update(Registry& registry, double dt) {
         if (!_atmosphere_manager.isLoaded()) { return; }
 
-        auto view = registry.view<PropulsionComponent, TransformComponent, ForceAccumulatorComponent, MassComponent>();
+        auto view = registry.view<PropulsionComponent, const TransformComponent, ForceAccumulatorComponent, MassComponent>();
 
-        for (auto entity: view) {
-            auto& propulsion = view.get<PropulsionComponent>(entity);
-            auto& transform = view.get<TransformComponent>(entity);
-            auto& accumulator = view.get<ForceAccumulatorComponent>(entity);
-            auto& mass = view.get<MassComponent>(entity);
+        view.parallelEach(_job_system, GRAIN_SIZE, [&](PropulsionComponent& propulsion, const TransformComponent& transform,
+                      ComponentRef<ForceAccumulatorComponent> accumulator, MassComponent& mass) {
             if (!propulsion.active || propulsion.currentStageIndex < 0 || propulsion.currentStageIndex >= propulsion.stages.size()) {
-                continue;
+                return;
             }
 
             auto& currentStage = propulsion.stages[propulsion.currentStageIndex];
@@ -56,7 +58,7 @@ namespace StrikeEngine {
                 if (propulsion.currentStageIndex >= propulsion.stages.size()) {
                     propulsion.active = false;
                 }
-                continue;
+                return;
             }
 
             double currentThrust = getThrustFromCurve(propulsion.timeInCurrentStage_seconds, currentStage.thrust_curve);
@@ -68,7 +70,7 @@ namespace StrikeEngine {
 
                 // --- NEW: Calculate Fuel Consumption with Atmospheric Effects ---
                 const double altitude = glm::length(transform.position); // Approximation
-                const double ambient_pressure_pa = _atmosphere_manager.getProperties(altitude).pressure;
+                const double ambient_pressure_pa = _atmosphere_manager.compactTable().getProperties(altitude).pressure;
                 constexpr double sea_level_pressure_pa = 101325.0;
 
                 // Interpolate Isp based on pressure
@@ -85,7 +87,7 @@ namespace StrikeEngine {
             }
 
             propulsion.timeInCurrentStage_seconds += dt;
-        }
+        });
     }
 
 } // namespace StrikeEngine
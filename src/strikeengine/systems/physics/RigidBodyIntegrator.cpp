@@ -0,0 +1,362 @@
+#include "strikeengine/systems/physics/RigidBodyIntegrator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace StrikeEngine {
+    namespace {
+        // Lanes are padded to a multiple of this many doubles (one cache line).
+        constexpr size_t LANE_PADDING = 8;
+
+        // Dormand-Prince 5(4): nodes, stage coefficients (the last row is the 5th-order
+        // solution, so the seventh stage is the first of the next step) and the difference
+        // between the 5th- and 4th-order weights.
+        constexpr size_t DP_STAGES = 7;
+        constexpr double DP_C[DP_STAGES] = {0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0};
+        constexpr double DP_A[DP_STAGES][DP_STAGES - 1] = {
+            {},
+            {1.0 / 5.0},
+            {3.0 / 40.0, 9.0 / 40.0},
+            {44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0},
+            {19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0},
+            {9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0},
+            {35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0},
+        };
+        constexpr double DP_E[DP_STAGES] = {
+            71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0, -17253.0 / 339200.0, 22.0 / 525.0, -1.0 / 40.0
+        };
+
+        // The absolute tolerance of state lane k.
+        double absoluteTolerance(const AdaptiveStepControl& control, size_t k) {
+            if (k < RigidBodyBatch::VELOCITY) {
+                return control.position_tolerance_m;
+            }
+            if (k < RigidBodyBatch::ORIENTATION) {
+                return control.velocity_tolerance_mps;
+            }
+            if (k < RigidBodyBatch::ANGULAR_VELOCITY) {
+                return control.orientation_tolerance;
+            }
+            return control.angular_velocity_tolerance_rps;
+        }
+
+        void normalizeOrientation(RigidBodyBatch& batch, size_t i) {
+            double* q[4];
+            for (size_t k = 0; k < 4; ++k) {
+                q[k] = batch.lane(RigidBodyBatch::ORIENTATION + k) + i;
+            }
+            const double inverse_norm = 1.0 / std::sqrt(*q[0] * *q[0] + *q[1] * *q[1] + *q[2] * *q[2] + *q[3] * *q[3]);
+            for (double* component : q) {
+                *component *= inverse_norm;
+            }
+        }
+
+        // state = base + h * slope, over the first STATE_LANES lanes.
+        void axpy(double* state, const double* base, const double* slope, double h, size_t stride, size_t count) {
+            for (size_t k = 0; k < RigidBodyBatch::STATE_LANES; ++k) {
+                double* out = state + k * stride;
+                const double* b = base + k * stride;
+                const double* s = slope + k * stride;
+                for (size_t i = 0; i < count; ++i) {
+                    out[i] = b[i] + h * s[i];
+                }
+            }
+        }
+    }
+
+    void RigidBodyBatch::resize(size_t count) {
+        if (count > _stride) {
+            _stride = (count + LANE_PADDING - 1) / LANE_PADDING * LANE_PADDING;
+            _lanes.resize(LANES * _stride);
+        }
+        _count = count;
+    }
+
+    void RigidBodyBatch::setState(size_t i, const glm::dvec3& position, const glm::dvec3& velocity,
+                                  const glm::dquat& orientation, const glm::dvec3& angularVelocity) {
+        storeVec3(POSITION, i, position);
+        storeVec3(VELOCITY, i, velocity);
+        lane(ORIENTATION)[i] = orientation.w;
+        lane(ORIENTATION + 1)[i] = orientation.x;
+        lane(ORIENTATION + 2)[i] = orientation.y;
+        lane(ORIENTATION + 3)[i] = orientation.z;
+        storeVec3(ANGULAR_VELOCITY, i, angularVelocity);
+    }
+
+    void RigidBodyBatch::setMassProperties(size_t i, double mass, double inverseMass,
+                                           const glm::dmat3& inertia, const glm::dmat3& inverseInertia) {
+        lane(MASS)[i] = mass;
+        lane(INVERSE_MASS)[i] = inverseMass;
+        for (int column = 0; column < 3; ++column) {
+            for (int row = 0; row < 3; ++row) {
+                lane(INERTIA + column * 3 + row)[i] = inertia[column][row];
+                lane(INVERSE_INERTIA + column * 3 + row)[i] = inverseInertia[column][row];
+            }
+        }
+    }
+
+    void RigidBodyBatch::setForce(size_t i, const glm::dvec3& force, const glm::dvec3& torque) {
+        storeVec3(FORCE, i, force);
+        storeVec3(TORQUE, i, torque);
+    }
+
+    void RigidBodyBatch::copyBody(size_t to, const RigidBodyBatch& source, size_t from) {
+        for (size_t k = 0; k < LANES; ++k) {
+            lane(k)[to] = source.lane(k)[from];
+        }
+    }
+
+    glm::dquat RigidBodyBatch::orientation(size_t i) const {
+        return {lane(ORIENTATION)[i], lane(ORIENTATION + 1)[i], lane(ORIENTATION + 2)[i], lane(ORIENTATION + 3)[i]};
+    }
+
+    void RigidBodyIntegrator::derivative(const RigidBodyBatch& batch, double* out) {
+        using B = RigidBodyBatch;
+        const size_t stride = batch.stride();
+        const size_t count = batch.size();
+        const auto outLane = [out, stride](size_t k) { return out + k * stride; };
+
+        // Position and velocity lanes: dp/dt = v, dv/dt = F/m.
+        for (size_t k = 0; k < 3; ++k) {
+            std::copy_n(batch.lane(B::VELOCITY + k), count, outLane(B::POSITION + k));
+            const double* force = batch.lane(B::FORCE + k);
+            const double* inverse_mass = batch.lane(B::INVERSE_MASS);
+            double* acceleration = outLane(B::VELOCITY + k);
+            for (size_t i = 0; i < count; ++i) {
+                acceleration[i] = force[i] * inverse_mass[i];
+            }
+        }
+
+        // Attitude: quaternion kinematics and Euler's equations in the body frame.
+        const double* qw = batch.lane(B::ORIENTATION);
+        const double* qx = batch.lane(B::ORIENTATION + 1);
+        const double* qy = batch.lane(B::ORIENTATION + 2);
+        const double* qz = batch.lane(B::ORIENTATION + 3);
+        const double* wx = batch.lane(B::ANGULAR_VELOCITY);
+        const double* wy = batch.lane(B::ANGULAR_VELOCITY + 1);
+        const double* wz = batch.lane(B::ANGULAR_VELOCITY + 2);
+        const double* tx = batch.lane(B::TORQUE);
+        const double* ty = batch.lane(B::TORQUE + 1);
+        const double* tz = batch.lane(B::TORQUE + 2);
+        const double* inertia[9];
+        const double* inverse_inertia[9];
+        for (size_t k = 0; k < 9; ++k) {
+            inertia[k] = batch.lane(B::INERTIA + k);
+            inverse_inertia[k] = batch.lane(B::INVERSE_INERTIA + k);
+        }
+        double* dqw = outLane(B::ORIENTATION);
+        double* dqx = outLane(B::ORIENTATION + 1);
+        double* dqy = outLane(B::ORIENTATION + 2);
+        double* dqz = outLane(B::ORIENTATION + 3);
+        double* dwx = outLane(B::ANGULAR_VELOCITY);
+        double* dwy = outLane(B::ANGULAR_VELOCITY + 1);
+        double* dwz = outLane(B::ANGULAR_VELOCITY + 2);
+
+        for (size_t i = 0; i < count; ++i) {
+            // dq/dt = q * (0, w) / 2
+            dqw[i] = -0.5 * (qx[i] * wx[i] + qy[i] * wy[i] + qz[i] * wz[i]);
+            dqx[i] = 0.5 * (qw[i] * wx[i] + qy[i] * wz[i] - qz[i] * wy[i]);
+            dqy[i] = 0.5 * (qw[i] * wy[i] + qz[i] * wx[i] - qx[i] * wz[i]);
+            dqz[i] = 0.5 * (qw[i] * wz[i] + qx[i] * wy[i] - qy[i] * wx[i]);
+
+            // World torque into the body frame: rotate by the conjugate. Stage quaternions are
+            // not exactly unit length, so the rotation is scaled by 1/|q|^2.
+            const double s = 2.0 / (qw[i] * qw[i] + qx[i] * qx[i] + qy[i] * qy[i] + qz[i] * qz[i]);
+            const double cx = qy[i] * tz[i] - qz[i] * ty[i];
+            const double cy = qz[i] * tx[i] - qx[i] * tz[i];
+            const double cz = qx[i] * ty[i] - qy[i] * tx[i];
+            const double bx = tx[i] + s * (-qw[i] * cx + qy[i] * cz - qz[i] * cy);
+            const double by = ty[i] + s * (-qw[i] * cy + qz[i] * cx - qx[i] * cz);
+            const double bz = tz[i] + s * (-qw[i] * cz + qx[i] * cy - qy[i] * cx);
+
+            // dw/dt = I^-1 (tau - w x I w)
+            const double hx = inertia[0][i] * wx[i] + inertia[3][i] * wy[i] + inertia[6][i] * wz[i];
+            const double hy = inertia[1][i] * wx[i] + inertia[4][i] * wy[i] + inertia[7][i] * wz[i];
+            const double hz = inertia[2][i] * wx[i] + inertia[5][i] * wy[i] + inertia[8][i] * wz[i];
+            const double mx = bx - (wy[i] * hz - wz[i] * hy);
+            const double my = by - (wz[i] * hx - wx[i] * hz);
+            const double mz = bz - (wx[i] * hy - wy[i] * hx);
+            dwx[i] = inverse_inertia[0][i] * mx + inverse_inertia[3][i] * my + inverse_inertia[6][i] * mz;
+            dwy[i] = inverse_inertia[1][i] * mx + inverse_inertia[4][i] * my + inverse_inertia[7][i] * mz;
+            dwz[i] = inverse_inertia[2][i] * mx + inverse_inertia[5][i] * my + inverse_inertia[8][i] * mz;
+        }
+    }
+
+    void RigidBodyIntegrator::stepRK4(RigidBodyBatch& batch, double dt, const ForceFunction& forces) {
+        using B = RigidBodyBatch;
+        const size_t stride = batch.stride();
+        const size_t count = batch.size();
+        const size_t state_size = B::STATE_LANES * stride;
+        _initial.resize(std::max(_initial.size(), state_size));
+        _slope.resize(std::max(_slope.size(), state_size));
+        _sum.resize(std::max(_sum.size(), state_size));
+
+        double* state = batch.lane(0);
+        std::copy_n(state, state_size, _initial.data());
+        for (size_t i = 0; i < count; ++i) {
+            batch.lane(B::BODY)[i] = static_cast<double>(i);
+        }
+
+        // k1 at t
+        std::fill_n(batch.lane(B::TIME), count, 0.0);
+        forces(batch);
+        derivative(batch, _sum.data());
+        axpy(state, _initial.data(), _sum.data(), 0.5 * dt, stride, count);
+
+        // k2 and k3 at t + dt/2; k4 at t + dt. The running sum collects k1 + 2 k2 + 2 k3 + k4.
+        constexpr double STAGE_TIME[3] = {0.5, 0.5, 1.0};
+        constexpr double NEXT_OFFSET[3] = {0.5, 1.0, 0.0};
+        constexpr double WEIGHT[3] = {2.0, 2.0, 1.0};
+        for (int stage = 0; stage < 3; ++stage) {
+            std::fill_n(batch.lane(B::TIME), count, STAGE_TIME[stage] * dt);
+            forces(batch);
+            derivative(batch, _slope.data());
+            for (size_t k = 0; k < B::STATE_LANES; ++k) {
+                double* sum = _sum.data() + k * stride;
+                const double* slope = _slope.data() + k * stride;
+                for (size_t i = 0; i < count; ++i) {
+                    sum[i] += WEIGHT[stage] * slope[i];
+                }
+            }
+            if (stage < 2) {
+                axpy(state, _initial.data(), _slope.data(), NEXT_OFFSET[stage] * dt, stride, count);
+            }
+        }
+        axpy(state, _initial.data(), _sum.data(), dt / 6.0, stride, count);
+
+        for (size_t i = 0; i < count; ++i) {
+            normalizeOrientation(batch, i);
+        }
+    }
+
+    void RigidBodyIntegrator::integrateAdaptive(RigidBodyBatch& batch, double duration, const ForceFunction& forces,
+                                                const AdaptiveStepControl& control) {
+        using B = RigidBodyBatch;
+        const size_t count = batch.size();
+        _accepted.assign(count, 0);
+        _rejected.assign(count, 0);
+        if (count == 0) {
+            return;
+        }
+
+        // Bodies sub-step in a working copy; a body that reaches the end of the duration is
+        // written back and swap-removed, so later sub-steps only run the bodies still going.
+        _work.resize(count);
+        const size_t stride = _work.stride();
+        _elapsed.assign(stride, 0.0);
+        _taken.resize(stride);
+        _error.resize(stride);
+        _initial.resize(std::max(_initial.size(), B::STATE_LANES * stride));
+        _stages.resize(std::max(_stages.size(), DP_STAGES * B::STATE_LANES * stride));
+        const auto stage = [this, stride](size_t s, size_t k) { return _stages.data() + (s * B::STATE_LANES + k) * stride; };
+
+        for (size_t i = 0; i < count; ++i) {
+            _work.copyBody(i, batch, i);
+            _work.lane(B::BODY)[i] = static_cast<double>(i);
+            double& step = _work.lane(B::STEP)[i];
+            step = std::clamp(step > 0.0 ? step : duration, control.min_step_s, control.max_step_s);
+        }
+
+        // k1 at the start; afterwards it carries over from the last stage of the previous sub-step.
+        std::fill_n(_work.lane(B::TIME), count, 0.0);
+        forces(_work);
+        derivative(_work, stage(0, 0));
+
+        const double end_tolerance = 1e-12 * duration;
+        size_t active = count;
+        while (active > 0) {
+            double* step = _work.lane(B::STEP);
+            const double* body = _work.lane(B::BODY);
+            for (size_t i = 0; i < active; ++i) {
+                _taken[i] = std::min(step[i], duration - _elapsed[i]);
+            }
+            std::copy_n(_work.lane(0), B::STATE_LANES * stride, _initial.data());
+
+            // Stages 2..7; after the last one the state lanes hold the 5th-order solution.
+            for (size_t s = 1; s < DP_STAGES; ++s) {
+                for (size_t k = 0; k < B::STATE_LANES; ++k) {
+                    double* state = _work.lane(k);
+                    const double* initial = _initial.data() + k * stride;
+                    for (size_t i = 0; i < active; ++i) {
+                        double increment = 0.0;
+                        for (size_t j = 0; j < s; ++j) {
+                            increment += DP_A[s][j] * stage(j, k)[i];
+                        }
+                        state[i] = initial[i] + _taken[i] * increment;
+                    }
+                }
+                double* time = _work.lane(B::TIME);
+                for (size_t i = 0; i < active; ++i) {
+                    time[i] = _elapsed[i] + DP_C[s] * _taken[i];
+                }
+                forces(_work);
+                derivative(_work, stage(s, 0));
+            }
+
+            // Error estimate: the largest element error relative to its tolerance.
+            std::fill_n(_error.data(), active, 0.0);
+            for (size_t k = 0; k < B::STATE_LANES; ++k) {
+                const double absolute = absoluteTolerance(control, k);
+                const double* state = _work.lane(k);
+                const double* initial = _initial.data() + k * stride;
+                for (size_t i = 0; i < active; ++i) {
+                    double estimate = 0.0;
+                    for (size_t j = 0; j < DP_STAGES; ++j) {
+                        estimate += DP_E[j] * stage(j, k)[i];
+                    }
+                    const double scale = absolute + control.relative_tolerance * std::max(std::abs(initial[i]), std::abs(state[i]));
+                    // A NaN anywhere in the stages must fail the step, not vanish in a max.
+                    const double error = std::abs(_taken[i] * estimate) / scale;
+                    if (!(error <= _error[i])) {
+                        _error[i] = std::isfinite(error) ? error : std::numeric_limits<double>::infinity();
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < active; ++i) {
+                const double error = _error[i];
+                const double factor = error > 0.0
+                    ? std::clamp(control.safety * std::pow(error, -0.2), control.min_factor, control.max_factor)
+                    : control.max_factor;
+                double proposal;
+                if (error <= 1.0 || _taken[i] <= control.min_step_s) {
+                    _elapsed[i] += _taken[i];
+                    ++_accepted[static_cast<size_t>(body[i])];
+                    for (size_t k = 0; k < B::STATE_LANES; ++k) {
+                        stage(0, k)[i] = stage(DP_STAGES - 1, k)[i];
+                    }
+                    normalizeOrientation(_work, i);
+                    // A step shortened to land on the end of the duration says little about
+                    // the step the body could take; keep the longer one.
+                    proposal = _taken[i] < step[i] ? std::max(step[i], _taken[i] * factor) : _taken[i] * factor;
+                } else {
+                    for (size_t k = 0; k < B::STATE_LANES; ++k) {
+                        _work.lane(k)[i] = _initial[k * stride + i];
+                    }
+                    ++_rejected[static_cast<size_t>(body[i])];
+                    proposal = _taken[i] * std::min(factor, 1.0);
+                }
+                step[i] = std::clamp(proposal, control.min_step_s, control.max_step_s);
+            }
+
+            // Retire the bodies that reached the end.
+            for (size_t i = active; i-- > 0;) {
+                if (_elapsed[i] < duration - end_tolerance) {
+                    continue;
+                }
+                batch.copyBody(static_cast<size_t>(body[i]), _work, i);
+                --active;
+                if (i != active) {
+                    _work.copyBody(i, _work, active);
+                    _elapsed[i] = _elapsed[active];
+                    for (size_t k = 0; k < B::STATE_LANES; ++k) {
+                        stage(0, k)[i] = stage(0, k)[active];
+                    }
+                }
+            }
+            _work.resize(active);
+        }
+    }
+
+} // namespace StrikeEngine
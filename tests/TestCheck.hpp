@@ -0,0 +1,27 @@
+#pragma once
+
+#include <atomic>
+#include <iostream>
+
+namespace StrikeEngine::Test {
+
+    /** @brief The number of failed CHECKs so far in this process. */
+    inline std::atomic<int>& checkFailures() {
+        static std::atomic<int> failures{0};
+        return failures;
+    }
+
+} // namespace StrikeEngine::Test
+
+/**
+ * @brief Reports a failed condition with its location and counts it, then carries on. Unlike
+ * assert it is not compiled out by NDEBUG, so a Release test build checks just as much.
+ * Each run*Tests() returns the number of CHECKs that failed while it ran.
+ */
+#define CHECK(condition)                                                                                    \
+    do {                                                                                                    \
+        if (!(condition)) {                                                                                 \
+            ++::StrikeEngine::Test::checkFailures();                                                        \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " << #condition << std::endl;    \
+        }                                                                                                   \
+    } while (false)
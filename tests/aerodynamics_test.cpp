@@ -0,0 +1,582 @@
+#include "strikeengine/flight/AerodynamicsDatabase.hpp"
+#include "strikeengine/atmosphere/AtmosphereManager.hpp"
+#include "strikeengine/atmosphere/WeatherField.hpp"
+#include "strikeengine/core/JobSystem.hpp"
+#include "strikeengine/ecs/Registry.hpp"
+#include "strikeengine/components/transform/TransformComponent.hpp"
+#include "strikeengine/components/physics/VelocityComponent.hpp"
+#include "strikeengine/components/physics/MassComponent.hpp"
+#include "strikeengine/components/physics/ForceAccumulatorComponent.hpp"
+#include "strikeengine/components/physics/AerodynamicProfileComponent.hpp"
+#include "strikeengine/components/physics/ControlSurfaceComponent.hpp"
+#include "strikeengine/systems/physics/AerodynamicsSystem.hpp"
+#include "strikeengine/systems/physics/RigidBodyGroup.hpp"
+#include "strikeengine/core/MappedFile.hpp"
+#include "nlohmann/json.hpp"
+#include "TestCheck.hpp"
+#include <iostream>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    using namespace StrikeEngine;
+
+    const std::string PROFILE_PATH = "data/aero/sa_missile_mk1_aero.json";
+
+    // The tables as the profile stores them, interpolated over the original breakpoints with a
+    // search per axis, and mirrored to negative AoA as the database does.
+    struct ReferenceTable {
+        std::vector<double> mach;
+        std::vector<double> aoa;
+        std::vector<std::vector<double>> cl;
+        std::vector<std::vector<double>> cd;
+
+        explicit ReferenceTable(const std::string& path) {
+            std::ifstream file(path);
+            const nlohmann::json data = nlohmann::json::parse(file);
+            mach = data.at("mach_breakpoints").get<std::vector<double>>();
+            aoa = data.at("aoa_breakpoints_rad").get<std::vector<double>>();
+            cl = data.at("cl_table").get<std::vector<std::vector<double>>>();
+            cd = data.at("cd_table").get<std::vector<std::vector<double>>>();
+        }
+
+        static std::pair<size_t, double> locate(const std::vector<double>& breakpoints, double value) {
+            if (!(value > breakpoints.front())) {
+                return {0, 0.0};
+            }
+            if (value >= breakpoints.back()) {
+                return {breakpoints.size() - 2, 1.0};
+            }
+            const size_t i = std::upper_bound(breakpoints.begin(), breakpoints.end(), value) - breakpoints.begin() - 1;
+            return {i, (value - breakpoints[i]) / (breakpoints[i + 1] - breakpoints[i])};
+        }
+
+        AeroCoefficients lookup(double m, double a) const {
+            if (a < 0.0) {
+                const AeroCoefficients mirrored = lookup(m, -a);
+                return {-mirrored.Cl, mirrored.Cd};
+            }
+            const auto [i, fm] = locate(mach, m);
+            const auto [j, fa] = locate(aoa, a);
+            auto interpolate = [&](const std::vector<std::vector<double>>& t) {
+                const double low = t[i][j] + fm * (t[i + 1][j] - t[i][j]);
+                const double high = t[i][j + 1] + fm * (t[i + 1][j + 1] - t[i][j + 1]);
+                return low + fa * (high - low);
+            };
+            return {interpolate(cl), interpolate(cd)};
+        }
+    };
+
+    void assertClose(const AeroCoefficients& actual, const AeroCoefficients& expected, double tolerance) {
+        CHECK(std::abs(actual.Cl - expected.Cl) <= tolerance);
+        CHECK(std::abs(actual.Cd - expected.Cd) <= tolerance);
+        CHECK(std::abs(actual.Cy - expected.Cy) <= tolerance);
+        CHECK(std::abs(actual.Cr - expected.Cr) <= tolerance);
+        CHECK(std::abs(actual.Cm - expected.Cm) <= tolerance);
+        CHECK(std::abs(actual.Cn - expected.Cn) <= tolerance);
+    }
+
+    std::vector<AeroFlightCondition> randomConditions(size_t count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> m(-0.5, 4.5);
+        std::uniform_real_distribution<double> a(-0.3, 0.3);
+        std::vector<AeroFlightCondition> conditions(count);
+        for (AeroFlightCondition& condition : conditions) {
+            condition.mach = m(rng);
+            condition.alpha_rad = a(rng);
+        }
+        return conditions;
+    }
+
+    // A JSON profile compiles to a Mach and alpha table that matches bilinear interpolation over
+    // its own breakpoints, single and batched, including outside the tables and at breakpoints.
+    void test_compiled_lookup() {
+        AerodynamicsDatabase db;
+        const bool loaded = db.loadProfile(PROFILE_PATH);
+        CHECK(loaded);
+        CHECK(db.isExact());
+        CHECK(db.table().axes().size() == 2);
+        const ReferenceTable reference(PROFILE_PATH);
+
+        std::vector<AeroFlightCondition> conditions = randomConditions(4003, 21);
+        for (size_t i = 0; i < reference.mach.size(); ++i) {
+            conditions[i].mach = reference.mach[i];
+            conditions[i].alpha_rad = reference.aoa[i % reference.aoa.size()];
+        }
+        std::vector<AeroCoefficients> batch(conditions.size());
+        db.getCoefficients(conditions, batch);
+        for (size_t i = 0; i < conditions.size(); ++i) {
+            const AeroCoefficients expected = reference.lookup(conditions[i].mach, conditions[i].alpha_rad);
+            assertClose(db.getCoefficients(conditions[i]), expected, 1e-12);
+            assertClose(batch[i], expected, 1e-12);
+        }
+
+        // NaN inputs fall back to the first grid point instead of indexing out of the table.
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        AeroFlightCondition undefined;
+        undefined.mach = nan;
+        undefined.alpha_rad = nan;
+        assertClose(db.getCoefficients(undefined), reference.lookup(0.0, -reference.aoa.back()), 1e-12);
+        std::cout << "Compiled aero lookup: OK" << std::endl;
+    }
+
+    // Breakpoints that no small uniform grid fits are resampled approximately, within what the
+    // grid resolution allows.
+    void test_inexact_resampling() {
+        const std::string path = "aero_profile_irregular.json";
+        nlohmann::json profile;
+        profile["mach_breakpoints"] = {0.0, 0.7071, 1.4142, 3.1416};
+        profile["aoa_breakpoints_rad"] = {0.0, 0.1, 0.25};
+        profile["cl_table"] = {{0.0, 0.4, 0.9}, {0.0, 0.5, 1.1}, {0.0, 0.3, 0.7}, {0.0, 0.2, 0.5}};
+        profile["cd_table"] = {{0.02, 0.04, 0.09}, {0.03, 0.05, 0.1}, {0.08, 0.1, 0.15}, {0.05, 0.07, 0.12}};
+        std::ofstream(path) << profile.dump();
+
+        AerodynamicsDatabase coarse(AeroTableOptions{1e-6, 256});
+        const bool loaded = coarse.loadProfile(path);
+        CHECK(loaded);
+        CHECK(!coarse.isExact());
+        const ReferenceTable reference(path);
+        std::remove(path.c_str());
+
+        // The worst error is a slope change smeared over one grid cell: |slope jump| * spacing / 4.
+        for (const AeroFlightCondition& condition : randomConditions(2000, 22)) {
+            assertClose(coarse.getCoefficients(condition), reference.lookup(condition.mach, condition.alpha_rad), 2e-3);
+        }
+        std::cout << "Inexact aero resampling: OK" << std::endl;
+    }
+
+    // Source data for an N-axis table: uneven breakpoints that fit a uniform grid, over
+    // parameters in an arbitrary order, and coefficients from a multilinear function, which
+    // multilinear interpolation reproduces exactly.
+    struct MultilinearProfile {
+        static constexpr AeroParameter ORDER[AERO_MAX_AXES] = {
+            AeroParameter::Altitude, AeroParameter::Mach, AeroParameter::YawDeflection,
+            AeroParameter::Alpha, AeroParameter::Beta, AeroParameter::PitchDeflection};
+
+        std::vector<AeroAxisBreakpoints> axes;
+        std::vector<AeroCoefficients> values;
+
+        explicit MultilinearProfile(size_t n) {
+            for (size_t d = 0; d < n; ++d) {
+                const double low = -0.5 + 0.1 * d;
+                const double step = 0.25 + 0.05 * d;
+                axes.push_back({ORDER[d], {low, low + step, low + 3 * step}});
+            }
+            std::vector<size_t> index(n, 0);
+            size_t points = 1;
+            for (const AeroAxisBreakpoints& axis : axes) {
+                points *= axis.breakpoints.size();
+            }
+            for (size_t p = 0; p < points; ++p) {
+                AeroFlightCondition condition;
+                for (size_t d = 0, rest = p; d < n; ++d) {
+                    const size_t size = axes[n - 1 - d].breakpoints.size();
+                    index[n - 1 - d] = rest % size;
+                    rest /= size;
+                }
+                for (size_t d = 0; d < n; ++d) {
+                    condition.value(axes[d].parameter) = axes[d].breakpoints[index[d]];
+                }
+                values.push_back(evaluate(condition));
+            }
+        }
+
+        static AeroCoefficients evaluate(const AeroFlightCondition& c) {
+            return {0.1 + c.mach + 2.0 * c.alpha_rad * c.mach,
+                    0.02 + c.altitude_m * c.beta_rad,
+                    -0.5 * c.beta_rad + c.yaw_deflection_rad,
+                    0.3 * c.alpha_rad * c.beta_rad * c.pitch_deflection_rad,
+                    -1.2 * c.alpha_rad + 0.8 * c.pitch_deflection_rad,
+                    0.9 * c.beta_rad - 0.7 * c.yaw_deflection_rad * c.altitude_m};
+        }
+
+        AeroFlightCondition random(std::mt19937& rng) const {
+            AeroFlightCondition condition;
+            for (const AeroAxisBreakpoints& axis : axes) {
+                std::uniform_real_distribution<double> value(axis.breakpoints.front(), axis.breakpoints.back());
+                condition.value(axis.parameter) = value(rng);
+            }
+            return condition;
+        }
+    };
+
+    // Every axis count from 1 to 6 reproduces a multilinear function inside the table, and the
+    // batched lookup matches the single one everywhere, out of range included.
+    void test_n_dimensional_table() {
+        std::mt19937 rng(24);
+        for (size_t n = 1; n <= AERO_MAX_AXES; ++n) {
+            const MultilinearProfile profile(n);
+            const AeroTable table = compileAeroTable(profile.axes, profile.values);
+            CHECK(table.axes().size() == n);
+            CHECK(table.isExact());
+            CHECK(table.values().size() == static_cast<size_t>(std::pow(4.0, static_cast<double>(n))));
+
+            std::vector<AeroFlightCondition> conditions(1001);
+            for (AeroFlightCondition& condition : conditions) {
+                condition = profile.random(rng);
+                assertClose(table.lookup(condition), MultilinearProfile::evaluate(condition), 1e-12);
+            }
+            // Spill a few conditions past the table edges; those take the edge values.
+            for (size_t i = 0; i < conditions.size(); i += 7) {
+                conditions[i].mach += 10.0;
+                conditions[i].altitude_m -= 10.0;
+            }
+            std::vector<AeroCoefficients> batch(conditions.size());
+            table.lookup(conditions, batch);
+            for (size_t i = 0; i < conditions.size(); ++i) {
+                assertClose(batch[i], table.lookup(conditions[i]), 1e-12);
+            }
+        }
+
+        // Tables need one axis per parameter and values for every point.
+        const AeroAxisBreakpoints repeated[] = {{AeroParameter::Mach, {0.0, 1.0}}, {AeroParameter::Mach, {0.0, 1.0}}};
+        const AeroCoefficients four[4] = {};
+        bool rejected = false;
+        try { (void)compileAeroTable(repeated, four); } catch (const std::runtime_error&) { rejected = true; }
+        CHECK(rejected);
+        rejected = false;
+        try { (void)compileAeroTable(std::span(repeated, 1), four); } catch (const std::runtime_error&) { rejected = true; }
+        CHECK(rejected);
+        std::cout << "N-dimensional aero table: OK" << std::endl;
+    }
+
+    std::vector<char> readBytes(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    void writeBytes(const std::string& path, const std::vector<char>& bytes) {
+        std::ofstream(path, std::ios::binary).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    bool rejects(const std::string& path) {
+        MappedFile file;
+        const bool opened = file.open(path);
+        CHECK(opened);
+        try {
+            (void)readAeroTable(file.bytes());
+        } catch (const std::runtime_error&) {
+            return true;
+        }
+        return false;
+    }
+
+    bool sameValues(std::span<const AeroCoefficients> a, std::span<const AeroCoefficients> b) {
+        return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size_bytes()) == 0;
+    }
+
+    // Tables round-trip through the binary format and are read in place, aligned; damaged
+    // files are rejected.
+    void test_table_file() {
+        const std::string path = "aero_table_test.aero";
+        const MultilinearProfile profile(4);
+        const AeroTable table = compileAeroTable(profile.axes, profile.values);
+        writeAeroTable(path, table);
+
+        AerodynamicsDatabase db;
+        const bool loaded = db.loadProfile(path);
+        CHECK(loaded);
+        const AeroTable& read = db.table();
+        CHECK(read.axes().size() == table.axes().size());
+        for (size_t d = 0; d < table.axes().size(); ++d) {
+            CHECK(read.axes()[d].parameter == table.axes()[d].parameter);
+            CHECK(read.axes()[d].grid.points == table.axes()[d].grid.points);
+            CHECK(read.axes()[d].grid.origin == table.axes()[d].grid.origin);
+            CHECK(read.axes()[d].grid.spacing == table.axes()[d].grid.spacing);
+        }
+        CHECK(sameValues(read.values(), table.values()));
+        CHECK(reinterpret_cast<uintptr_t>(read.values().data()) % AERO_TABLE_ALIGNMENT == 0);
+
+        const std::vector<char> original = readBytes(path);
+        const size_t data_offset = reinterpret_cast<const AeroTableHeader*>(original.data())->data_offset;
+        std::vector<char> bytes = original;
+        bytes[0] = 'X';
+        writeBytes(path, bytes);
+        CHECK(rejects(path));
+        CHECK(!db.loadProfile(path));
+
+        bytes = original;
+        reinterpret_cast<AeroTableHeader*>(bytes.data())->version = AERO_TABLE_VERSION + 1;
+        writeBytes(path, bytes);
+        CHECK(rejects(path));
+
+        bytes = original;
+        bytes.resize(bytes.size() - 8);
+        writeBytes(path, bytes);
+        CHECK(rejects(path));
+
+        bytes = original;
+        bytes[data_offset + 3] ^= 0x10;
+        writeBytes(path, bytes);
+        CHECK(rejects(path));
+
+        bytes = original;
+        reinterpret_cast<AeroTableHeader*>(bytes.data())->axes[0].points = 0xFFFFFFFFu;
+        writeBytes(path, bytes);
+        CHECK(rejects(path));
+
+        std::remove(path.c_str());
+        CHECK(!db.loadProfile(path));
+
+        // A JSON table profile compiles to the same table as the equivalent breakpoint data.
+        const std::string json_path = "aero_table_test.json";
+        nlohmann::json source;
+        const char* names[] = {"mach", "alpha_rad", "beta_rad", "pitch_deflection_rad", "yaw_deflection_rad", "altitude_m"};
+        for (const AeroAxisBreakpoints& axis : profile.axes) {
+            source["axes"].push_back({{"parameter", names[static_cast<size_t>(axis.parameter)]}, {"breakpoints", axis.breakpoints}});
+        }
+        const char* coefficients[] = {"cl", "cd", "cy", "cr", "cm", "cn"};
+        for (size_t k = 0; k < AERO_COEFFICIENT_COUNT; ++k) {
+            for (const AeroCoefficients& value : profile.values) {
+                source["coefficients"][coefficients[k]].push_back(value.coefficient(k));
+            }
+        }
+        std::ofstream(json_path) << source.dump();
+        const bool compiled = db.loadProfile(json_path);
+        CHECK(compiled);
+        CHECK(sameValues(db.table().values(), table.values()));
+        std::remove(json_path.c_str());
+        std::cout << "Aero table file: OK" << std::endl;
+    }
+
+    // The shipped aero table is the compiled form of the shipped JSON profile.
+    void test_shipped_profile() {
+        AerodynamicsDatabase json;
+        AerodynamicsDatabase compiled;
+        const bool json_loaded = json.loadProfile(PROFILE_PATH);
+        const bool compiled_loaded = compiled.loadProfile("data/aero/sa_missile_mk1_aero.aero");
+        CHECK(json_loaded && compiled_loaded);
+        CHECK(sameValues(json.table().values(), compiled.table().values()));
+        std::cout << "Shipped aero table: OK" << std::endl;
+    }
+
+    // Fin deflections reach the forces: a table with a pitch deflection axis changes the lift
+    // and pitching moment as the fins move, and a sideslip produces a side force.
+    void test_deflection_forces() {
+        AtmosphereManager atmosphere;
+        const bool atmosphere_loaded = atmosphere.loadTable("data/atmosphere_table.bin");
+        CHECK(atmosphere_loaded);
+        JobSystem job_system;
+
+        const AeroAxisBreakpoints axes[] = {{AeroParameter::Beta, {-0.2, 0.2}}, {AeroParameter::PitchDeflection, {-0.3, 0.3}}};
+        const AeroCoefficients values[] = {
+            {-0.6, 0.05, 0.4, 0.0, 0.2, 0.0}, {0.6, 0.05, 0.4, 0.0, -0.2, 0.0},
+            {-0.6, 0.05, -0.4, 0.0, 0.2, 0.0}, {0.6, 0.05, -0.4, 0.0, -0.2, 0.0}};
+        const std::string id = "aero_deflection_test";
+        writeAeroTable("data/aero/" + id + ".aero", compileAeroTable(axes, values));
+
+        auto run = [&](double deflection, const glm::dvec3& velocity, glm::dvec3& torque) {
+            Registry registry;
+            rigidBodyGroup(registry, Get<AerodynamicProfileComponent>{});
+            const Entity body = registry.create();
+            registry.add<TransformComponent>(body, TransformComponent{glm::dvec3(0.0, 1000.0, 0.0)});
+            registry.add<VelocityComponent>(body, VelocityComponent{velocity, glm::dvec3(0.0)});
+            registry.add<MassComponent>(body);
+            registry.add<ForceAccumulatorComponent>(body);
+            AerodynamicProfileComponent aero;
+            aero.profileID = id;
+            aero.reference_length_m = 2.0;
+            registry.add<AerodynamicProfileComponent>(body, aero);
+            ControlSurfaceComponent fins;
+            fins.current_deflection_rad_pitch = deflection;
+            registry.add<ControlSurfaceComponent>(body, fins);
+
+            AerodynamicsSystem system(atmosphere, job_system);
+            system.update(registry, 0.01);
+            torque = registry.get<ForceAccumulatorComponent>(body).getTotalTorque();
+            return registry.get<ForceAccumulatorComponent>(body).getTotalForce();
+        };
+
+        const glm::dvec3 forward(0.0, 0.0, 250.0);
+        glm::dvec3 up_torque;
+        glm::dvec3 neutral_torque;
+        glm::dvec3 down_torque;
+        const glm::dvec3 up = run(0.3, forward, up_torque);
+        const glm::dvec3 neutral = run(0.0, forward, neutral_torque);
+        const glm::dvec3 down = run(-0.3, forward, down_torque);
+        CHECK(up.y > 0.0 && down.y < 0.0 && std::abs(neutral.y) < 1e-9 * std::abs(up.y));
+        CHECK(std::abs(up.y + down.y) < 1e-9 * std::abs(up.y));
+        CHECK(up.z < 0.0 && std::abs(up.z - neutral.z) < 1e-9 * std::abs(up.z)); // Drag does not depend on the fins
+        CHECK(up_torque.x < 0.0 && down_torque.x > 0.0);
+        // Lift over pitching moment is Cl * S / (Cm * S * L).
+        CHECK(std::abs(up.y / up_torque.x + 0.6 / (0.2 * 2.0)) < 1e-9);
+
+        // Slipping towards +X brings the air from that side: positive beta, where this table's
+        // Cy pushes back towards -X.
+        glm::dvec3 sideslip_torque;
+        const glm::dvec3 sideslip = run(0.0, glm::dvec3(20.0, 0.0, 250.0), sideslip_torque);
+        CHECK(sideslip.x < 0.0);
+
+        std::remove(("data/aero/" + id + ".aero").c_str());
+        std::cout << "Fin deflection forces: OK" << std::endl;
+    }
+
+    // The altitude axis is read at the height above the Earth's surface, not the distance from
+    // its centre: a body just above the surface gets the low-altitude drag coefficient.
+    void test_altitude_axis() {
+        AtmosphereManager atmosphere;
+        const bool atmosphere_loaded = atmosphere.loadTable("data/atmosphere_table.bin");
+        CHECK(atmosphere_loaded);
+        JobSystem job_system;
+
+        const AeroAxisBreakpoints axes[] = {{AeroParameter::Altitude, {0.0, 20000.0}}};
+        const AeroCoefficients values[] = {{0.0, 0.2}, {0.0, 0.8}};
+        const std::string id = "aero_altitude_test";
+        writeAeroTable("data/aero/" + id + ".aero", compileAeroTable(axes, values));
+
+        // Returns the drag coefficient the system applied at @p altitude above the default sphere.
+        const double earth_radius_m = WeatherGrid{}.earth_radius_m;
+        const double speed = 250.0;
+        auto drag_coefficient = [&](double altitude) {
+            Registry registry;
+            rigidBodyGroup(registry, Get<AerodynamicProfileComponent>{});
+            const Entity body = registry.create();
+            registry.add<TransformComponent>(body, TransformComponent{glm::dvec3(0.0, earth_radius_m + altitude, 0.0)});
+            registry.add<VelocityComponent>(body, VelocityComponent{glm::dvec3(0.0, 0.0, speed), glm::dvec3(0.0)});
+            registry.add<MassComponent>(body);
+            registry.add<ForceAccumulatorComponent>(body);
+            AerodynamicProfileComponent aero;
+            aero.profileID = id;
+            registry.add<AerodynamicProfileComponent>(body, aero);
+
+            AerodynamicsSystem system(atmosphere, job_system);
+            system.update(registry, 0.01);
+            const double density = atmosphere.compactTable().getProperties(altitude).density;
+            const double force_scale = 0.5 * density * speed * speed * aero.reference_area_m2;
+            return -registry.get<ForceAccumulatorComponent>(body).getTotalForce().z / force_scale;
+        };
+
+        CHECK(std::abs(drag_coefficient(1000.0) - 0.23) < 1e-9);
+        CHECK(std::abs(drag_coefficient(15000.0) - 0.65) < 1e-9);
+
+        std::remove(("data/aero/" + id + ".aero").c_str());
+        std::cout << "Aero altitude axis: OK" << std::endl;
+    }
+
+    // A legacy profile has no sideslip axis: the airframe is axisymmetric, so turning the
+    // airflow from the pitch plane to the yaw plane turns the lift with it, at the same size.
+    void test_axisymmetric_sideslip() {
+        AtmosphereManager atmosphere;
+        const bool atmosphere_loaded = atmosphere.loadTable("data/atmosphere_table.bin");
+        CHECK(atmosphere_loaded);
+        JobSystem job_system;
+
+        auto run = [&](const glm::dvec3& velocity) {
+            Registry registry;
+            rigidBodyGroup(registry, Get<AerodynamicProfileComponent>{});
+            const Entity body = registry.create();
+            registry.add<TransformComponent>(body, TransformComponent{glm::dvec3(0.0, 1000.0, 0.0)});
+            registry.add<VelocityComponent>(body, VelocityComponent{velocity, glm::dvec3(0.0)});
+            registry.add<MassComponent>(body);
+            registry.add<ForceAccumulatorComponent>(body);
+            AerodynamicProfileComponent aero;
+            aero.profileID = "sa_missile_mk1_aero";
+            registry.add<AerodynamicProfileComponent>(body, aero);
+
+            AerodynamicsSystem system(atmosphere, job_system);
+            system.update(registry, 0.01);
+            return registry.get<ForceAccumulatorComponent>(body).getTotalForce();
+        };
+
+        // Nose 0.1 rad above the airflow, then 0.1 rad to the -X side of it.
+        const glm::dvec3 pitch = run(glm::dvec3(0.0, -250.0 * std::sin(0.1), 250.0 * std::cos(0.1)));
+        const glm::dvec3 yaw = run(glm::dvec3(250.0 * std::sin(0.1), 0.0, 250.0 * std::cos(0.1)));
+        const double scale = glm::length(pitch);
+        CHECK(pitch.y > 0.0 && std::abs(pitch.x) < 1e-9 * scale);
+        CHECK(glm::length(yaw - glm::dvec3(-pitch.y, pitch.x, pitch.z)) < 1e-9 * scale);
+
+        std::cout << "Axisymmetric sideslip: OK" << std::endl;
+    }
+
+    double seconds(auto&& body, int rounds) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            body();
+        }
+        return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    // Benchmarks the breakpoint search against the compiled 2-D table, and a 6-D table,
+    // single and batched.
+    void benchmark_aero_lookup() {
+        std::cout << "--- Running Aero Lookup Benchmark ---" << std::endl;
+        AerodynamicsDatabase db;
+        const bool loaded = db.loadProfile(PROFILE_PATH);
+        CHECK(loaded);
+        const ReferenceTable reference(PROFILE_PATH);
+        const std::vector<AeroFlightCondition> conditions = randomConditions(100000, 23);
+        std::vector<AeroCoefficients> out(conditions.size());
+        constexpr int rounds = 20;
+
+        const double searched = seconds([&] {
+            for (size_t i = 0; i < conditions.size(); ++i) {
+                out[i] = reference.lookup(conditions[i].mach, conditions[i].alpha_rad);
+            }
+        }, rounds);
+        const double indexed = seconds([&] {
+            for (size_t i = 0; i < conditions.size(); ++i) {
+                out[i] = db.getCoefficients(conditions[i]);
+            }
+        }, rounds);
+        const double batched = seconds([&] { db.getCoefficients(conditions, out); }, rounds);
+        std::cout << "2-D breakpoint search: " << searched << "s, uniform grid: " << indexed << "s, batched: "
+                  << batched << "s for " << rounds * conditions.size() << " lookups" << std::endl;
+
+        const MultilinearProfile profile(AERO_MAX_AXES);
+        const AeroTable table = compileAeroTable(profile.axes, profile.values);
+        std::mt19937 rng(25);
+        std::vector<AeroFlightCondition> wide(conditions.size());
+        for (AeroFlightCondition& condition : wide) {
+            condition = profile.random(rng);
+        }
+        const double single = seconds([&] {
+            for (size_t i = 0; i < wide.size(); ++i) {
+                out[i] = table.lookup(wide[i]);
+            }
+        }, rounds);
+        const double wide_batched = seconds([&] { table.lookup(wide, out); }, rounds);
+        std::cout << "6-D single: " << single << "s, batched: " << wide_batched << "s for "
+                  << rounds * wide.size() << " lookups" << std::endl;
+    }
+
+    // Benchmarks loading the shipped profile from JSON against mapping its compiled table.
+    void benchmark_profile_loading() {
+        constexpr int rounds = 40;
+        auto load = [](const std::string& path) {
+            AerodynamicsDatabase db;
+            const bool loaded = db.loadProfile(path);
+            CHECK(loaded);
+        };
+        const double parsed = seconds([&] { load(PROFILE_PATH); }, rounds);
+        const double mapped = seconds([&] { load("data/aero/sa_missile_mk1_aero.aero"); }, rounds);
+        std::cout << "Profile loading: JSON " << parsed << "s, mapped " << mapped << "s for " << rounds
+                  << " profiles" << std::endl;
+    }
+}
+
+int runAerodynamicsTests() {
+    const int failures = StrikeEngine::Test::checkFailures();
+    test_compiled_lookup();
+    test_inexact_resampling();
+    test_n_dimensional_table();
+    test_table_file();
+    test_shipped_profile();
+    test_deflection_forces();
+    test_altitude_axis();
+    test_axisymmetric_sideslip();
+    benchmark_aero_lookup();
+    benchmark_profile_loading();
+
+    std::cout << "\nAerodynamics tests completed successfully." << std::endl;
+    return StrikeEngine::Test::checkFailures() - failures;
+}
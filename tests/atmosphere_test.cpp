@@ -1,10 +1,309 @@
 #include "strikeengine/atmosphere/AtmosphereManager.hpp"
 #include "strikeengine/atmosphere/AtmosphereModel.hpp"
+#include "strikeengine/atmosphere/AtmosphereTable.hpp"
+#include "strikeengine/atmosphere/CompactAtmosphereTable.hpp"
+#include "TestCheck.hpp"
 #include <iostream>
 #include <chrono>
-#include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <stdexcept>
 #include <vector>
 
+namespace {
+    // The interpolation getProperties performed before the uniform-grid lookup: binary search.
+    StrikeEngine::AtmosphereProperties searchTable(const std::vector<StrikeEngine::AtmosphereProperties>& table, double altitude) {
+        if (altitude <= table.front().altitude) {
+            return table.front();
+        }
+        if (altitude >= table.back().altitude) {
+            return table.back();
+        }
+        const auto high = std::lower_bound(table.begin(), table.end(), altitude,
+            [](const StrikeEngine::AtmosphereProperties& p, double alt) { return p.altitude < alt; });
+        const auto low = high - 1;
+        const double fraction = (altitude - low->altitude) / (high->altitude - low->altitude);
+        return {altitude,
+                low->temperature + fraction * (high->temperature - low->temperature),
+                low->pressure + fraction * (high->pressure - low->pressure),
+                low->density + fraction * (high->density - low->density),
+                low->speedOfSound + fraction * (high->speedOfSound - low->speedOfSound)};
+    }
+
+    std::vector<StrikeEngine::AtmosphereProperties> readTable(const std::string& path) {
+        StrikeEngine::MappedFile file;
+        const bool opened = file.open(path);
+        CHECK(opened);
+        StrikeEngine::AtmosphereTableHeader header{};
+        const auto rows = StrikeEngine::readAtmosphereTable(file.bytes(), header);
+        return {rows.begin(), rows.end()};
+    }
+
+    std::vector<char> readBytes(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    void writeBytes(const std::string& path, const std::vector<char>& bytes) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    // Whether loading the file is rejected with an exception.
+    bool rejects(const std::string& path) {
+        StrikeEngine::AtmosphereManager manager;
+        try {
+            manager.loadTable(path);
+        } catch (const std::runtime_error&) {
+            return !manager.isLoaded();
+        }
+        return false;
+    }
+
+    bool close(double a, double b, double tolerance = 1e-12) {
+        return std::abs(a - b) <= tolerance * std::max(1.0, std::abs(b));
+    }
+
+    void assertClose(const StrikeEngine::AtmosphereProperties& actual, const StrikeEngine::AtmosphereProperties& expected,
+                     double tolerance = 1e-12) {
+        CHECK(close(actual.altitude, expected.altitude, tolerance));
+        CHECK(close(actual.temperature, expected.temperature, tolerance));
+        CHECK(close(actual.pressure, expected.pressure, tolerance));
+        CHECK(close(actual.density, expected.density, tolerance));
+        CHECK(close(actual.speedOfSound, expected.speedOfSound, tolerance));
+    }
+}
+
+// The uniform-grid lookup, single and batched, must match the binary search it replaced,
+// and a table with uneven spacing must still be searched.
+void test_uniform_lookup(const StrikeEngine::AtmosphereManager& manager, const std::string& tablePath) {
+    const auto table = readTable(tablePath);
+    CHECK(manager.isUniform());
+
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<double> altitude(-500.0, 90000.0);
+    std::vector<double> altitudes(1001);
+    for (double& a : altitudes) {
+        a = altitude(rng);
+    }
+    altitudes[0] = 0.0;
+    altitudes[1] = 86000.0;
+    altitudes[2] = 1234.0;
+    // NaN takes the first row, in a SIMD block and in the scalar tail.
+    altitudes[5] = std::numeric_limits<double>::quiet_NaN();
+    altitudes[1000] = std::numeric_limits<double>::quiet_NaN();
+
+    std::vector<StrikeEngine::AtmosphereProperties> batch(altitudes.size());
+    manager.getProperties(altitudes, batch);
+    for (size_t i = 0; i < altitudes.size(); ++i) {
+        const auto expected = std::isnan(altitudes[i]) ? table.front() : searchTable(table, altitudes[i]);
+        assertClose(manager.getProperties(altitudes[i]), expected);
+        assertClose(batch[i], expected);
+    }
+
+    // Drop every other row above 10 km: the spacing is no longer even.
+    const std::string unevenPath = "atmosphere_table_uneven.bin";
+    std::vector<StrikeEngine::AtmosphereProperties> uneven;
+    for (size_t i = 0; i < table.size(); ++i) {
+        if (i <= 10000 || i % 2 == 0) {
+            uneven.push_back(table[i]);
+        }
+    }
+    StrikeEngine::writeAtmosphereTable(unevenPath, uneven);
+    StrikeEngine::AtmosphereManager unevenManager;
+    const bool unevenLoaded = unevenManager.loadTable(unevenPath);
+    CHECK(unevenLoaded);
+    std::remove(unevenPath.c_str());
+    CHECK(!unevenManager.isUniform());
+    unevenManager.getProperties(altitudes, batch);
+    for (size_t i = 0; i < altitudes.size(); ++i) {
+        assertClose(batch[i], std::isnan(altitudes[i]) ? uneven.front() : searchTable(uneven, altitudes[i]));
+    }
+    std::cout << "Uniform-grid lookup: OK" << std::endl;
+}
+
+// A written table loads back with its rows intact, and a file with the wrong magic, version,
+// field layout, size or checksum is rejected rather than read as garbage.
+void test_table_format() {
+    using StrikeEngine::AtmosphereTableHeader;
+    const std::string path = "atmosphere_table_format.bin";
+    std::vector<StrikeEngine::AtmosphereProperties> rows;
+    for (int i = 0; i < 64; ++i) {
+        rows.push_back({100.0 * i, 288.15 - 0.65 * i, 101325.0 - 1200.0 * i, 1.225 - 0.011 * i, 340.3 - 0.4 * i});
+    }
+    StrikeEngine::writeAtmosphereTable(path, rows);
+    const std::vector<char> good = readBytes(path);
+    CHECK(good.size() == sizeof(AtmosphereTableHeader) + rows.size() * sizeof(rows[0]));
+
+    StrikeEngine::AtmosphereManager manager;
+    const bool opened = manager.loadTable(path);
+    CHECK(opened);
+    CHECK(manager.isUniform());
+    assertClose(manager.getProperties(150.0), searchTable(rows, 150.0));
+    const auto loaded = readTable(path);
+    CHECK(loaded.size() == rows.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        assertClose(loaded[i], rows[i]);
+    }
+
+    auto corrupt = [&](size_t offset) {
+        std::vector<char> bytes = good;
+        bytes[offset] ^= 0x5a;
+        writeBytes(path, bytes);
+        return rejects(path);
+    };
+    CHECK(corrupt(offsetof(AtmosphereTableHeader, magic)));
+    CHECK(corrupt(offsetof(AtmosphereTableHeader, version)));
+    CHECK(corrupt(offsetof(AtmosphereTableHeader, row_size)));
+    CHECK(corrupt(offsetof(AtmosphereTableHeader, fields) + 3));
+    CHECK(corrupt(sizeof(AtmosphereTableHeader) + 17 * sizeof(rows[0]) + 9)); // A row byte: checksum
+
+    std::vector<char> truncated(good.begin(), good.end() - sizeof(rows[0]));
+    writeBytes(path, truncated);
+    CHECK(rejects(path));
+    writeBytes(path, {good.begin(), good.begin() + 16});
+    CHECK(rejects(path));
+    std::remove(path.c_str());
+
+    const bool missingLoaded = manager.loadTable("atmosphere_table_missing.bin");
+    CHECK(!missingLoaded);
+    CHECK(!manager.isLoaded());
+
+    // The writer refuses rows that do not ascend in altitude.
+    rows.push_back(rows.back());
+    bool threw = false;
+    try {
+        StrikeEngine::writeAtmosphereTable(path, rows);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+    std::cout << "Atmosphere table format: OK" << std::endl;
+}
+
+// The float32 banded table must stay within a few parts per million of calculateAtmosphere
+// and small enough to live in L2. The layer definitions round their base pressures, so the
+// model jumps slightly at each layer base; no interpolated table can follow that within a row
+// of it, and those altitudes are left out.
+void test_compact_table(const StrikeEngine::AtmosphereManager& manager) {
+    const auto layers = StrikeEngine::loadAtmosphereLayers("data/config/atmosphere_layers.json");
+    const StrikeEngine::CompactAtmosphereTable& compact = manager.compactTable();
+    CHECK(!compact.empty());
+    CHECK(compact.sizeBytes() <= 64 * 1024);
+
+    // Built straight from the model over the same range: the same rows, sampled exactly.
+    const StrikeEngine::CompactAtmosphereTable direct(
+        [&](double altitude) { return StrikeEngine::calculateAtmosphere(altitude, layers); }, 0.0, 85999.0);
+    CHECK(direct.sizeBytes() == compact.sizeBytes());
+
+    auto nearLayerBase = [&](double altitude) {
+        return std::any_of(layers.begin() + 1, layers.end(),
+            [altitude](const StrikeEngine::AtmosphereLayer& layer) { return std::abs(altitude - layer.altitudeBase) < 50.0; });
+    };
+    auto relative = [](double actual, double expected) { return std::abs(actual - expected) / std::abs(expected); };
+    double worst[2][4] = {};
+    std::mt19937 rng(19);
+    std::uniform_real_distribution<double> altitude(0.0, 85999.0);
+    for (int i = 0; i < 200000; ++i) {
+        const double a = i < 2 ? 85999.0 * i : altitude(rng);
+        if (nearLayerBase(a)) {
+            continue;
+        }
+        const auto expected = StrikeEngine::calculateAtmosphere(a, layers);
+        double* band = worst[a < 20000.0 ? 0 : 1];
+        for (const StrikeEngine::CompactAtmosphereTable* table : {&compact, &direct}) {
+            const auto actual = table->getProperties(a);
+            CHECK(close(actual.altitude, a));
+            band[0] = std::max(band[0], relative(actual.temperature, expected.temperature));
+            band[1] = std::max(band[1], relative(actual.pressure, expected.pressure));
+            band[2] = std::max(band[2], relative(actual.density, expected.density));
+            band[3] = std::max(band[3], relative(actual.speedOfSound, expected.speedOfSound));
+        }
+    }
+    std::cout << "Compact table (" << compact.sizeBytes() << " bytes) worst relative error below / above 20 km:"
+              << " T " << worst[0][0] << " / " << worst[1][0] << ", p " << worst[0][1] << " / " << worst[1][1]
+              << ", rho " << worst[0][2] << " / " << worst[1][2] << ", a " << worst[0][3] << " / " << worst[1][3] << std::endl;
+    for (const double e : worst[0]) {
+        CHECK(e < 1e-6);
+    }
+    for (const double e : worst[1]) {
+        CHECK(e < 2e-5);
+    }
+
+    // Out-of-range altitudes clamp to the end rows, as the full table does.
+    assertClose(compact.getProperties(-100.0), compact.getProperties(0.0));
+    CHECK(close(compact.getProperties(1.0e6).pressure, manager.getProperties(1.0e6).pressure, 1e-6));
+    assertClose(compact.getProperties(std::numeric_limits<double>::quiet_NaN()), compact.getProperties(0.0));
+    std::cout << "Compact atmosphere table: OK" << std::endl;
+}
+
+// Benchmarks random-altitude lookups in the full double table against the compact one.
+void benchmark_compact_lookup(const StrikeEngine::AtmosphereManager& manager) {
+    std::cout << "--- Running Compact Lookup Benchmark ---" << std::endl;
+    constexpr int rounds = 100;
+    std::vector<double> altitudes(86001);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> altitude(0.0, 86000.0);
+    for (double& a : altitudes) {
+        a = altitude(rng);
+    }
+    const StrikeEngine::CompactAtmosphereTable& compact = manager.compactTable();
+
+    double sink = 0.0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (const double a : altitudes) {
+            sink += manager.getProperties(a).density;
+        }
+    }
+    const double full = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (const double a : altitudes) {
+            sink += compact.getProperties(a).density;
+        }
+    }
+    const double compacted = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    std::cout << "Full table: " << full << "s, compact table: " << compacted << "s for "
+              << rounds * altitudes.size() << " lookups (checksum " << sink << ")" << std::endl;
+}
+
+// Benchmarks per-altitude lookups against the batched lookup over the same altitudes.
+void benchmark_batch_lookup(const StrikeEngine::AtmosphereManager& manager) {
+    std::cout << "--- Running Batched Lookup Benchmark ---" << std::endl;
+    constexpr int rounds = 100;
+    std::vector<double> altitudes(86001);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> altitude(0.0, 86000.0);
+    for (double& a : altitudes) {
+        a = altitude(rng);
+    }
+    std::vector<StrikeEngine::AtmosphereProperties> out(altitudes.size());
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        for (size_t i = 0; i < altitudes.size(); ++i) {
+            out[i] = manager.getProperties(altitudes[i]);
+        }
+    }
+    const double single = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int round = 0; round < rounds; ++round) {
+        manager.getProperties(altitudes, out);
+    }
+    const double batched = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    std::cout << "Single lookups: " << single << "s, batched: " << batched << "s for "
+              << rounds * altitudes.size() << " lookups" << std::endl;
+}
+
 // Benchmarks the performance of the table lookup method using the AtmosphereManager.
 void benchmark_lookup(const StrikeEngine::AtmosphereManager& manager) {
     std::cout << "--- Running Lookup Benchmark ---" << std::endl;
@@ -40,7 +339,8 @@ void benchmark_calculation() {
     std::cout << "Calculation Time: " << duration << "s for " << steps + 1 << " steps" << std::endl;
 }
 
-int main() {
+int runAtmosphereTests() {
+    const int failures = StrikeEngine::Test::checkFailures();
     StrikeEngine::AtmosphereManager atmosphereManager;
     const std::string tablePath = "data/atmosphere_table.bin";
 
@@ -50,12 +350,17 @@ int main() {
         std::cerr << "Please run the GenerateAtmosphereTable tool first." << std::endl;
         return 1;
     }
-    assert(atmosphereManager.isLoaded());
+    CHECK(atmosphereManager.isLoaded());
     std::cout << "Table loaded successfully." << std::endl;
 
+    test_table_format();
+    test_uniform_lookup(atmosphereManager, tablePath);
+    test_compact_table(atmosphereManager);
     benchmark_lookup(atmosphereManager);
+    benchmark_batch_lookup(atmosphereManager);
+    benchmark_compact_lookup(atmosphereManager);
     benchmark_calculation();
 
     std::cout << "\nAtmosphere benchmarks completed successfully." << std::endl;
-    return 0;
+    return StrikeEngine::Test::checkFailures() - failures;
 }
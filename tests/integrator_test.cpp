@@ -0,0 +1,262 @@
+#include "strikeengine/ecs/Registry.hpp"
+#include "strikeengine/core/JobSystem.hpp"
+#include "strikeengine/components/physics/InertiaComponent.hpp"
+#include "strikeengine/components/physics/AdaptiveStepComponent.hpp"
+#include "strikeengine/systems/physics/RigidBodyGroup.hpp"
+#include "strikeengine/systems/physics/RigidBodyIntegrator.hpp"
+#include "strikeengine/systems/physics/GravitySystem.hpp"
+#include "strikeengine/systems/physics/IntegrationSystem.hpp"
+#include "TestCheck.hpp"
+#include <glm/gtc/quaternion.hpp>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <numbers>
+
+using namespace StrikeEngine;
+
+namespace {
+    void setBody(RigidBodyBatch& batch, size_t i, const glm::dvec3& position, const glm::dvec3& velocity,
+                 const glm::dvec3& angularVelocity, const glm::dmat3& inertia) {
+        batch.setState(i, position, velocity, glm::dquat(1.0, 0.0, 0.0, 0.0), angularVelocity);
+        batch.setMassProperties(i, 2.0, 0.5, inertia, glm::inverse(inertia));
+    }
+
+    // A constant force gives a parabola, which RK4 reproduces exactly.
+    void test_constant_force() {
+        RigidBodyBatch batch;
+        batch.resize(3);
+        for (size_t i = 0; i < 3; ++i) {
+            setBody(batch, i, glm::dvec3(static_cast<double>(i)), glm::dvec3(1.0, 0.0, -2.0), glm::dvec3(0.0), glm::dmat3(1.0));
+        }
+        const glm::dvec3 force(4.0, -9.0, 1.0);
+        RigidBodyIntegrator integrator;
+        for (int step = 0; step < 10; ++step) {
+            integrator.stepRK4(batch, 0.5, [&](RigidBodyBatch& stage) {
+                for (size_t i = 0; i < stage.size(); ++i) {
+                    stage.setForce(i, force, glm::dvec3(0.0));
+                }
+            });
+        }
+        const double t = 5.0;
+        for (size_t i = 0; i < 3; ++i) {
+            const glm::dvec3 expected = glm::dvec3(static_cast<double>(i)) + glm::dvec3(1.0, 0.0, -2.0) * t + 0.25 * force * t * t;
+            CHECK(glm::length(batch.position(i) - expected) < 1e-9);
+            CHECK(glm::length(batch.velocity(i) - (glm::dvec3(1.0, 0.0, -2.0) + 0.5 * force * t)) < 1e-12);
+        }
+        std::cout << "RK4 constant force: OK" << std::endl;
+    }
+
+    // A spring force re-evaluated at every stage: the global error falls 16-fold when dt halves.
+    double oscillatorError(double dt) {
+        RigidBodyBatch batch;
+        batch.resize(1);
+        setBody(batch, 0, glm::dvec3(1.0, 0.0, 0.0), glm::dvec3(0.0), glm::dvec3(0.0), glm::dmat3(1.0));
+        RigidBodyIntegrator integrator;
+        const double stiffness = 2.0; // omega = 1 rad/s with the 2 kg mass
+        const int steps = static_cast<int>(std::round(6.4 / dt));
+        for (int step = 0; step < steps; ++step) {
+            integrator.stepRK4(batch, dt, [&](RigidBodyBatch& stage) {
+                stage.setForce(0, -stiffness * stage.position(0), glm::dvec3(0.0));
+            });
+        }
+        const double t = steps * dt;
+        return std::hypot(batch.position(0).x - std::cos(t), batch.velocity(0).x + std::sin(t));
+    }
+
+    void test_convergence_order() {
+        const double coarse = oscillatorError(0.2);
+        const double fine = oscillatorError(0.1);
+        const double ratio = coarse / fine;
+        CHECK(ratio > 12.0 && ratio < 20.0);
+        std::cout << "RK4 convergence: OK (error ratio " << ratio << " for dt/2)" << std::endl;
+    }
+
+    // A torque-free asymmetric body conserves kinetic energy and world angular momentum, and an
+    // axisymmetric body spinning about its axis turns at exactly its spin rate.
+    void test_torque_free_rotation() {
+        glm::dmat3 inertia(1.0);
+        inertia[1][1] = 2.0;
+        inertia[2][2] = 3.0;
+        RigidBodyBatch batch;
+        batch.resize(2);
+        setBody(batch, 0, glm::dvec3(0.0), glm::dvec3(0.0), glm::dvec3(0.1, 2.0, 0.1), inertia);
+        setBody(batch, 1, glm::dvec3(0.0), glm::dvec3(0.0), glm::dvec3(0.0, 0.0, 1.5), inertia);
+
+        const auto energy = [&](size_t i) {
+            const glm::dvec3 w = batch.angularVelocity(i);
+            return 0.5 * glm::dot(w, inertia * w);
+        };
+        const auto momentum = [&](size_t i) { return batch.orientation(i) * (inertia * batch.angularVelocity(i)); };
+        const double energy0 = energy(0);
+        const glm::dvec3 momentum0 = momentum(0);
+
+        RigidBodyIntegrator integrator;
+        const double dt = 0.01;
+        const int steps = 2000;
+        for (int step = 0; step < steps; ++step) {
+            integrator.stepRK4(batch, dt, [](RigidBodyBatch& stage) {
+                for (size_t i = 0; i < stage.size(); ++i) {
+                    stage.setForce(i, glm::dvec3(0.0), glm::dvec3(0.0));
+                }
+            });
+        }
+        CHECK(std::abs(energy(0) - energy0) < 1e-8 * energy0);
+        CHECK(glm::length(momentum(0) - momentum0) < 1e-7 * glm::length(momentum0));
+
+        const glm::dquat expected = glm::angleAxis(1.5 * dt * steps, glm::dvec3(0.0, 0.0, 1.0));
+        CHECK(std::abs(std::abs(glm::dot(batch.orientation(1), expected)) - 1.0) < 1e-12);
+        std::cout << "RK4 torque-free rotation: OK" << std::endl;
+    }
+
+    // A world torque is applied in the body frame: a body rolled 90 degrees about X sees a world
+    // Y torque about its body Z axis.
+    void test_world_torque() {
+        RigidBodyBatch batch;
+        batch.resize(1);
+        const glm::dquat rolled = glm::angleAxis(std::numbers::pi / 2.0, glm::dvec3(1.0, 0.0, 0.0));
+        batch.setState(0, glm::dvec3(0.0), glm::dvec3(0.0), rolled, glm::dvec3(0.0));
+        batch.setMassProperties(0, 1.0, 1.0, glm::dmat3(1.0), glm::dmat3(1.0));
+        batch.setForce(0, glm::dvec3(0.0), glm::dvec3(0.0, 3.0, 0.0));
+
+        double derivative[RigidBodyBatch::STATE_LANES * 8];
+        RigidBodyIntegrator::derivative(batch, derivative);
+        const size_t stride = batch.stride();
+        CHECK(std::abs(derivative[RigidBodyBatch::ANGULAR_VELOCITY * stride]) < 1e-12);
+        CHECK(std::abs(derivative[(RigidBodyBatch::ANGULAR_VELOCITY + 1) * stride]) < 1e-12);
+        CHECK(std::abs(derivative[(RigidBodyBatch::ANGULAR_VELOCITY + 2) * stride] + 3.0) < 1e-12);
+        std::cout << "RK4 world torque: OK" << std::endl;
+    }
+
+    // Two springs in one batch, one twenty times faster: each body sub-steps only as finely as
+    // its own error needs, both stay within tolerance, and the step history carries over.
+    void test_adaptive_per_body_steps() {
+        RigidBodyBatch batch;
+        batch.resize(2);
+        setBody(batch, 0, glm::dvec3(1.0, 0.0, 0.0), glm::dvec3(0.0), glm::dvec3(0.0), glm::dmat3(1.0));
+        setBody(batch, 1, glm::dvec3(1.0, 0.0, 0.0), glm::dvec3(0.0), glm::dvec3(0.0), glm::dmat3(1.0));
+        batch.lane(RigidBodyBatch::STEP)[0] = 0.0;
+        batch.lane(RigidBodyBatch::STEP)[1] = 0.0;
+        const double omega[2] = {1.0, 20.0};
+        const auto springs = [&](RigidBodyBatch& stage) {
+            for (size_t i = 0; i < stage.size(); ++i) {
+                const size_t body = static_cast<size_t>(stage.lane(RigidBodyBatch::BODY)[i]);
+                const double stiffness = 2.0 * omega[body] * omega[body]; // 2 kg bodies
+                stage.setForce(i, -stiffness * stage.position(i), glm::dvec3(0.0));
+            }
+        };
+
+        AdaptiveStepControl control;
+        control.relative_tolerance = 1e-9;
+        control.position_tolerance_m = 1e-9;
+        control.velocity_tolerance_mps = 1e-9;
+        RigidBodyIntegrator integrator;
+        uint32_t accepted[2] = {};
+        uint32_t first_frame_rejections = 0;
+        const double frame = 0.5;
+        for (int f = 0; f < 4; ++f) {
+            integrator.integrateAdaptive(batch, frame, springs, control);
+            for (size_t i = 0; i < 2; ++i) {
+                accepted[i] += integrator.acceptedSteps(i);
+                CHECK(batch.lane(RigidBodyBatch::STEP)[i] > 0.0);
+            }
+            if (f == 0) {
+                first_frame_rejections = integrator.rejectedSteps(0) + integrator.rejectedSteps(1);
+            } else {
+                // The step history means later frames no longer start from a whole-frame guess.
+                CHECK(integrator.rejectedSteps(0) + integrator.rejectedSteps(1) < first_frame_rejections);
+            }
+        }
+        const double t = 4 * frame;
+        for (size_t i = 0; i < 2; ++i) {
+            CHECK(std::abs(batch.position(i).x - std::cos(omega[i] * t)) < 1e-6);
+            CHECK(std::abs(batch.velocity(i).x + omega[i] * std::sin(omega[i] * t)) < 1e-5 * omega[i]);
+        }
+        CHECK(accepted[1] > 5 * accepted[0]);
+        std::cout << "Dormand-Prince per-body steps: OK (" << accepted[0] << " and " << accepted[1]
+                  << " sub-steps for the slow and fast body)" << std::endl;
+    }
+
+    // A single NaN force evaluation mid-step: the step is rejected and retried rather than
+    // accepted with a NaN error estimate, and the body ends on the constant-force parabola.
+    void test_adaptive_rejects_nan() {
+        RigidBodyBatch batch;
+        batch.resize(1);
+        setBody(batch, 0, glm::dvec3(0.0), glm::dvec3(1.0, 0.0, 0.0), glm::dvec3(0.0), glm::dmat3(1.0));
+        const glm::dvec3 force(0.0, -4.0, 0.0);
+        bool glitched = false;
+        const auto glitch = [&](RigidBodyBatch& stage) {
+            const bool nan = !glitched && stage.lane(RigidBodyBatch::TIME)[0] > 0.0;
+            glitched = glitched || nan;
+            stage.setForce(0, nan ? glm::dvec3(std::numeric_limits<double>::quiet_NaN()) : force, glm::dvec3(0.0));
+        };
+
+        RigidBodyIntegrator integrator;
+        integrator.integrateAdaptive(batch, 1.0, glitch, AdaptiveStepControl{});
+        CHECK(glitched);
+        CHECK(integrator.rejectedSteps(0) > 0);
+        const glm::dvec3 expected = glm::dvec3(1.0, 0.0, 0.0) + 0.25 * force;
+        CHECK(glm::length(batch.position(0) - expected) < 1e-9);
+        CHECK(glm::length(batch.velocity(0) - (glm::dvec3(1.0, 0.0, 0.0) + 0.5 * force)) < 1e-9);
+        std::cout << "Dormand-Prince NaN rejection: OK" << std::endl;
+    }
+
+    // Radial drift over one circular orbit, stepping GravitySystem and IntegrationSystem as the
+    // engine does. Returns the largest deviation from the initial radius.
+    double orbitDrift(JobSystem& job_system, double dt, bool restageGravity, bool adaptive = false) {
+        const GravityModel model;
+        Registry registry;
+        const double radius = 7.0e6;
+        const Entity body = registry.create();
+        registry.add<TransformComponent>(body, TransformComponent{glm::dvec3(radius, 0.0, 0.0)});
+        registry.add<VelocityComponent>(body, VelocityComponent{glm::dvec3(0.0, 0.0, std::sqrt(model.mu / radius)), glm::dvec3(0.0)});
+        registry.add<MassComponent>(body, MassComponent{500.0, 500.0, 500.0, 1.0 / 500.0});
+        registry.add<ForceAccumulatorComponent>(body);
+        registry.add<InertiaComponent>(body);
+        if (adaptive) {
+            registry.add<AdaptiveStepComponent>(body);
+        }
+        rigidBodyGroup(registry);
+
+        GravitySystem gravity_system(job_system, model);
+        IntegrationSystem integration_system(job_system, restageGravity ? std::optional(model) : std::nullopt);
+        const double period = 2.0 * std::numbers::pi * std::sqrt(radius * radius * radius / model.mu);
+        double drift = 0.0;
+        for (double t = 0.0; t < period; t += dt) {
+            gravity_system.update(registry, dt);
+            integration_system.update(registry, dt);
+            const TransformComponent& transform = registry.get<TransformComponent>(body);
+            drift = std::max(drift, std::abs(glm::length(transform.position) - radius));
+        }
+        return drift;
+    }
+
+    void test_orbit_accuracy() {
+        JobSystem job_system;
+        const double staged = orbitDrift(job_system, 10.0, true);
+        const double held = orbitDrift(job_system, 10.0, false);
+        CHECK(staged < 1.0);
+        CHECK(held > 100.0 * staged);
+
+        // A 60 s frame is far too coarse for one RK4 step, but the adaptive body sub-steps.
+        const double adaptive = orbitDrift(job_system, 60.0, true, true);
+        CHECK(adaptive < 1.0);
+        std::cout << "Orbit accuracy: OK (radial drift over one orbit at dt = 10 s: " << staged
+                  << " m with gravity re-evaluated per stage, " << held << " m held; " << adaptive
+                  << " m adaptive at dt = 60 s)" << std::endl;
+    }
+}
+
+int runIntegratorTests() {
+    const int failures = StrikeEngine::Test::checkFailures();
+    std::cout << "\n--- Running Integrator Tests ---" << std::endl;
+    test_constant_force();
+    test_convergence_order();
+    test_torque_free_rotation();
+    test_world_torque();
+    test_adaptive_per_body_steps();
+    test_adaptive_rejects_nan();
+    test_orbit_accuracy();
+    std::cout << "\nIntegrator tests completed successfully." << std::endl;
+    return StrikeEngine::Test::checkFailures() - failures;
+}
@@ -0,0 +1,427 @@
+#include "strikeengine/ecs/Registry.hpp"
+#include "strikeengine/components/transform/TransformComponent.hpp"
+#include "strikeengine/components/physics/VelocityComponent.hpp"
+#include "strikeengine/components/physics/MassComponent.hpp"
+#include "strikeengine/components/physics/InertiaComponent.hpp"
+#include "strikeengine/components/physics/ForceAccumulatorComponent.hpp"
+#include "strikeengine/systems/physics/IntegrationSystem.hpp"
+#include "strikeengine/systems/physics/RigidBodyGroup.hpp"
+#include "strikeengine/systems/physics/GravitySystem.hpp"
+#include "strikeengine/systems/physics/GravityKernel.hpp"
+#include "TestCheck.hpp"
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <vector>
+#include <atomic>
+#include <utility>
+#include <type_traits>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    using namespace StrikeEngine;
+
+    // The physics hot path relies on its components being plain data: no vptr in the dense
+    // arrays, and relocation inside the pools is a memcpy.
+    static_assert(std::is_trivially_copyable_v<TransformComponent>);
+    static_assert(std::is_trivially_copyable_v<VelocityComponent>);
+    static_assert(std::is_trivially_copyable_v<MassComponent>);
+    static_assert(std::is_trivially_copyable_v<InertiaComponent>);
+    static_assert(std::is_trivially_copyable_v<ForceAccumulatorComponent>);
+    static_assert(sizeof(VelocityComponent) == 2 * sizeof(glm::dvec3));
+
+    constexpr int BODY_COUNT = 10000;
+    constexpr int FRAMES = 200;
+    constexpr double DT = 0.001;
+
+    // Builds a registry whose physics pools are interleaved with unrelated entities and
+    // filled in a shuffled order, the way a scenario with debris and decoys looks.
+    void populate(Registry& registry) {
+        std::mt19937 rng(42);
+        std::vector<Entity> bodies;
+        for (int i = 0; i < BODY_COUNT; ++i) {
+            Entity entity = registry.create();
+            registry.add<TransformComponent>(entity);
+            if (rng() % 4 == 0) {
+                continue; // Transform-only entity (e.g. a chaff cloud)
+            }
+            bodies.push_back(entity);
+        }
+        std::ranges::shuffle(bodies, rng);
+        for (Entity entity : bodies) {
+            registry.add<VelocityComponent>(entity, glm::dvec3(100.0, 0.0, 0.0), glm::dvec3(0.0));
+        }
+        std::ranges::shuffle(bodies, rng);
+        for (Entity entity : bodies) {
+            registry.add<ForceAccumulatorComponent>(entity, glm::dvec3(0.0, -9.81, 0.0), glm::dvec3(0.0));
+            registry.add<MassComponent>(entity);
+            registry.add<InertiaComponent>(entity);
+        }
+    }
+
+    void integrateBody(TransformComponent& transform, ComponentRef<VelocityComponent> velocity, const MassComponent& mass,
+                       ComponentRef<const ForceAccumulatorComponent> accumulator) {
+        velocity.addLinear(accumulator.getTotalForce() * mass.inverseMass * DT);
+        transform.position += velocity.getLinear() * DT;
+    }
+
+    // Every member must sit at the same dense index in all owned pools, and the group must
+    // hold exactly the entities a view over the same components finds.
+    using RigidBodyGroup = decltype(rigidBodyGroup(std::declval<Registry&>()));
+
+    void assertGroupAligned(Registry& registry, const RigidBodyGroup& group) {
+        size_t view_count = 0;
+        registry.view<TransformComponent, VelocityComponent, MassComponent, ForceAccumulatorComponent>().each(
+            [&](TransformComponent&, ComponentRef<VelocityComponent>, MassComponent&,
+                ComponentRef<ForceAccumulatorComponent>) { ++view_count; });
+        CHECK(view_count == group.size());
+
+        for (size_t i = 0; i < group.size(); ++i) {
+            const Entity entity = group.entities()[i];
+            CHECK(&registry.get<TransformComponent>(entity) == group.data<TransformComponent>() + i);
+            CHECK(&registry.get<MassComponent>(entity) == group.data<MassComponent>() + i);
+            // SoA components: every lane of the entity sits at index i of that lane's array.
+            for (size_t lane = 0; lane < SoALayout<VelocityComponent>::LANES; ++lane) {
+                CHECK(&registry.get<VelocityComponent>(entity).lane(lane) == group.data<VelocityComponent>().lane(lane) + i);
+            }
+            for (size_t lane = 0; lane < SoALayout<ForceAccumulatorComponent>::LANES; ++lane) {
+                CHECK(&registry.get<ForceAccumulatorComponent>(entity).lane(lane) ==
+                       group.data<ForceAccumulatorComponent>().lane(lane) + i);
+            }
+        }
+    }
+
+    // The group must keep every member at the same dense index in all owned pools.
+    void test_group_alignment() {
+        Registry registry;
+        populate(registry);
+        auto group = rigidBodyGroup(registry);
+
+        std::mt19937 rng(7);
+        for (int i = 0; i < BODY_COUNT / 10; ++i) {
+            registry.destroy(group.entities()[rng() % group.size()]);
+        }
+
+        assertGroupAligned(registry, group);
+        std::cout << "Group alignment: OK (" << group.size() << " bodies)" << std::endl;
+    }
+
+    // Parallel iteration must visit every match exactly once and agree with the serial sweep.
+    void test_parallel_each() {
+        JobSystem job_system;
+        Registry serial_registry;
+        Registry parallel_registry;
+        populate(serial_registry);
+        populate(parallel_registry);
+
+        auto serial_group = rigidBodyGroup(serial_registry);
+        auto parallel_group = rigidBodyGroup(parallel_registry);
+        for (int frame = 0; frame < 10; ++frame) {
+            serial_group.each(integrateBody);
+            parallel_group.parallelEach(job_system, 64, integrateBody);
+        }
+        CHECK(serial_group.size() == parallel_group.size());
+        for (size_t i = 0; i < serial_group.size(); ++i) {
+            CHECK(serial_group.entities()[i] == parallel_group.entities()[i]);
+            CHECK(serial_group.data<TransformComponent>()[i].position ==
+                   parallel_group.data<TransformComponent>()[i].position);
+        }
+
+        std::atomic<size_t> visited = 0;
+        parallel_registry.view<const VelocityComponent, const TransformComponent>().parallelEach(
+            job_system, 100, [&](ComponentRef<const VelocityComponent>, const TransformComponent&) { visited.fetch_add(1); });
+        CHECK(visited == parallel_group.size());
+        std::cout << "Parallel each: OK (" << visited << " bodies)" << std::endl;
+    }
+
+    // SoA components must round-trip through their proxies and keep every lane SIMD-aligned.
+    void test_soa_storage() {
+        Registry registry;
+        std::vector<Entity> entities;
+        for (int i = 0; i < 1000; ++i) {
+            const Entity entity = registry.create();
+            registry.add<VelocityComponent>(entity, glm::dvec3(i, 2.0 * i, 3.0 * i), glm::dvec3(-i));
+            entities.push_back(entity);
+        }
+        for (size_t i = 0; i < entities.size(); i += 3) {
+            registry.destroy(entities[i]);
+        }
+
+        for (size_t i = 0; i < entities.size(); ++i) {
+            if (i % 3 == 0) {
+                CHECK(!registry.has<VelocityComponent>(entities[i]));
+                continue;
+            }
+            auto velocity = registry.get<VelocityComponent>(entities[i]);
+            CHECK(velocity.getLinear() == glm::dvec3(i, 2.0 * i, 3.0 * i));
+            CHECK(velocity.getAngular() == glm::dvec3(-static_cast<double>(i)));
+            velocity.addLinear(glm::dvec3(1.0));
+            const VelocityComponent copy = registry.get<VelocityComponent>(entities[i]);
+            CHECK(copy.getLinear() == glm::dvec3(i + 1.0, 2.0 * i + 1.0, 3.0 * i + 1.0));
+        }
+
+        auto group = registry.group<VelocityComponent>();
+        for (size_t lane = 0; lane < SoALayout<VelocityComponent>::LANES; ++lane) {
+            CHECK(reinterpret_cast<uintptr_t>(group.data<VelocityComponent>().lane(lane)) % 64 == 0);
+        }
+        std::cout << "SoA storage: OK (" << group.size() << " velocities)" << std::endl;
+    }
+
+    // Structural changes recorded from parallel chunks must only land at the flush, and must
+    // leave the group packed.
+    void test_deferred_commands() {
+        JobSystem job_system;
+        Registry registry;
+        populate(registry);
+        auto group = rigidBodyGroup(registry);
+        const size_t initial_size = group.size();
+
+        // Each body is destroyed, loses its velocity, or spawns a debris body.
+        std::atomic<size_t> destroyed = 0;
+        std::atomic<size_t> stripped = 0;
+        std::atomic<size_t> spawned = 0;
+        group.parallelEach(job_system, 64, [&](Entity entity, TransformComponent& transform, ComponentRef<VelocityComponent>,
+                                               MassComponent&, ComponentRef<ForceAccumulatorComponent>) {
+            CommandBuffer& commands = registry.commands();
+            switch (entity.index() % 3) {
+                case 0:
+                    commands.destroy(entity);
+                    destroyed.fetch_add(1);
+                    break;
+                case 1:
+                    commands.remove<VelocityComponent>(entity);
+                    stripped.fetch_add(1);
+                    break;
+                default: {
+                    const Entity debris = commands.create();
+                    commands.add<TransformComponent>(debris, transform);
+                    commands.add<VelocityComponent>(debris, glm::dvec3(0.0, 10.0, 0.0), glm::dvec3(0.0));
+                    commands.add<MassComponent>(debris);
+                    commands.add<ForceAccumulatorComponent>(debris);
+                    spawned.fetch_add(1);
+                }
+            }
+        });
+        CHECK(group.size() == initial_size);
+
+        registry.flushCommands();
+        CHECK(group.size() == initial_size - destroyed - stripped + spawned);
+        assertGroupAligned(registry, group);
+        std::cout << "Deferred commands: OK (" << destroyed << " destroyed, " << stripped << " stripped, "
+                  << spawned << " spawned)" << std::endl;
+    }
+
+    // Entities reserved by a command buffer stay dead until the flush, whether their index is
+    // recycled from a destroyed entity or new; direct creates in between do not revive them.
+    void test_reserved_entities() {
+        Registry registry;
+        const Entity destroyed = registry.create();
+        registry.destroy(destroyed);
+
+        CommandBuffer& commands = registry.commands();
+        const Entity recycled = commands.create();
+        const Entity fresh = commands.create();
+        commands.add<MassComponent>(recycled);
+        CHECK(recycled.index() == destroyed.index() && recycled != destroyed);
+        CHECK(!registry.isAlive(recycled) && !registry.isAlive(fresh));
+
+        const Entity direct = registry.create();
+        CHECK(registry.isAlive(direct));
+        CHECK(!registry.isAlive(recycled) && !registry.isAlive(fresh));
+
+        registry.flushCommands();
+        CHECK(registry.isAlive(recycled) && registry.isAlive(fresh) && registry.isAlive(direct));
+        CHECK(!registry.isAlive(destroyed));
+        CHECK(registry.has<MassComponent>(recycled) && !registry.has<MassComponent>(fresh));
+        std::cout << "Reserved entities: OK" << std::endl;
+    }
+
+    // SoA inputs for the gravity kernel: bodies scattered between the surface and 2000 km up.
+    struct GravityInputs {
+        std::vector<double> x, y, z, mass, fx, fy, fz;
+
+        explicit GravityInputs(size_t count) : x(count), y(count), z(count), mass(count), fx(count), fy(count), fz(count) {
+            std::mt19937 rng(3);
+            std::uniform_real_distribution<double> unit(-1.0, 1.0);
+            std::uniform_real_distribution<double> radius(6.371e6, 8.371e6);
+            for (size_t i = 0; i < count; ++i) {
+                const glm::dvec3 position = glm::normalize(glm::dvec3(unit(rng), unit(rng), unit(rng))) * radius(rng);
+                x[i] = position.x;
+                y[i] = position.y;
+                z[i] = position.z;
+                mass[i] = 100.0 + 900.0 * std::abs(unit(rng));
+            }
+        }
+
+        GravityBatch batch() {
+            std::ranges::fill(fx, 0.0);
+            std::ranges::fill(fy, 0.0);
+            std::ranges::fill(fz, 0.0);
+            return {x.data(), y.data(), z.data(), mass.data(), fx.data(), fy.data(), fz.data(), x.size()};
+        }
+    };
+
+    // The per-entity point-mass loop GravitySystem used before the batched kernel.
+    glm::dvec3 pointMassGravity(const glm::dvec3& position, double mass, double mu) {
+        const double distance_from_center = glm::length(position);
+        const double force_magnitude = mu * mass / (distance_from_center * distance_from_center);
+        return -glm::normalize(position) * force_magnitude;
+    }
+
+    // Every SIMD level must match the scalar reference, and J2 must reproduce the textbook
+    // equatorial and polar surface accelerations.
+    void test_gravity_kernel() {
+        GravityModel model;
+        GravityInputs inputs(1003); // Not a multiple of the SIMD width, so the tail is exercised
+        inputs.x[5] = inputs.y[5] = inputs.z[5] = 0.0; // At the centre: no force
+
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2, SimdLevel::AVX512}) {
+            accumulateGravity(model, inputs.batch(), level);
+            for (size_t i = 0; i < inputs.x.size(); ++i) {
+                const glm::dvec3 force(inputs.fx[i], inputs.fy[i], inputs.fz[i]);
+                if (i == 5) {
+                    CHECK(force == glm::dvec3(0.0));
+                    continue;
+                }
+                const glm::dvec3 expected =
+                    pointMassGravity(glm::dvec3(inputs.x[i], inputs.y[i], inputs.z[i]), inputs.mass[i], model.mu);
+                CHECK(glm::length(force - expected) <= 1e-12 * glm::length(expected));
+            }
+        }
+
+        model.j2_enabled = true;
+        const double re = model.equatorial_radius_m;
+        const double g0 = model.mu / (re * re);
+        double x[2] = {re, 0.0}; // Equator, then pole (the polar axis is Y)
+        double y[2] = {0.0, re};
+        double z[2] = {0.0, 0.0};
+        double mass[2] = {1.0, 1.0};
+        double fx[2] = {}, fy[2] = {}, fz[2] = {};
+        accumulateGravity(model, {x, y, z, mass, fx, fy, fz, 2});
+        CHECK(std::abs(-fx[0] - g0 * (1.0 + 1.5 * model.j2)) < 1e-9 && fy[0] == 0.0);
+        CHECK(std::abs(-fy[1] - g0 * (1.0 - 3.0 * model.j2)) < 1e-9 && fx[1] == 0.0);
+
+#ifdef STRIKEENGINE_CHECK_SYSTEM_ACCESS
+        // GravitySystem sweeps the rigid-body group without declaring a read of the velocities.
+        Registry registry;
+        populate(registry);
+        rigidBodyGroup(registry);
+        JobSystem job_system(1);
+        const SystemAccess access = SystemAccess::of<GravitySystem>();
+        SystemAccess::Scope scope(access);
+        bool threw = false;
+        try {
+            GravitySystem(job_system).update(registry, DT);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        CHECK(!threw);
+#endif
+        std::cout << "Gravity kernel: OK (best SIMD level " << static_cast<int>(detectSimdLevel()) << ")" << std::endl;
+    }
+
+    // Entities per second: the old per-entity loop against the batched kernel at each SIMD
+    // level, and the whole GravitySystem (tile gather + kernel) on the rigid-body group.
+    void benchmark_gravity() {
+        std::cout << "--- Running Gravity Benchmark ---" << std::endl;
+        constexpr int ROUNDS = 200;
+        const GravityModel model;
+        GravityInputs inputs(BODY_COUNT);
+        const auto report = [](const char* name, double seconds) {
+            std::cout << name << ": " << (static_cast<double>(BODY_COUNT) * ROUNDS / seconds) / 1e6
+                      << " M entities/s" << std::endl;
+        };
+
+        GravityBatch batch = inputs.batch();
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int round = 0; round < ROUNDS; ++round) {
+            for (size_t i = 0; i < batch.count; ++i) {
+                const glm::dvec3 force = pointMassGravity(glm::dvec3(batch.x[i], batch.y[i], batch.z[i]), batch.mass[i], model.mu);
+                batch.fx[i] += force.x;
+                batch.fy[i] += force.y;
+                batch.fz[i] += force.z;
+            }
+        }
+        report("Per-entity loop", std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count());
+
+        for (auto [level, name] : {std::pair{SimdLevel::Scalar, "Kernel (scalar)"}, std::pair{SimdLevel::AVX2, "Kernel (AVX2)"},
+                                   std::pair{SimdLevel::AVX512, "Kernel (AVX-512)"}}) {
+            if (level > detectSimdLevel()) {
+                continue;
+            }
+            batch = inputs.batch();
+            start = std::chrono::high_resolution_clock::now();
+            for (int round = 0; round < ROUNDS; ++round) {
+                accumulateGravity(model, batch, level);
+            }
+            report(name, std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count());
+        }
+
+        Registry registry;
+        populate(registry);
+        rigidBodyGroup(registry);
+        JobSystem job_system;
+        GravitySystem gravity_system(job_system);
+        start = std::chrono::high_resolution_clock::now();
+        for (int round = 0; round < ROUNDS; ++round) {
+            gravity_system.update(registry, DT);
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        std::cout << "GravitySystem (group): " << (static_cast<double>(rigidBodyGroup(registry).size()) * ROUNDS / seconds) / 1e6
+                  << " M entities/s" << std::endl;
+    }
+
+    // Benchmarks the integration sweep through a view against the same sweep through the owning group.
+    void benchmark_view_vs_group() {
+        std::cout << "--- Running View vs Group Integration Benchmark ---" << std::endl;
+        Registry view_registry;
+        populate(view_registry);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            view_registry.view<TransformComponent, VelocityComponent, MassComponent, ForceAccumulatorComponent>().each(
+                integrateBody);
+        }
+        const auto view_time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+        Registry group_registry;
+        populate(group_registry);
+        auto group = rigidBodyGroup(group_registry);
+
+        start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            group.each(integrateBody);
+        }
+        const auto group_time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+        JobSystem job_system;
+        IntegrationSystem integration_system(job_system);
+        start = std::chrono::high_resolution_clock::now();
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            integration_system.update(group_registry, DT);
+        }
+        const auto system_time = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+        std::cout << "View Time: " << view_time << "s for " << FRAMES << " frames" << std::endl;
+        std::cout << "Group Time: " << group_time << "s for " << FRAMES << " frames ("
+                  << view_time / group_time << "x)" << std::endl;
+        std::cout << "IntegrationSystem (group) Time: " << system_time << "s for " << FRAMES << " frames" << std::endl;
+    }
+}
+
+int runPhysicsTests() {
+    const int failures = StrikeEngine::Test::checkFailures();
+    test_group_alignment();
+    test_parallel_each();
+    test_soa_storage();
+    test_deferred_commands();
+    test_reserved_entities();
+    test_gravity_kernel();
+    benchmark_view_vs_group();
+    benchmark_gravity();
+
+    std::cout << "\nPhysics tests completed successfully." << std::endl;
+    return StrikeEngine::Test::checkFailures() - failures;
+}
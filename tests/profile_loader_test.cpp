@@ -0,0 +1,166 @@
+#include "strikeengine/flight/ProfileRegistry.hpp"
+#include "strikeengine/flight/AerodynamicsDatabase.hpp"
+#include "strikeengine/flight/RCSDatabase.hpp"
+#include "strikeengine/ecs/Registry.hpp"
+#include "strikeengine/simulation/EntityFactory.hpp"
+#include "strikeengine/components/physics/AerodynamicProfileComponent.hpp"
+#include "strikeengine/components/metadata/RCSProfileComponent.hpp"
+#include "TestCheck.hpp"
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+    using namespace StrikeEngine;
+
+    // An RCS table (elevation rows, azimuth columns) of 10 dBsm everywhere, so every aspect reads 10 m^2.
+    void writeRcsProfile(const std::string& path) {
+        std::ofstream f(path);
+        f << R"({"name": "Test", "azimuth_breakpoints_deg": [-180, 0, 180], "elevation_breakpoints_deg": [-90, 90],)"
+          << R"( "rcs_table_dbsm": [[10, 10, 10], [10, 10, 10]]})";
+    }
+
+    void test_profile_ids() {
+        std::cout << "--- Running Profile ID Tests ---" << std::endl;
+        ProfileRegistry profiles;
+        const ProfileId a = profiles.intern("alpha");
+        const ProfileId b = profiles.intern("bravo");
+        CHECK(a != b);
+        CHECK(profiles.intern(std::string("alpha")) == a);
+        CHECK(profiles.name(a) == "alpha" && profiles.name(b) == "bravo");
+
+        // Names keep their IDs, and stay put, however many follow them.
+        const std::string& first = profiles.name(a);
+        for (int i = 0; i < 1000; ++i) {
+            (void)profiles.intern("profile_" + std::to_string(i));
+        }
+        CHECK(profiles.intern("alpha") == a && &profiles.name(a) == &first);
+
+        bool threw = false;
+        try {
+            (void)profiles.name(static_cast<ProfileId>(5000));
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        CHECK(threw);
+        std::cout << "Profile IDs: OK" << std::endl;
+    }
+
+    void test_shared_databases() {
+        std::cout << "--- Running Shared Profile Database Tests ---" << std::endl;
+        const std::string rcs_path = "profile_registry_test_rcs.json";
+        const std::string bad_rcs_path = "profile_registry_test_bad_rcs.json";
+        writeRcsProfile(rcs_path);
+        std::ofstream(bad_rcs_path) << R"({"name": "No tables"})";
+
+        ProfileRegistry profiles;
+
+        // Threads racing to resolve the same profiles all get the one loaded copy.
+        constexpr int thread_count = 8;
+        std::vector<const AerodynamicsDatabase*> aero(thread_count);
+        std::vector<const RCSDatabase*> rcs(thread_count);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thread_count; ++t) {
+            threads.emplace_back([&, t] {
+                for (int i = 0; i < 100; ++i) {
+                    aero[t] = profiles.aerodynamics("sa_missile_mk1_aero");
+                    rcs[t] = profiles.rcs(rcs_path);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        CHECK(aero[0] && rcs[0]);
+        for (int t = 1; t < thread_count; ++t) {
+            CHECK(aero[t] == aero[0] && rcs[t] == rcs[0]);
+        }
+        CHECK(profiles.aerodynamics(profiles.intern("sa_missile_mk1_aero")) == aero[0]);
+        CHECK(std::abs(rcs[0]->getRCS(0.5, 0.1) - 10.0) < 1e-9);
+
+        // Profiles that cannot be loaded resolve to null, every time, without throwing.
+        CHECK(profiles.aerodynamics("no_such_aero_profile") == nullptr);
+        CHECK(profiles.aerodynamics("no_such_aero_profile") == nullptr);
+        CHECK(profiles.rcs(bad_rcs_path) == nullptr);
+        CHECK(profiles.infrared("data/ir/no_such_signature.json") == nullptr);
+
+        std::remove(rcs_path.c_str());
+        std::remove(bad_rcs_path.c_str());
+        std::cout << "Shared profile databases: OK" << std::endl;
+    }
+
+    // Entities spawned by the factories of separate engines hold the same process-wide databases.
+    void test_spawn_handles() {
+        std::cout << "--- Running Spawn Handle Tests ---" << std::endl;
+        const std::string rcs_path = "profile_registry_spawn_rcs.json";
+        const std::string profile_path = "profile_registry_spawn_profile.json";
+        writeRcsProfile(rcs_path);
+        std::ofstream(profile_path)
+            << R"({"name": "Registry Test", "simulation": {"components_to_add": ["aerodynamics", "rcs_profile"]},)"
+            << R"( "aerodynamics": {"profile_id": "sa_missile_mk1_aero", "reference_area_m2": 0.04},)"
+            << R"( "rcs_profile": {"profile_path": ")" << rcs_path << R"("}})";
+
+        Registry first_registry;
+        Registry second_registry;
+        EntityFactory first_factory(first_registry);
+        EntityFactory second_factory(second_registry);
+        const Entity first = first_factory.createFromProfile(profile_path);
+        const Entity second = second_factory.createFromProfile(profile_path);
+
+        const auto& first_aero = first_registry.get<AerodynamicProfileComponent>(first);
+        const auto& second_aero = second_registry.get<AerodynamicProfileComponent>(second);
+        CHECK(first_aero.database != nullptr);
+        CHECK(first_aero.database == second_aero.database);
+        CHECK(first_aero.database == ProfileRegistry::instance().aerodynamics(first_aero.profileID));
+
+        const auto& first_rcs = first_registry.get<RCSProfileComponent>(first);
+        CHECK(first_rcs.database != nullptr);
+        CHECK(first_rcs.database == second_registry.get<RCSProfileComponent>(second).database);
+        CHECK(first_aero.resolved && first_rcs.resolved);
+
+        // A profile that cannot be loaded is still marked resolved, so systems skip it for good.
+        std::ofstream(profile_path)
+            << R"({"name": "Registry Test", "simulation": {"components_to_add": ["rcs_profile"]},)"
+            << R"( "rcs_profile": {"profile_path": "data/rcs/no_such_profile.json"}})";
+        const Entity missing = first_factory.createFromProfile(profile_path);
+        const auto& missing_rcs = first_registry.get<RCSProfileComponent>(missing);
+        CHECK(missing_rcs.resolved && missing_rcs.database == nullptr);
+
+        // Components added by hand are resolved as they are added, directly or through a command buffer.
+        writeRcsProfile(rcs_path);
+        Registry registry;
+        const Entity loaded = registry.create();
+        registry.add<RCSProfileComponent>(loaded, rcs_path);
+        const Entity unloadable = registry.create();
+        registry.add<RCSProfileComponent>(unloadable, "data/rcs/no_such_profile.json");
+        CHECK(registry.get<RCSProfileComponent>(loaded).resolved);
+        CHECK(registry.get<RCSProfileComponent>(loaded).database == ProfileRegistry::instance().rcs(rcs_path));
+        CHECK(registry.get<RCSProfileComponent>(unloadable).resolved);
+        CHECK(registry.get<RCSProfileComponent>(unloadable).database == nullptr);
+
+        const Entity deferred = registry.commands().create();
+        registry.commands().add<RCSProfileComponent>(deferred, rcs_path);
+        registry.flushCommands();
+        CHECK(registry.get<RCSProfileComponent>(deferred).resolved);
+        CHECK(registry.get<RCSProfileComponent>(deferred).database == ProfileRegistry::instance().rcs(rcs_path));
+
+        std::remove(rcs_path.c_str());
+        std::remove(profile_path.c_str());
+        std::cout << "Spawn handles: OK" << std::endl;
+    }
+}
+
+int runProfileLoaderTests() {
+    const int failures = StrikeEngine::Test::checkFailures();
+    test_profile_ids();
+    test_shared_databases();
+    test_spawn_handles();
+
+    std::cout << "\nProfile loader tests completed successfully." << std::endl;
+    return StrikeEngine::Test::checkFailures() - failures;
+}
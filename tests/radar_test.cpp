@@ -0,0 +1,206 @@
+#include "strikeengine/flight/RCSDatabase.hpp"
+#include "TestCheck.hpp"
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    using namespace StrikeEngine;
+
+    constexpr double DEG = std::numbers::pi / 180.0;
+
+    // Linear in both angles, so bilinear interpolation in dBsm must reproduce it exactly.
+    double linearDbsm(double azimuth_deg, double elevation_deg) {
+        return 5.0 + 0.1 * azimuth_deg - 0.2 * elevation_deg;
+    }
+
+    double linearRcs(double azimuth_deg, double elevation_deg) {
+        return std::pow(10.0, linearDbsm(azimuth_deg, elevation_deg) / 10.0);
+    }
+
+    // Writes an RCS profile of linearDbsm on the given breakpoints.
+    void writeProfile(const std::string& path, const std::vector<double>& azimuth_deg,
+                      const std::vector<double>& elevation_deg) {
+        std::ofstream f(path);
+        auto list = [&](const std::vector<double>& values) {
+            f << "[";
+            for (size_t i = 0; i < values.size(); ++i) {
+                f << (i ? ", " : "") << values[i];
+            }
+            f << "]";
+        };
+        f << R"({"name": "Test", "azimuth_breakpoints_deg": )";
+        list(azimuth_deg);
+        f << R"(, "elevation_breakpoints_deg": )";
+        list(elevation_deg);
+        f << R"(, "rcs_table_dbsm": [)";
+        for (size_t i = 0; i < elevation_deg.size(); ++i) {
+            std::vector<double> row;
+            for (double azimuth : azimuth_deg) {
+                row.push_back(linearDbsm(azimuth, elevation_deg[i]));
+            }
+            f << (i ? ", " : "");
+            list(row);
+        }
+        f << "]}";
+    }
+
+    bool near(double value, double expected, double relative) {
+        return std::abs(value - expected) <= relative * std::abs(expected);
+    }
+
+    void test_rcs_lookup() {
+        std::cout << "--- Running RCS Lookup Tests ---" << std::endl;
+        const std::string path = "rcs_lookup_test.json";
+
+        // Uniform breakpoints, and irregular ones that are resampled onto a finer grid.
+        for (const auto& azimuth_deg : {std::vector<double>{-180, -90, 0, 90, 180},
+                                        std::vector<double>{-180, -45, 0, 15, 30, 180}}) {
+            writeProfile(path, azimuth_deg, {-90, -30, 0, 30, 90});
+            RCSDatabase database;
+            const bool loaded = database.loadProfile(path);
+            CHECK(loaded);
+
+            for (double azimuth : {-180.0, -123.4, -45.0, 0.0, 7.5, 90.0, 179.0}) {
+                for (double elevation : {-90.0, -12.5, 0.0, 30.0, 61.0}) {
+                    CHECK(near(database.getRCS(azimuth * DEG, elevation * DEG), linearRcs(azimuth, elevation), 1e-12));
+                }
+            }
+
+            // Aspects outside the table take its edge values; NaN takes the first point.
+            CHECK(near(database.getRCS(200.0 * DEG, 100.0 * DEG), linearRcs(180.0, 90.0), 1e-12));
+            const double nan = std::numeric_limits<double>::quiet_NaN();
+            CHECK(near(database.getRCS(nan, 0.0), linearRcs(-180.0, 0.0), 1e-12));
+        }
+
+        // A table whose shape does not match its breakpoints is rejected.
+        std::ofstream(path) << R"({"azimuth_breakpoints_deg": [0, 90], "elevation_breakpoints_deg": [0, 45],)"
+                            << R"( "rcs_table_dbsm": [[1, 2], [3]]})";
+        RCSDatabase malformed;
+        CHECK(!malformed.loadProfile(path));
+        CHECK(malformed.getRCS(0.0, 0.0) == 1.0);
+
+        // Profiles that fail to load, including ones that only fail while resampling, leave the
+        // loaded table in place, axes and values alike.
+        writeProfile(path, {-180, 0, 180}, {-90, 0, 90});
+        RCSDatabase reloaded;
+        const bool first_loaded = reloaded.loadProfile(path);
+        CHECK(first_loaded);
+        for (const char* profile : {R"({"azimuth_breakpoints_deg": [0, 90], "elevation_breakpoints_deg": [], "rcs_table_dbsm": []})",
+                                    R"({"azimuth_breakpoints_deg": [0, 90, 45], "elevation_breakpoints_deg": [0, 45],)"
+                                    R"( "rcs_table_dbsm": [[1, 2, 3], [4, 5, 6]]})",
+                                    R"({"azimuth_breakpoints_deg": [-180, 180], "elevation_breakpoints_deg": [90, -90],)"
+                                    R"( "rcs_table_dbsm": [[1, 2], [3, 4]]})",
+                                    R"({"name": "No tables"})"}) {
+            std::ofstream(path) << profile;
+            CHECK(!reloaded.loadProfile(path));
+            for (double azimuth : {-170.0, 0.0, 95.0}) {
+                CHECK(near(reloaded.getRCS(azimuth * DEG, 45.0 * DEG), linearRcs(azimuth, 45.0), 1e-12));
+            }
+            const double az[] = {-170.0 * DEG, -20.0 * DEG, 0.0, 95.0 * DEG};
+            const double el[] = {45.0 * DEG, -80.0 * DEG, 0.0, 10.0 * DEG};
+            double out[4];
+            reloaded.getRCSBatch(az, el, out);
+            for (size_t i = 0; i < 4; ++i) {
+                CHECK(near(out[i], reloaded.getRCS(az[i], el[i]), 1e-14));
+            }
+        }
+
+        std::remove(path.c_str());
+        std::cout << "RCS lookup: OK" << std::endl;
+    }
+
+    // The batched lookups agree with the scalar ones, including for lengths that are not a
+    // multiple of the SIMD width and aspects outside the table.
+    void test_rcs_batch() {
+        std::cout << "--- Running RCS Batch Tests ---" << std::endl;
+        const std::string path = "rcs_batch_test.json";
+        std::vector<double> azimuth_deg;
+        for (double a = -180.0; a <= 180.0; a += 5.0) {
+            azimuth_deg.push_back(a);
+        }
+        writeProfile(path, azimuth_deg, {-90, -60, -30, -10, 0, 10, 30, 60, 90});
+        RCSDatabase database;
+        const bool loaded = database.loadProfile(path);
+        CHECK(loaded);
+        std::remove(path.c_str());
+
+        std::mt19937 rng(25);
+        std::uniform_real_distribution<double> azimuth(-3.5, 3.5), elevation(-1.8, 1.8);
+        for (size_t count : {0u, 1u, 3u, 4u, 7u, 1000u}) {
+            std::vector<double> az(count), el(count), out(count);
+            for (size_t i = 0; i < count; ++i) {
+                az[i] = azimuth(rng);
+                el[i] = elevation(rng);
+            }
+            database.getRCSBatch(az, el, out);
+            for (size_t i = 0; i < count; ++i) {
+                CHECK(near(out[i], database.getRCS(az[i], el[i]), 1e-14));
+            }
+        }
+        std::cout << "RCS batch: OK" << std::endl;
+    }
+
+    // Single and batched lookup throughput, as a radar loop over a dense raid would see it.
+    void benchmark_rcs_lookup() {
+        std::cout << "--- Running RCS Lookup Benchmark ---" << std::endl;
+        const std::string path = "rcs_benchmark.json";
+        std::vector<double> azimuth_deg, elevation_deg;
+        for (double a = -180.0; a <= 180.0; a += 2.0) {
+            azimuth_deg.push_back(a);
+        }
+        for (double e = -90.0; e <= 90.0; e += 5.0) {
+            elevation_deg.push_back(e);
+        }
+        writeProfile(path, azimuth_deg, elevation_deg);
+        RCSDatabase database;
+        const bool loaded = database.loadProfile(path);
+        CHECK(loaded);
+        std::remove(path.c_str());
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> azimuth(-std::numbers::pi, std::numbers::pi),
+            elevation(-std::numbers::pi / 2.0, std::numbers::pi / 2.0);
+        std::vector<double> az(100000), el(100000), out(100000);
+        for (size_t i = 0; i < az.size(); ++i) {
+            az[i] = azimuth(rng);
+            el[i] = elevation(rng);
+        }
+
+        constexpr int rounds = 20;
+        double sum = 0.0;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            for (size_t i = 0; i < az.size(); ++i) {
+                sum += database.getRCS(az[i], el[i]);
+            }
+        }
+        const double single = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+
+        start = std::chrono::high_resolution_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            database.getRCSBatch(az, el, out);
+            sum += out[round];
+        }
+        const double batched = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        std::cout << "RCS single: " << single << "s, batched: " << batched << "s for " << rounds * az.size()
+                  << " lookups (checksum " << sum << ")" << std::endl;
+    }
+}
+
+int runRadarTests() {
+    const int failures = StrikeEngine::Test::checkFailures();
+    test_rcs_lookup();
+    test_rcs_batch();
+    benchmark_rcs_lookup();
+
+    std::cout << "\nRadar tests completed successfully." << std::endl;
+    return StrikeEngine::Test::checkFailures() - failures;
+}
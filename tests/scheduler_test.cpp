@@ -0,0 +1,316 @@
+#include "strikeengine/core/JobSystem.hpp"
+#include "strikeengine/core/TaskGraph.hpp"
+#include "strikeengine/core/SystemGraph.hpp"
+#include "strikeengine/ecs/Registry.hpp"
+#include "TestCheck.hpp"
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <stdexcept>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    using namespace StrikeEngine;
+
+    // Every task must run exactly once per frame and only after all of its prerequisites.
+    void test_task_graph_ordering() {
+        JobSystem job_system(4);
+        TaskGraph graph;
+
+        // Diamond with a tail: a -> {b, c} -> d -> e, plus an independent task f.
+        std::vector<std::atomic<int>> finished(6);
+        std::atomic<bool> order_ok = true;
+        auto task = [&](size_t self, std::vector<size_t> prerequisites) {
+            return [&, self, prerequisites]() {
+                for (size_t prerequisite : prerequisites) {
+                    if (finished[prerequisite].load() <= finished[self].load()) {
+                        order_ok = false;
+                    }
+                }
+                finished[self].fetch_add(1);
+            };
+        };
+        const size_t a = graph.addTask(task(0, {}));
+        const size_t b = graph.addTask(task(1, {0}));
+        const size_t c = graph.addTask(task(2, {0}));
+        const size_t d = graph.addTask(task(3, {1, 2}));
+        const size_t e = graph.addTask(task(4, {3}));
+        graph.addTask(task(5, {}));
+        graph.addDependency(b, a);
+        graph.addDependency(c, a);
+        graph.addDependency(d, b);
+        graph.addDependency(d, c);
+        graph.addDependency(e, d);
+
+        constexpr int FRAMES = 1000;
+        for (int frame = 0; frame < FRAMES; ++frame) {
+            graph.run(job_system);
+            for (const auto& count : finished) {
+                CHECK(count.load() == frame + 1);
+            }
+        }
+        CHECK(order_ok);
+        std::cout << "Task graph ordering: OK (" << FRAMES << " frames)" << std::endl;
+    }
+
+    // A task must not wait for an unrelated slow task just because they sit at the same depth.
+    void test_task_graph_no_stage_barrier() {
+        JobSystem job_system(2);
+        TaskGraph graph;
+
+        std::atomic<bool> slow_done = false;
+        std::atomic<bool> follower_ran_early = false;
+        const size_t fast = graph.addTask([] {});
+        graph.addTask([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            slow_done = true;
+        });
+        const size_t follower = graph.addTask([&] { follower_ran_early = !slow_done.load(); });
+        graph.addDependency(follower, fast);
+
+        graph.run(job_system);
+        CHECK(slow_done);
+        CHECK(follower_ran_early);
+        std::cout << "Task graph without stage barriers: OK" << std::endl;
+    }
+
+    void test_task_graph_cycle() {
+        JobSystem job_system(1);
+        TaskGraph graph;
+        const size_t a = graph.addTask([] {});
+        const size_t b = graph.addTask([] {});
+        const size_t c = graph.addTask([] {});
+        graph.addDependency(b, a);
+        graph.addDependency(c, b);
+        graph.addDependency(b, c);
+
+        bool threw = false;
+        try {
+            graph.run(job_system);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        CHECK(threw);
+        std::cout << "Task graph cycle detection: OK" << std::endl;
+    }
+
+    struct PositionComponent { double x = 0.0; };
+    struct ForceComponent { double f = 0.0; };
+
+    class ForceSystem final : public System {
+    public:
+        using Reads = ComponentList<PositionComponent>;
+        using Writes = ComponentList<ForceComponent>;
+        void update(Registry&, double) override {}
+    };
+
+    class SecondForceSystem final : public System {
+    public:
+        using Writes = ComponentList<ForceComponent>;
+        void update(Registry&, double) override {}
+    };
+
+    class ReaderSystem final : public System {
+    public:
+        using Reads = ComponentList<PositionComponent>;
+        void update(Registry& registry, double) override {
+            registry.view<const PositionComponent>().each([](const PositionComponent&) {});
+        }
+    };
+
+    class MoveSystem final : public System {
+    public:
+        using Reads = ComponentList<ForceComponent>;
+        using Writes = ComponentList<PositionComponent>;
+        void update(Registry&, double) override {}
+    };
+
+    // Edges come from declared access: writers are ordered against anything touching the same
+    // component, readers of the same component stay parallel.
+    void test_system_graph_from_access() {
+        SystemGraph graph;
+        System* force = graph.addSystem(std::make_unique<ForceSystem>());
+        System* reader = graph.addSystem(std::make_unique<ReaderSystem>());
+        System* second_force = graph.addSystem(std::make_unique<SecondForceSystem>());
+        System* move = graph.addSystem(std::make_unique<MoveSystem>());
+
+        const auto stages = graph.getExecutionOrder();
+        CHECK(stages.size() == 3);
+        CHECK(stages[0].size() == 2);
+        CHECK(std::ranges::find(stages[0], force) != stages[0].end());
+        CHECK(std::ranges::find(stages[0], reader) != stages[0].end());
+        CHECK(stages[1] == std::vector<System*>{second_force});
+        CHECK(stages[2] == std::vector<System*>{move});
+
+#ifdef STRIKEENGINE_CHECK_SYSTEM_ACCESS
+        // An undeclared write is caught while the system runs.
+        Registry registry;
+        const Entity entity = registry.create();
+        registry.add<PositionComponent>(entity);
+        const SystemAccess access = SystemAccess::of<ReaderSystem>();
+        SystemAccess::Scope scope(access);
+        registry.view<const PositionComponent>();
+        bool threw = false;
+        try {
+            registry.view<PositionComponent>();
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        CHECK(threw);
+
+        // So are lookups: a non-const get is a write, has is a read.
+        CHECK(registry.has<PositionComponent>(entity));
+        CHECK(registry.get<const PositionComponent>(entity).x == 0.0);
+        auto throws = [](auto&& lookup) {
+            try {
+                lookup();
+            } catch (const std::runtime_error&) {
+                return true;
+            }
+            return false;
+        };
+        CHECK(throws([&] { registry.get<PositionComponent>(entity); }));
+        CHECK(throws([&] { (void)registry.has<ForceComponent>(entity); }));
+#endif
+        std::cout << "System graph from declared access: OK" << std::endl;
+    }
+
+#ifdef STRIKEENGINE_CHECK_SYSTEM_ACCESS
+    // A system waiting on its jobs helps with whatever is queued, which may be a chunk of another
+    // system running at the same time. That chunk is checked against the system that submitted it.
+    void test_stolen_job_access() {
+        Registry registry;
+        const Entity entity = registry.create();
+        registry.add<ForceComponent>(entity);
+
+        // Submits a chunk that writes ForceComponent under `owner` and has the waiting thread, running
+        // under `waiter`, pick it up. Returns whether the chunk's write was rejected.
+        auto stolen_write_throws = [&](const SystemAccess& owner, const SystemAccess& waiter) {
+            // Keep the only worker busy until the foreign chunk has run, so the waiting thread runs it.
+            JobSystem job_system(1);
+            std::atomic<bool> started = false;
+            std::atomic<bool> released = false;
+            job_system.submit([&] {
+                started = true;
+                while (!released) {
+                    std::this_thread::yield();
+                }
+            });
+            while (!started) {
+                std::this_thread::yield();
+            }
+
+            bool threw = false;
+            std::thread::id ran_on;
+            {
+                SystemAccess::Scope scope(owner);
+                job_system.submit([&] {
+                    ran_on = std::this_thread::get_id();
+                    try {
+                        registry.get<ForceComponent>(entity).f += 1.0;
+                    } catch (const std::runtime_error&) {
+                        threw = true;
+                    }
+                    released = true;
+                });
+            }
+
+            {
+                SystemAccess::Scope scope(waiter);
+                job_system.wait();
+                // The waiter's scope is back once the job has run.
+                bool own_access_checked = false;
+                try {
+                    registry.get<ForceComponent>(entity);
+                } catch (const std::runtime_error&) {
+                    own_access_checked = true;
+                }
+                CHECK(own_access_checked == !waiter.canWrite(ComponentFamily::id<ForceComponent>()));
+            }
+            CHECK(ran_on == std::this_thread::get_id());
+            return threw;
+        };
+
+        const SystemAccess force_access = SystemAccess::of<ForceSystem>();
+        const SystemAccess reader_access = SystemAccess::of<ReaderSystem>();
+        // ForceSystem's chunk passes even though the waiting ReaderSystem may not write forces...
+        CHECK(!stolen_write_throws(force_access, reader_access));
+        // ...and a chunk whose system did not declare ForceComponent fails even under ForceSystem.
+        CHECK(stolen_write_throws(reader_access, force_access));
+        std::cout << "Stolen job access: OK" << std::endl;
+    }
+#endif
+
+    class CountingSystem final : public System {
+    public:
+        void update(Registry&, double dt) override {
+            ++runs;
+            total_dt += dt;
+        }
+
+        int runs = 0;
+        double total_dt = 0.0;
+    };
+
+    // A system with a period runs only when due and receives the full elapsed time as its dt.
+    void test_system_periods() {
+        JobSystem job_system(2);
+        SystemGraph graph;
+        CountingSystem* every_tick = graph.addSystem(std::make_unique<CountingSystem>());
+        CountingSystem* fifty_hz = graph.addSystem(std::make_unique<CountingSystem>());
+        graph.setPeriod(fifty_hz, 1.0 / 50.0);
+
+        Registry registry;
+        double tick_dt = 0.001;
+        TaskGraph task_graph = graph.buildTaskGraph(tick_dt, [&](System* system, double dt) {
+            system->update(registry, dt);
+        });
+        for (int tick = 0; tick < 1000; ++tick) {
+            task_graph.run(job_system);
+        }
+
+        CHECK(every_tick->runs == 1000);
+        CHECK(fifty_hz->runs == 50);
+        CHECK(std::abs(every_tick->total_dt - 1.0) < 1e-9);
+        CHECK(std::abs(fifty_hz->total_dt - 1.0) < 1e-9);
+        std::cout << "System periods: OK" << std::endl;
+    }
+
+    void test_job_system_submit() {
+        JobSystem job_system(4);
+        std::atomic<size_t> sum = 0;
+        job_system.submitN(1000, [&](size_t index) { sum += index; });
+        job_system.wait();
+        CHECK(sum == 999 * 1000 / 2);
+
+        // Nested parallelFor calls from inside jobs must finish without deadlocking.
+        std::atomic<size_t> items = 0;
+        for (int i = 0; i < 8; ++i) {
+            job_system.submit([&] {
+                job_system.parallelFor(10000, 37, [&](size_t begin, size_t end) { items += end - begin; });
+            });
+        }
+        job_system.wait();
+        CHECK(items == 80000);
+        std::cout << "JobSystem submit/submitN/parallelFor: OK" << std::endl;
+    }
+}
+
+int runSchedulerTests() {
+    const int failures = StrikeEngine::Test::checkFailures();
+    test_job_system_submit();
+    test_task_graph_ordering();
+    test_task_graph_no_stage_barrier();
+    test_task_graph_cycle();
+    test_system_graph_from_access();
+#ifdef STRIKEENGINE_CHECK_SYSTEM_ACCESS
+    test_stolen_job_access();
+#endif
+    test_system_periods();
+
+    std::cout << "\nScheduler tests completed successfully." << std::endl;
+    return StrikeEngine::Test::checkFailures() - failures;
+}
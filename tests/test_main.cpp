@@ -0,0 +1,28 @@
+#include <iostream>
+
+int runAerodynamicsTests();
+int runAtmosphereTests();
+int runIntegratorTests();
+int runPhysicsTests();
+int runProfileLoaderTests();
+int runRadarTests();
+int runSchedulerTests();
+int runWeatherTests();
+
+int main() {
+    int failures = 0;
+    failures += runAtmosphereTests();
+    failures += runAerodynamicsTests();
+    failures += runProfileLoaderTests();
+    failures += runRadarTests();
+    failures += runPhysicsTests();
+    failures += runIntegratorTests();
+    failures += runSchedulerTests();
+    failures += runWeatherTests();
+
+    if (failures != 0) {
+        std::cerr << "\n" << failures << " check(s) failed." << std::endl;
+        return 1;
+    }
+    return 0;
+}
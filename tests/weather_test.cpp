@@ -0,0 +1,277 @@
+#include "strikeengine/atmosphere/WeatherField.hpp"
+#include "strikeengine/atmosphere/AtmosphereManager.hpp"
+#include "strikeengine/core/JobSystem.hpp"
+#include "strikeengine/ecs/Registry.hpp"
+#include "strikeengine/components/transform/TransformComponent.hpp"
+#include "strikeengine/components/physics/VelocityComponent.hpp"
+#include "strikeengine/components/physics/MassComponent.hpp"
+#include "strikeengine/components/physics/ForceAccumulatorComponent.hpp"
+#include "strikeengine/components/physics/AerodynamicProfileComponent.hpp"
+#include "strikeengine/systems/physics/AerodynamicsSystem.hpp"
+#include "strikeengine/systems/physics/RigidBodyGroup.hpp"
+#include "TestCheck.hpp"
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    using namespace StrikeEngine;
+
+    constexpr double EARTH_RADIUS_M = 6378137.0;
+
+    // A small regional grid, cut into several tiles along every axis.
+    WeatherGrid testGrid() {
+        WeatherGrid grid{};
+        grid.axes[WeatherGrid::LATITUDE] = {-10.0, 2.0, 11, 4};
+        grid.axes[WeatherGrid::LONGITUDE] = {0.0, 2.0, 11, 5};
+        grid.axes[WeatherGrid::ALTITUDE] = {0.0, 1000.0, 11, 3};
+        grid.axes[WeatherGrid::TIME] = {0.0, 50.0, 3, 2};
+        grid.earth_radius_m = EARTH_RADIUS_M;
+        return grid;
+    }
+
+    // Linear in every coordinate, so the interpolation must reproduce it exactly inside the grid.
+    WeatherPoint linearWeather(double latitude, double longitude, double altitude, double time) {
+        return {static_cast<float>(5.0 + 0.5 * latitude + 0.25 * longitude + 0.001 * altitude + 0.02 * time),
+                static_cast<float>(-3.0 + 0.1 * latitude - 0.3 * longitude + 0.0005 * altitude),
+                static_cast<float>(0.2 - 0.01 * time),
+                static_cast<float>(288.0 - 0.0065 * altitude + 0.1 * latitude),
+                static_cast<float>(1.2 - 0.0001 * altitude + 0.001 * longitude)};
+    }
+
+    glm::dvec3 positionAt(double latitude_deg, double longitude_deg, double altitude_m) {
+        const double lat = latitude_deg * std::numbers::pi / 180.0;
+        const double lon = longitude_deg * std::numbers::pi / 180.0;
+        const double r = EARTH_RADIUS_M + altitude_m;
+        return {r * std::cos(lat) * std::cos(lon), r * std::sin(lat), -r * std::cos(lat) * std::sin(lon)};
+    }
+
+    // The wind of linearWeather in the simulation frame: east, north and up at the position.
+    glm::dvec3 worldWind(double latitude_deg, double longitude_deg, const WeatherPoint& point) {
+        const double lat = latitude_deg * std::numbers::pi / 180.0;
+        const double lon = longitude_deg * std::numbers::pi / 180.0;
+        const glm::dvec3 east(-std::sin(lon), 0.0, -std::cos(lon));
+        const glm::dvec3 north(-std::sin(lat) * std::cos(lon), std::cos(lat), std::sin(lat) * std::sin(lon));
+        const glm::dvec3 up(std::cos(lat) * std::cos(lon), std::sin(lat), -std::cos(lat) * std::sin(lon));
+        return point.wind_east_mps * east + point.wind_north_mps * north + point.wind_up_mps * up;
+    }
+
+    bool rejects(const std::string& path) {
+        WeatherField field;
+        try {
+            field.open(path);
+        } catch (const std::runtime_error&) {
+            return !field.isLoaded();
+        }
+        return false;
+    }
+
+    // Interpolation reproduces a linear field at arbitrary points, single and batched, and
+    // clamps to the grid's edge outside it. Corrupt files are rejected.
+    void test_weather_interpolation() {
+        const std::string path = "weather_field_test.bin";
+        writeWeatherField(path, testGrid(), linearWeather);
+
+        WeatherField field;
+        const bool opened = field.open(path);
+        CHECK(opened);
+        CHECK(field.tileCount() == 4 * 3 * 5 * 2);
+
+        std::mt19937 rng(20);
+        std::uniform_real_distribution<double> latitude(-10.0, 10.0), longitude(0.0, 20.0), altitude(0.0, 10000.0);
+        std::vector<glm::dvec3> positions;
+        std::vector<WeatherPoint> expected;
+        std::vector<std::pair<double, double>> coordinates;
+        const double time = 63.0;
+        for (int i = 0; i < 2000; ++i) {
+            const double lat = latitude(rng), lon = longitude(rng), alt = altitude(rng);
+            positions.push_back(positionAt(lat, lon, alt));
+            expected.push_back(linearWeather(lat, lon, alt, time));
+            coordinates.emplace_back(lat, lon);
+        }
+        std::vector<WeatherSample> batch(positions.size());
+        field.sample(positions, time, batch);
+        for (size_t i = 0; i < positions.size(); ++i) {
+            const WeatherSample single = field.sample(positions[i], time);
+            const glm::dvec3 wind = worldWind(coordinates[i].first, coordinates[i].second, expected[i]);
+            CHECK(glm::length(single.wind_mps - wind) < 1e-4);
+            CHECK(std::abs(single.temperature_K - expected[i].temperature_K) < 1e-3);
+            CHECK(std::abs(single.density_kgpm3 - expected[i].density_kgpm3) < 1e-5);
+            CHECK(glm::length(batch[i].wind_mps - single.wind_mps) == 0.0);
+            CHECK(batch[i].temperature_K == single.temperature_K);
+        }
+
+        // Outside the grid: the nearest edge, in space and in time.
+        const WeatherSample below = field.sample(positionAt(4.0, 6.0, -500.0), -10.0);
+        const WeatherPoint edge = linearWeather(4.0, 6.0, 0.0, 0.0);
+        CHECK(std::abs(below.temperature_K - edge.temperature_K) < 1e-3);
+        const WeatherSample west = field.sample(positionAt(4.0, -3.0, 2000.0), 500.0);
+        const WeatherPoint west_edge = linearWeather(4.0, 0.0, 2000.0, 100.0);
+        CHECK(std::abs(west.density_kgpm3 - west_edge.density_kgpm3) < 1e-5);
+        CHECK(std::abs(glm::length(west.wind_mps) - glm::length(worldWind(4.0, 0.0, west_edge))) < 1e-3);
+
+        // A corrupt magic or a truncated file is refused; a missing one just does not load.
+        std::vector<char> bytes;
+        {
+            std::ifstream in(path, std::ios::binary);
+            bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        auto rewrite = [&](const std::vector<char>& content) {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(content.data(), static_cast<std::streamsize>(content.size()));
+        };
+        std::vector<char> corrupt = bytes;
+        corrupt[0] ^= 0x20;
+        rewrite(corrupt);
+        CHECK(rejects(path));
+        rewrite({bytes.begin(), bytes.end() - static_cast<std::ptrdiff_t>(WEATHER_TILE_ALIGNMENT)});
+        CHECK(rejects(path));
+        std::remove(path.c_str());
+        WeatherField missing;
+        const bool missing_opened = missing.open("weather_field_missing.bin");
+        CHECK(!missing_opened && !missing.isLoaded());
+        std::cout << "Weather interpolation: OK" << std::endl;
+    }
+
+    // prefetch() keeps no more tiles than its budget, beyond the tiles the current call needs.
+    void test_weather_residency() {
+        const std::string path = "weather_field_residency.bin";
+        writeWeatherField(path, testGrid(), linearWeather);
+        WeatherField field;
+        const bool opened = field.open(path, 6);
+        CHECK(opened);
+
+        // One entity sweeping east along the equator at 3 km crosses every longitude tile.
+        for (int step = 0; step <= 40; ++step) {
+            const glm::dvec3 position = positionAt(0.0, 0.5 * step, 3000.0);
+            field.prefetch(std::span(&position, 1), 10.0);
+            CHECK(field.residentTiles() <= 6);
+        }
+
+        // A swarm spread over more tiles than the budget keeps all of its own tiles.
+        std::vector<glm::dvec3> swarm;
+        for (int lat = -9; lat <= 9; lat += 6) {
+            for (int lon = 1; lon <= 19; lon += 8) {
+                swarm.push_back(positionAt(lat, lon, 500.0));
+            }
+        }
+        field.prefetch(swarm, 10.0);
+        CHECK(field.residentTiles() == 4 * 3);
+        const glm::dvec3 single = positionAt(0.0, 1.0, 9000.0);
+        field.prefetch(std::span(&single, 1), 10.0);
+        CHECK(field.residentTiles() == 6);
+        std::remove(path.c_str());
+        std::cout << "Weather residency: OK" << std::endl;
+    }
+
+    // Aerodynamic forces follow the velocity relative to the wind: flying with the wind is
+    // still air, and a wind plus an airspeed matches that airspeed in a calm field.
+    void test_air_relative_aerodynamics() {
+        AtmosphereManager atmosphere;
+        const bool loaded = atmosphere.loadTable("data/atmosphere_table.bin");
+        CHECK(loaded);
+        JobSystem job_system;
+
+        const glm::dvec3 wind_enu(30.0, -12.0, 0.0);
+        auto write = [](const std::string& path, glm::dvec3 wind) {
+            writeWeatherField(path, testGrid(), [wind](double, double, double altitude, double) {
+                return WeatherPoint{static_cast<float>(wind.x), static_cast<float>(wind.y), static_cast<float>(wind.z),
+                                    static_cast<float>(288.15 - 0.0065 * altitude), 1.1f};
+            });
+        };
+        write("weather_field_windy.bin", wind_enu);
+        write("weather_field_calm.bin", glm::dvec3(0.0));
+        WeatherField windy;
+        WeatherField calm;
+        const bool windy_opened = windy.open("weather_field_windy.bin");
+        const bool calm_opened = calm.open("weather_field_calm.bin");
+        CHECK(windy_opened && calm_opened);
+
+        const glm::dvec3 position = positionAt(2.0, 8.0, 4000.0);
+        const glm::dvec3 wind = windy.sample(position, 0.0).wind_mps;
+        const glm::dvec3 airspeed(0.0, 20.0, 280.0); // Nearly along the body's +Z, a few degrees of AoA
+
+        auto run = [&](WeatherField& field, glm::dvec3 velocity, double& mach) {
+            Registry registry;
+            rigidBodyGroup(registry, Get<AerodynamicProfileComponent>{});
+            const Entity body = registry.create();
+            registry.add<TransformComponent>(body, TransformComponent{position});
+            registry.add<VelocityComponent>(body, VelocityComponent{velocity, glm::dvec3(0.0)});
+            registry.add<MassComponent>(body);
+            registry.add<ForceAccumulatorComponent>(body);
+            AerodynamicProfileComponent aero;
+            aero.profileID = "sa_missile_mk1_aero";
+            registry.add<AerodynamicProfileComponent>(body, aero);
+
+            AerodynamicsSystem system(atmosphere, job_system, &field);
+            system.update(registry, 0.01);
+            mach = registry.get<AerodynamicProfileComponent>(body).current_mach_number;
+            return registry.get<ForceAccumulatorComponent>(body).getTotalForce();
+        };
+
+        double mach = 0.0;
+        const glm::dvec3 with_wind = run(windy, wind, mach);
+        CHECK(mach == 0.0 && glm::length(with_wind) == 0.0);
+
+        double windy_mach = 0.0;
+        double calm_mach = 0.0;
+        const glm::dvec3 windy_force = run(windy, wind + airspeed, windy_mach);
+        const glm::dvec3 calm_force = run(calm, airspeed, calm_mach);
+        const double speed_of_sound = std::sqrt(1.4 * 287.05 * (288.15 - 0.0065 * 4000.0));
+        CHECK(std::abs(windy_mach - glm::length(airspeed) / speed_of_sound) < 1e-4);
+        CHECK(std::abs(windy_mach - calm_mach) < 1e-9);
+        CHECK(glm::length(calm_force) > 0.0);
+        CHECK(glm::length(windy_force - calm_force) < 1e-6 * glm::length(calm_force));
+
+        std::remove("weather_field_windy.bin");
+        std::remove("weather_field_calm.bin");
+        std::cout << "Air-relative aerodynamics: OK" << std::endl;
+    }
+
+    // Batched sampling throughput over a scattered swarm.
+    void benchmark_weather_sampling() {
+        std::cout << "--- Running Weather Sampling Benchmark ---" << std::endl;
+        const std::string path = "weather_field_benchmark.bin";
+        writeWeatherField(path, testGrid(), linearWeather);
+        WeatherField field;
+        const bool opened = field.open(path);
+        CHECK(opened);
+
+        std::mt19937 rng(21);
+        std::uniform_real_distribution<double> latitude(-10.0, 10.0), longitude(0.0, 20.0), altitude(0.0, 10000.0);
+        std::vector<glm::dvec3> positions(100000);
+        for (glm::dvec3& p : positions) {
+            p = positionAt(latitude(rng), longitude(rng), altitude(rng));
+        }
+        std::vector<WeatherSample> out(positions.size());
+
+        constexpr int rounds = 20;
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (int round = 0; round < rounds; ++round) {
+            field.prefetch(positions, 5.0 * round);
+            field.sample(positions, 5.0 * round, out);
+        }
+        const double elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        std::remove(path.c_str());
+        std::cout << "Weather sampling: " << elapsed << "s for " << rounds * positions.size() << " samples" << std::endl;
+    }
+}
+
+int runWeatherTests() {
+    const int failures = StrikeEngine::Test::checkFailures();
+    test_weather_interpolation();
+    test_weather_residency();
+    test_air_relative_aerodynamics();
+    benchmark_weather_sampling();
+
+    std::cout << "\nWeather tests completed successfully." << std::endl;
+    return StrikeEngine::Test::checkFailures() - failures;
+}
@@ -0,0 +1,51 @@
+#include "strikeengine/flight/AerodynamicsDatabase.hpp"
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+// Compiles JSON aero profiles into aero table files beside them, which AerodynamicsSystem maps
+// in place of the JSON. With no arguments every profile in data/aero is compiled.
+//
+// Usage: CompileAeroProfile [profile.json ...]
+int main ( int argc , char* argv[] ) {
+	using namespace StrikeEngine;
+	namespace fs = std::filesystem;
+
+	std::vector<fs::path> profiles;
+	for (int i = 1 ; i < argc ; ++i) {
+		profiles.emplace_back( argv[i] );
+	}
+	if (profiles.empty()) {
+		for (const auto &entry : fs::directory_iterator( "data/aero" )) {
+			if (entry.path().extension() == ".json") {
+				profiles.push_back( entry.path() );
+			}
+		}
+	}
+
+	int failures = 0;
+	for (const fs::path &profile : profiles) {
+		const fs::path output = fs::path( profile ).replace_extension( ".aero" );
+		try {
+			AerodynamicsDatabase database;
+			if (!database.loadProfile( profile.string() )) {
+				std::cerr << "Failed to compile " << profile.string() << std::endl;
+				++failures;
+				continue;
+			}
+			writeAeroTable( output.string() , database.table() );
+
+			std::cout << profile.string() << " -> " << output.string() << ": ";
+			for (const auto &axis : database.table().axes()) {
+				std::cout << axis.grid.points << ( &axis == &database.table().axes().back() ? "" : " x " );
+			}
+			std::cout << " points" << ( database.isExact() ? "" : " (resampled approximately)" ) << std::endl;
+		}
+		catch (const std::exception &e) {
+			std::cerr << "An error occurred compiling " << profile.string() << ": " << e.what() << std::endl;
+			++failures;
+		}
+	}
+
+	return failures == 0 ? 0 : 1;
+}
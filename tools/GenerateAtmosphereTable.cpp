@@ -1,5 +1,5 @@
 #include "strikeengine/atmosphere/AtmosphereModel.hpp"
-#include <fstream>
+#include "strikeengine/atmosphere/AtmosphereTable.hpp"
 #include <iostream>
 #include <vector>
 
@@ -14,18 +14,17 @@ int main () {
 		const auto layers = loadAtmosphereLayers( layersFilepath );
 		std::cout << "Layer definitions loaded successfully." << std::endl;
 
-		std::ofstream out( tableFilepath , std::ios::binary );
-		if (!out) {
-			std::cerr << "Error: Failed to open file for writing: " << tableFilepath << std::endl;
-			return 1;
-		}
-
+		// One row per metre. calculateAtmosphere holds its values above 85999 m, so the table
+		// ends there: rows must strictly ascend in altitude.
 		std::cout << "Generating atmosphere lookup table..." << std::endl;
-		for (int i = 0 ; i <= 86000 ; ++i) {
-			AtmosphereProperties props = calculateAtmosphere( i , layers );
-			out.write( reinterpret_cast < const char * >(&props) , sizeof(props) );
+		std::vector<AtmosphereProperties> rows;
+		rows.reserve( 86000 );
+		for (int i = 0 ; i < 86000 ; ++i) {
+			rows.push_back( calculateAtmosphere( i , layers ) );
 		}
 
+		writeAtmosphereTable( tableFilepath , rows );
+
 		std::cout << "Binary table generated successfully at: " << tableFilepath << std::endl;
 	}
 	catch (const std::exception &e) {